@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "analysis/graph/Dominators.h"
+#include "SyntheticCFG.h"
+
+namespace bm = analyzer::benchmark;
+namespace graph = analyzer::analysis::graph;
+
+namespace {
+
+    double millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+int main()
+{
+    std::printf("%10s %10s %12s %12s %12s %14s\n",
+                "nodes", "edges", "dom(ms)", "postdom(ms)", "df entries", "query(ns/op)");
+    for (std::size_t n : {1000UL, 10000UL, 100000UL, 1000000UL}) {
+        std::shared_ptr<graph::DefaultCFG> cfg = bm::buildSyntheticCFG(n, 2023);
+
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<graph::DominatorTree> dom = cfg->getDominatorTree();
+        double domTime = millisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        std::shared_ptr<graph::DominatorTree> postDom = cfg->getPostDominatorTree();
+        double postDomTime = millisecondsSince(start);
+
+        std::size_t frontierSize = 0;
+        for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+            frontierSize += dom->getFrontierIndicesOf(i).size();
+        }
+
+        constexpr std::size_t queryNum = 1000000;
+        std::mt19937 rng(7);
+        std::vector<std::pair<std::size_t, std::size_t>> queries(queryNum);
+        for (auto& [a, b] : queries) {
+            a = rng() % cfg->getNodeNum();
+            b = rng() % cfg->getNodeNum();
+        }
+        std::size_t dominated = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& [a, b] : queries) {
+            dominated += dom->dominates(a, b);
+        }
+        double queryTime = millisecondsSince(start) * 1e6 / static_cast<double>(queryNum);
+
+        std::printf("%10zu %10zu %12.2f %12.2f %12zu %14.2f\n", cfg->getNodeNum(), cfg->getEdgeNum(),
+                    domTime, postDomTime, frontierSize, queryTime);
+        if (dominated == 0) {
+            std::printf("no dominance relation found\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef STATIC_ANALYZER_SYNTHETIC_CFG_H
+#define STATIC_ANALYZER_SYNTHETIC_CFG_H
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "analysis/graph/CFG.h"
+#include "ir/Stmt.h"
+
+namespace analyzer::benchmark {
+
+    namespace graph = analysis::graph;
+
+    /**
+     * @class SyntheticStmt
+     * @brief a statement without source, used as a node of synthetic cfgs
+     */
+    class SyntheticStmt final: public ir::Stmt {
+    public:
+
+        [[nodiscard]] int getStartLine() const override { return -1; }
+
+        [[nodiscard]] int getEndLine() const override { return -1; }
+
+        [[nodiscard]] int getStartColumn() const override { return -1; }
+
+        [[nodiscard]] int getEndColumn() const override { return -1; }
+
+        [[nodiscard]] const language::CPPMethod& getMethod() const override
+        {
+            throw std::runtime_error("synthetic statements do not belong to any method");
+        }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Var>> getDefs() const override { return {}; }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Var>> getUses() const override { return {}; }
+
+        [[nodiscard]] std::string str() const override { return "synthetic"; }
+
+        [[nodiscard]] const clang::Stmt* getClangStmt() const override { return nullptr; }
+
+        [[nodiscard]] std::size_t getIndex() const override { return index; }
+
+        void setIndex(std::size_t index) override { this->index = index; }
+
+    private:
+
+        std::size_t index = 0; ///< the node index of this statement
+
+    };
+
+    /**
+     * @brief build a frozen cfg of roughly n nodes made of sequences, diamonds and loops,
+     * plus a few short backward jumps, in the shape a structured program would produce
+     * @param n the approximate number of nodes
+     * @param seed the random seed
+     * @return a synthetic cfg
+     */
+    inline std::shared_ptr<graph::DefaultCFG> buildSyntheticCFG(std::size_t n, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::shared_ptr<graph::DefaultCFG> cfg = std::make_shared<graph::DefaultCFG>();
+        std::vector<std::shared_ptr<ir::Stmt>> stmts;
+        auto newStmt = [&]() {
+            stmts.emplace_back(std::make_shared<SyntheticStmt>());
+            return stmts.back();
+        };
+        auto addEdge = [&](const std::shared_ptr<ir::Stmt>& source, const std::shared_ptr<ir::Stmt>& target) {
+            cfg->addEdge(std::make_shared<graph::DefaultCFGEdge>(
+                    source, target, graph::CFGEdge::Kind::JUMP_EDGE));
+        };
+        std::shared_ptr<ir::Stmt> entry = std::make_shared<SyntheticStmt>();
+        std::shared_ptr<ir::Stmt> exit = std::make_shared<SyntheticStmt>();
+        cfg->setEntry(entry);
+        cfg->setExit(exit);
+
+        std::shared_ptr<ir::Stmt> current = newStmt();
+        addEdge(entry, current);
+        while (stmts.size() < n) {
+            switch (rng() % 4) {
+                case 0: { // diamond
+                    std::shared_ptr<ir::Stmt> left = newStmt(), right = newStmt(), join = newStmt();
+                    addEdge(current, left);
+                    addEdge(current, right);
+                    addEdge(left, join);
+                    addEdge(right, join);
+                    current = join;
+                    break;
+                }
+                case 1: { // loop
+                    std::shared_ptr<ir::Stmt> header = newStmt(), body = newStmt(), after = newStmt();
+                    addEdge(current, header);
+                    addEdge(header, body);
+                    addEdge(body, header);
+                    addEdge(header, after);
+                    current = after;
+                    break;
+                }
+                default: { // sequence
+                    std::shared_ptr<ir::Stmt> next = newStmt();
+                    addEdge(current, next);
+                    current = next;
+                    break;
+                }
+            }
+            if (rng() % 64 == 0) { // a break, continue or goto to a nearby earlier statement
+                std::size_t distance = 1 + rng() % std::min<std::size_t>(stmts.size(), 32);
+                addEdge(current, stmts[stmts.size() - distance]);
+            }
+        }
+        addEdge(current, exit);
+        cfg->freeze(stmts);
+        return cfg;
+    }
+
+} // benchmark
+
+#endif //STATIC_ANALYZER_SYNTHETIC_CFG_H
@@ -11,6 +11,7 @@
 
 #include "language/CPPMethod.h"
 #include "ir/IR.h"
+#include "analysis/graph/CallGraph.h"
 #include "util/Logger.h"
 
 namespace analyzer {
@@ -41,7 +42,8 @@ namespace analyzer {
     public:
 
         /**
-         * @brief Initialize the word the whole program, including ast, cfg and call graph
+         * @brief Initialize the word the whole program, including asts and methods,
+         * irs, cfgs and the call graph are built on the first query
          * @param sourceDir the directory path of all source files
          * @param includeDir the directory path of all
          * @param std language standard, e.g. c++98, c++11, c99
@@ -67,6 +69,13 @@ namespace analyzer {
          */
         static void setLogger(util::Logger newLogger);
 
+        /**
+         * @brief replace the ir builder of the world, must be called after calling {@code initialize},
+         * irs already built are kept
+         * @param newIRBuilder a new ir builder (e.g. a DefaultIRBuilder simplifying cfgs) to be used from now on
+         */
+        static void setIRBuilder(std::unique_ptr<ir::IRBuilder> newIRBuilder);
+
     public:
 
         void build() override;
@@ -111,6 +120,12 @@ namespace analyzer {
          */
         [[nodiscard]] std::shared_ptr<lang::CPPMethod> getMainMethod() const;
 
+        /**
+         * @return the call graph of the whole program with direct calls resolved,
+         * built in parallel on the first query and cached
+         */
+        [[nodiscard]] std::shared_ptr<analysis::graph::CallGraph> getCallGraph() const;
+
         /**
          * @return the global ir builder of this world
          */
@@ -149,6 +164,8 @@ namespace analyzer {
 
         std::shared_ptr<lang::CPPMethod> mainMethod; ///< main method
 
+        mutable std::shared_ptr<analysis::graph::CallGraph> callGraph; ///< the cached call graph
+
         std::unique_ptr<ir::IRBuilder> irBuilder; ///< global ir builder
 
         std::unique_ptr<lang::TypeBuilder> typeBuilder; ///< global type builder
@@ -0,0 +1,138 @@
+#ifndef STATIC_ANALYZER_BOTTOMUPSCHEDULER_H
+#define STATIC_ANALYZER_BOTTOMUPSCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "analysis/graph/CallGraph.h"
+
+namespace analyzer::analysis {
+
+    /**
+     * @class BottomUpScheduler
+     * @brief schedules per-method work bottom-up over the condensation dag of a call graph
+     *
+     * The strongly connected components (sccs) of the call graph are computed by Tarjan's algorithm
+     * and numbered in bottom-up topological order, i.e. every callee scc has a smaller number than
+     * its callers. A run dispatches each scc to a pool of worker threads as soon as all its callee
+     * sccs are finished, and measures the work done per scc to report the critical path and the
+     * achieved parallelism.
+     */
+    class BottomUpScheduler final {
+    public:
+
+        /**
+         * @brief compute the sccs of a call graph
+         * @param callGraph the call graph to schedule over
+         */
+        explicit BottomUpScheduler(std::shared_ptr<graph::CallGraph> callGraph);
+
+        /**
+         * @return the call graph this scheduler runs over
+         */
+        [[nodiscard]] const std::shared_ptr<graph::CallGraph>& getCallGraph() const;
+
+        /**
+         * @return the number of sccs
+         */
+        [[nodiscard]] std::size_t getSCCNum() const;
+
+        /**
+         * @param methodId a method id of the call graph
+         * @return the scc containing the method
+         */
+        [[nodiscard]] std::size_t getSCCOf(std::size_t methodId) const;
+
+        /**
+         * @param scc an scc
+         * @return the sorted method ids in the scc
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getMethodIdsOf(std::size_t scc) const;
+
+        /**
+         * @param scc an scc
+         * @return true if the scc has more than one method or a method calling itself
+         */
+        [[nodiscard]] bool isRecursive(std::size_t scc) const;
+
+        /**
+         * @param scc an scc
+         * @return the sorted sccs called from scc, excluding scc itself
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getCalleeSCCsOf(std::size_t scc) const;
+
+        /**
+         * @param scc an scc
+         * @return the sorted sccs calling scc, excluding scc itself
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getCallerSCCsOf(std::size_t scc) const;
+
+        /**
+         * @return the number of sccs on the longest chain of the condensation dag
+         */
+        [[nodiscard]] std::size_t getCriticalPathLength() const;
+
+        /**
+         * @brief run a task for every scc, each after the tasks of all its callee sccs have finished
+         * @param task the task to run, called with an scc, possibly from several threads at once
+         * @param threadNum the number of worker threads, 0 for the hardware concurrency
+         */
+        void run(const std::function<void(std::size_t)>& task, std::size_t threadNum = 0);
+
+        /**
+         * @return the summed running time of all tasks of the last run, in seconds
+         */
+        [[nodiscard]] double getTotalWork() const;
+
+        /**
+         * @return the running time of the most expensive chain of tasks of the last run, in seconds,
+         * a lower bound of the wall time with any number of threads
+         */
+        [[nodiscard]] double getCriticalPathWork() const;
+
+        /**
+         * @return the wall time of the last run, in seconds
+         */
+        [[nodiscard]] double getWallTime() const;
+
+        /**
+         * @return the achieved parallelism of the last run, i.e. total work divided by wall time
+         */
+        [[nodiscard]] double getParallelism() const;
+
+    private:
+
+        std::shared_ptr<graph::CallGraph> callGraph; ///< the call graph to schedule over
+
+        std::vector<std::size_t> sccOf; ///< the scc of each method
+
+        std::vector<std::size_t> memberOffsets; ///< row offsets of methods per scc
+
+        std::vector<std::size_t> members; ///< method ids grouped by scc
+
+        std::vector<bool> recursive; ///< whether each scc is recursive
+
+        std::vector<std::size_t> calleeOffsets; ///< row offsets of callee sccs per scc
+
+        std::vector<std::size_t> calleeSCCs; ///< sorted callee sccs of each scc
+
+        std::vector<std::size_t> callerOffsets; ///< row offsets of caller sccs per scc
+
+        std::vector<std::size_t> callerSCCs; ///< sorted caller sccs of each scc
+
+        std::size_t criticalPathLength; ///< the number of sccs on the longest chain
+
+        double totalWork; ///< the summed running time of all tasks of the last run
+
+        double criticalPathWork; ///< the running time of the most expensive chain of the last run
+
+        double wallTime; ///< the wall time of the last run
+
+    };
+
+} // analysis
+
+#endif //STATIC_ANALYZER_BOTTOMUPSCHEDULER_H
@@ -0,0 +1,129 @@
+#ifndef STATIC_ANALYZER_SUMMARYANALYSIS_H
+#define STATIC_ANALYZER_SUMMARYANALYSIS_H
+
+#include <memory>
+#include <vector>
+
+#include "analysis/Analysis.h"
+#include "analysis/BottomUpScheduler.h"
+#include "language/CPPMethod.h"
+#include "World.h"
+
+namespace analyzer::analysis {
+
+    /**
+     * @class SummaryAnalysis
+     * @brief abstract base class for method analyses computing one summary per method from the
+     * summaries of its callees, evaluated bottom-up over the call graph
+     *
+     * Implementations compute the summary of a method in analyze, reading the summaries of callees
+     * through getSummaryOf. Recursive sccs start from newInitialSummary and are iterated locally
+     * until no summary changes. analyze may be called from several threads at once, on methods of
+     * different sccs.
+     * @tparam S the summary type
+     */
+    template <typename S>
+    class SummaryAnalysis: public MethodAnalysis<S> {
+    public:
+
+        /**
+         * @param method a method in a recursive scc
+         * @return the summary assumed for the method before its first evaluation (typically bottom)
+         */
+        [[nodiscard]] virtual std::shared_ptr<S> newInitialSummary(const lang::CPPMethod& method) const = 0;
+
+        /**
+         * @param s1 a summary
+         * @param s2 another summary
+         * @return true if the two summaries are equal, which ends the iteration of a recursive scc
+         */
+        [[nodiscard]] virtual bool isSameSummary(const std::shared_ptr<S>& s1, const std::shared_ptr<S>& s2) const = 0;
+
+        /**
+         * @brief compute the summaries of all methods of the call graph of a scheduler
+         * @param scheduler a bottom-up scheduler
+         * @param threadNum the number of worker threads, 0 for the hardware concurrency
+         */
+        void analyzeAll(BottomUpScheduler& scheduler, std::size_t threadNum = 0)
+        {
+            const std::shared_ptr<graph::CallGraph>& cg = scheduler.getCallGraph();
+            callGraph = cg;
+            std::size_t n = cg->getMethodNum();
+            summaries.assign(n, nullptr);
+
+            // irs are built lazily with caches shared by the whole ast, so build them before going parallel
+            World::getLogger().Info("Building the irs of " + std::to_string(n) + " methods ...");
+            std::vector<std::shared_ptr<ir::IR>> irs(n);
+            for (std::size_t id = 0; id < n; id++) {
+                irs[id] = cg->getMethod(id)->getIR();
+            }
+
+            scheduler.run([&](std::size_t scc) {
+                llvm::ArrayRef<std::size_t> methodIds = scheduler.getMethodIdsOf(scc);
+                if (!scheduler.isRecursive(scc)) {
+                    summaries[methodIds[0]] = this->analyze(irs[methodIds[0]]);
+                    return;
+                }
+                for (std::size_t id : methodIds) {
+                    summaries[id] = newInitialSummary(*cg->getMethod(id));
+                }
+                bool changed = true;
+                while (changed) {
+                    changed = false;
+                    for (std::size_t id : methodIds) {
+                        std::shared_ptr<S> summary = this->analyze(irs[id]);
+                        if (!isSameSummary(summary, summaries[id])) {
+                            summaries[id] = summary;
+                            changed = true;
+                        }
+                    }
+                }
+            }, threadNum);
+        }
+
+        /**
+         * @param methodId a method id of the call graph
+         * @return the summary of the method, nullptr if it is not computed yet
+         */
+        [[nodiscard]] std::shared_ptr<S> getSummaryOf(std::size_t methodId) const
+        {
+            return summaries[methodId];
+        }
+
+        /**
+         * @param method a method of the call graph
+         * @return the summary of the method, nullptr if it is not computed yet
+         */
+        [[nodiscard]] std::shared_ptr<S> getSummaryOf(const lang::CPPMethod& method) const
+        {
+            std::size_t id = callGraph->getMethodId(method);
+            return id < summaries.size() ? summaries[id] : nullptr;
+        }
+
+        /**
+         * @return the call graph of the last analyzeAll
+         */
+        [[nodiscard]] const std::shared_ptr<graph::CallGraph>& getCallGraph() const
+        {
+            return callGraph;
+        }
+
+    protected:
+
+        explicit SummaryAnalysis(std::unique_ptr<config::AnalysisConfig>& analysisConfig)
+            :MethodAnalysis<S>(analysisConfig)
+        {
+
+        }
+
+    private:
+
+        std::shared_ptr<graph::CallGraph> callGraph; ///< the call graph of the last analyzeAll
+
+        std::vector<std::shared_ptr<S>> summaries; ///< the summary of each method, indexed by method id
+
+    };
+
+} // analysis
+
+#endif //STATIC_ANALYZER_SUMMARYANALYSIS_H
@@ -3,12 +3,23 @@
 
 #include "analysis/Analysis.h"
 
+#include "analysis/dataflow/BoundaryDataflowResult.h"
 #include "analysis/dataflow/solver/Solver.h"
 
 namespace analyzer::analysis::dataflow {
 
     /**
      * @brief an abstract analysis driver for all dataflow analysis
+     *
+     * The option "solver" selects the solver, see solver::makeSolver. Setting the option
+     * "hash-cons" to true interns the facts of the result into a fact::HashConsTable after
+     * solving, so that statements with equal facts share one fact object, and logs the dedup ratio.
+     * Setting the option "fact-storage" to "boundary" keeps the facts only at block boundaries and
+     * recomputes the others on query (see BoundaryDataflowResult), caching up to
+     * "boundary-cache-size" recomputed facts; the default "all" keeps every fact. A driver whose
+     * analysis returns a subclass of fact::DataflowResult wraps the boundary result in
+     * wrapBoundaryResult to keep the api of that subclass.
+     *
      * @class AnalysisDriver
      * @tparam Fact the dataflow fact type
      */
@@ -30,11 +41,34 @@ namespace analyzer::analysis::dataflow {
             World::getLogger().Info("Getting dataflow analysis algorithm ...");
             std::unique_ptr<DataflowAnalysis<Fact>> dataflowAnalysis = makeAnalysis(cfg);
 
-            World::getLogger().Info("Getting dataflow analysis solver (worklist solver by default) ...");
-            std::unique_ptr<solver::Solver<Fact>> mySolver = solver::makeSolver<Fact>();
+            World::getLogger().Info("Getting dataflow analysis solver (priority worklist solver by default) ...");
+            std::unique_ptr<solver::Solver<Fact>> mySolver
+                = solver::makeSolver<Fact>(this->analysisConfig->getOption("solver"), dataflowAnalysis.get());
 
             World::getLogger().Info("Solving the dataflow analysis ...");
             std::shared_ptr<fact::DataflowResult<Fact>> result = mySolver->solve(dataflowAnalysis);
+            dataflowAnalysis->onSolved(result);
+
+            if (this->analysisConfig->getBoolOption("hash-cons")) {
+                World::getLogger().Info("Hash-consing the dataflow facts ...");
+                fact::HashConsTable<Fact> table;
+                result->internFacts(table);
+                World::getLogger().Info("Hash-consed " + std::to_string(table.getInternedNum()) + " facts into "
+                    + std::to_string(table.getUniqueNum()) + " distinct facts, dedup ratio "
+                    + std::to_string(table.getDedupRatio()));
+            }
+
+            std::string factStorage = this->analysisConfig->getOption("fact-storage");
+            if (factStorage == "boundary") {
+                auto boundaryResult = std::make_shared<BoundaryDataflowResult<Fact>>(
+                    std::move(dataflowAnalysis), result, getCacheSize());
+                World::getLogger().Info("Kept " + std::to_string(boundaryResult->getStoredFactNum()) + " of "
+                    + std::to_string(boundaryResult->getFullFactNum()) + " facts at block boundaries");
+                result = wrapBoundaryResult(boundaryResult);
+            } else if (!factStorage.empty() && factStorage != "all") {
+                World::getLogger().Error("Unknown fact storage: " + factStorage);
+                throw std::runtime_error("Unknown fact storage: " + factStorage);
+            }
 
             World::getLogger().Success("Finish dataflow analysis: " + this->analysisConfig->getDescription());
             return result;
@@ -50,6 +84,18 @@ namespace analyzer::analysis::dataflow {
         virtual std::unique_ptr<DataflowAnalysis<Fact>>
             makeAnalysis(const std::shared_ptr<graph::CFG>& cfg) const = 0;
 
+        /**
+         * @brief Wraps a result keeping the facts only at block boundaries into the result type of the
+         * analysis, by default the boundary result itself.
+         * @param boundaryResult the boundary result, its inner result is the one of the analysis
+         * @return the result to return from analyze
+         */
+        [[nodiscard]] virtual std::shared_ptr<fact::DataflowResult<Fact>>
+            wrapBoundaryResult(const std::shared_ptr<BoundaryDataflowResult<Fact>>& boundaryResult) const
+        {
+            return boundaryResult;
+        }
+
         /**
          * @brief Construct an analysis driver from analysis config
          * @param analysisConfig the configuration of this analysis
@@ -60,6 +106,25 @@ namespace analyzer::analysis::dataflow {
 
         }
 
+    private:
+
+        /**
+         * @return the value of the option "boundary-cache-size"
+         * @throw std::runtime_error if the option is not a number
+         */
+        [[nodiscard]] std::size_t getCacheSize() const
+        {
+            std::string option = this->analysisConfig->getOption("boundary-cache-size");
+            if (option.empty()) {
+                return BoundaryDataflowResult<Fact>::DEFAULT_CACHE_SIZE;
+            }
+            if (option.find_first_not_of("0123456789") != std::string::npos) {
+                World::getLogger().Error("Invalid boundary cache size: " + option);
+                throw std::runtime_error("Invalid boundary cache size: " + option);
+            }
+            return std::stoul(option);
+        }
+
     };
 
 } // dataflow
@@ -0,0 +1,369 @@
+#ifndef STATIC_ANALYZER_BOUNDARYDATAFLOWRESULT_H
+#define STATIC_ANALYZER_BOUNDARYDATAFLOWRESULT_H
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "analysis/dataflow/DataflowAnalysis.h"
+
+namespace analyzer::analysis::dataflow {
+
+    /**
+     * @class BoundaryDataflowResult
+     * @brief a dataflow result keeping the facts of a solved analysis only at block boundaries
+     *
+     * For a forward analysis, only the in facts of the boundary nodes are kept: the entry, every
+     * node without exactly one predecessor, every node whose only predecessor has other successors,
+     * and every target of a back edge. Every other node lies on a straight chain from a boundary, so
+     * its facts are recomputed on a query by replaying the transfer functions of the analysis along
+     * the chain, and the recomputed facts are kept in a small LRU cache. Backward analyses are
+     * handled symmetrically, keeping out facts. Statements that are no nodes of the cfg keep both
+     * of their facts.
+     *
+     * The result owns the analysis to replay it. The result of the analysis itself, e.g. a CPResult,
+     * is available from getInnerResult() without any facts, and an analysis driver may wrap this
+     * result to keep the api of its own (see AnalysisDriver::wrapBoundaryResult). Queries mutate the
+     * cache, so they must not run concurrently. The time spent answering them is measured, and
+     * logged with the other counters when the result is destroyed.
+     *
+     * @tparam Fact type of dataflow facts
+     */
+    template <typename Fact>
+    class BoundaryDataflowResult: public fact::DataflowResult<Fact> {
+    public:
+
+        static constexpr std::size_t DEFAULT_CACHE_SIZE = 64; ///< the default number of cached facts
+
+        [[nodiscard]] std::shared_ptr<Fact> getInFact(std::shared_ptr<ir::Stmt> node) const override
+        {
+            return timedQuery(node, false);
+        }
+
+        [[nodiscard]] std::shared_ptr<Fact> getOutFact(std::shared_ptr<ir::Stmt> node) const override
+        {
+            return timedQuery(node, true);
+        }
+
+        /**
+         * @return the result of the replayed analysis, its facts dropped
+         */
+        [[nodiscard]] const std::shared_ptr<fact::DataflowResult<Fact>>& getInnerResult() const
+        {
+            return innerResult;
+        }
+
+        /**
+         * @return the number of facts kept by this result
+         */
+        [[nodiscard]] std::size_t getStoredFactNum() const
+        {
+            return storedNum;
+        }
+
+        /**
+         * @return the number of facts in the solved result before dropping the non-boundary ones
+         */
+        [[nodiscard]] std::size_t getFullFactNum() const
+        {
+            return fullNum;
+        }
+
+        /**
+         * @return the number of in and out fact queries so far
+         */
+        [[nodiscard]] std::size_t getQueryNum() const
+        {
+            return queryNum;
+        }
+
+        /**
+         * @return the number of queries answered from the cache so far
+         */
+        [[nodiscard]] std::size_t getCacheHitNum() const
+        {
+            return hitNum;
+        }
+
+        /**
+         * @return the number of transfer functions replayed for queries so far
+         */
+        [[nodiscard]] std::size_t getReplayedTransferNum() const
+        {
+            return replayNum;
+        }
+
+        /**
+         * @return the summed time of all queries so far, in seconds
+         */
+        [[nodiscard]] double getQueryTime() const
+        {
+            return queryTime;
+        }
+
+        /**
+         * @brief Takes the facts of the boundary nodes from a solved result, and drops the others.
+         * @param dataflowAnalysis the solved analysis, replayed for queries of the dropped facts
+         * @param fullResult the result of the solved analysis
+         * @param cacheSize the maximum number of recomputed facts to cache
+         */
+        BoundaryDataflowResult(std::unique_ptr<DataflowAnalysis<Fact>> dataflowAnalysis,
+            std::shared_ptr<fact::DataflowResult<Fact>> fullResult, std::size_t cacheSize)
+            :analysis(std::move(dataflowAnalysis)), innerResult(std::move(fullResult)),
+            cfg(analysis->getCFG()), forward(analysis->isForward()), cacheSize(cacheSize),
+            boundaries(cfg->getNodeNum(), false), lru(), lruIndex(),
+            storedNum(0), fullNum(0), queryNum(0), hitNum(0), replayNum(0), queryTime(0)
+        {
+            std::size_t nodeNum = cfg->getNodeNum();
+            std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+            std::size_t exit = cfg->getNodeIndex(cfg->getExit());
+            this->reserve(nodeNum);
+            for (std::size_t index = 0; index < nodeNum; index++) {
+                const std::shared_ptr<ir::Stmt>& node = cfg->getNode(index);
+                boundaries[index] = forward ?
+                    isBoundary(index, entry, cfg->getPredIndicesOf(index), true)
+                    : isBoundary(index, exit, cfg->getSuccIndicesOf(index), false);
+                if (boundaries[index]) {
+                    // the boundary fact is also stored on its other side, no transfer produces it
+                    bool both = index == (forward ? entry : exit);
+                    if (forward || both) {
+                        keep(node, innerResult->findInFact(*node), false);
+                    }
+                    if (!forward || both) {
+                        keep(node, innerResult->findOutFact(*node), true);
+                    }
+                }
+                fullNum += 2;
+            }
+            for (const std::shared_ptr<ir::Stmt>& stmt : cfg->getIR()->getStmts()) {
+                if (cfg->getNodeIndex(stmt) == nodeNum) {
+                    keep(stmt, innerResult->findInFact(*stmt), false);
+                    keep(stmt, innerResult->findOutFact(*stmt), true);
+                    fullNum += 2;
+                }
+            }
+            innerResult->clearFacts();
+        }
+
+        ~BoundaryDataflowResult() override
+        {
+            if (queryNum == 0) {
+                return;
+            }
+            World::getLogger().Info("Answered " + std::to_string(queryNum) + " queries of "
+                + std::to_string(storedNum) + " kept of " + std::to_string(fullNum) + " facts in "
+                + std::to_string(queryTime * 1e6 / static_cast<double>(queryNum)) + "us per query, "
+                + std::to_string(hitNum) + " from the cache, replaying " + std::to_string(replayNum)
+                + " transfers");
+        }
+
+    private:
+
+        /**
+         * @param index a node index
+         * @param start the index of the entry (exit) node of a forward (backward) analysis
+         * @param sources the predecessors (successors) of the node in a forward (backward) analysis
+         * @param forward whether the analysis is forward
+         * @return true if the facts of the node cannot be replayed from another node
+         */
+        [[nodiscard]] bool isBoundary(std::size_t index, std::size_t start,
+                                      llvm::ArrayRef<std::size_t> sources, bool forward) const
+        {
+            if (index == start || sources.size() != 1) {
+                return true;
+            }
+            std::size_t source = sources.front();
+            if (forward) {
+                return source >= index || cfg->getSuccIndicesOf(source).size() != 1;
+            }
+            return source <= index || cfg->getPredIndicesOf(source).size() != 1;
+        }
+
+        /**
+         * @param node a statement
+         * @param fact a fact of node to keep, ignored if nullptr
+         * @param out true for the out fact of node, false for its in fact
+         */
+        void keep(const std::shared_ptr<ir::Stmt>& node, const std::shared_ptr<Fact>& fact, bool out)
+        {
+            if (fact == nullptr) {
+                return;
+            }
+            if (out) {
+                this->setOutFact(node, fact);
+            } else {
+                this->setInFact(node, fact);
+            }
+            storedNum++;
+        }
+
+        /**
+         * @param node a statement
+         * @param out true for the out fact of node, false for its in fact
+         * @return the fact of node, see query, adding the time to answer it to queryTime
+         */
+        [[nodiscard]] std::shared_ptr<Fact> timedQuery(const std::shared_ptr<ir::Stmt>& node, bool out) const
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::shared_ptr<Fact> fact = query(node, out);
+            queryTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return fact;
+        }
+
+        /**
+         * @param node a statement
+         * @param out true for the out fact of node, false for its in fact
+         * @return the fact of node, kept, cached or recomputed, nullptr if there is none
+         */
+        [[nodiscard]] std::shared_ptr<Fact> query(const std::shared_ptr<ir::Stmt>& node, bool out) const
+        {
+            queryNum++;
+            const std::shared_ptr<Fact>& stored = out ? this->findOutFact(*node) : this->findInFact(*node);
+            if (stored != nullptr) {
+                return stored;
+            }
+            std::size_t index = cfg->getNodeIndex(node);
+            if (index == cfg->getNodeNum()) {
+                return nullptr;
+            }
+            if (std::shared_ptr<Fact> cached = lookup(keyOf(index, out))) {
+                hitNum++;
+                return cached;
+            }
+            return replay(index, out);
+        }
+
+        /**
+         * @brief recomputes the facts of a node and the nodes before it on its chain
+         * @param index the index of the node
+         * @param out true for the out fact of the node, false for its in fact
+         * @return the requested fact
+         */
+        [[nodiscard]] std::shared_ptr<Fact> replay(std::size_t index, bool out) const
+        {
+            // the chain from the boundary to the node, in the direction of the analysis
+            std::vector<std::size_t> chain{index};
+            while (!boundaries[chain.back()]) {
+                std::size_t current = chain.back();
+                chain.emplace_back(forward ? cfg->getPredIndicesOf(current).front()
+                    : cfg->getSuccIndicesOf(current).front());
+            }
+            std::reverse(chain.begin(), chain.end());
+            std::shared_ptr<Fact> requested;
+            std::shared_ptr<Fact> previous;
+            for (std::size_t i = 0; i < chain.size(); i++) {
+                const std::shared_ptr<ir::Stmt>& node = cfg->getNode(chain[i]);
+                // a forward analysis flows from the in fact to the out fact, a backward one reversely
+                std::shared_ptr<Fact> source;
+                if (i == 0) {
+                    source = forward ? this->findInFact(*node) : this->findOutFact(*node);
+                } else {
+                    source = analysis->newInitialFact();
+                    analysis->meetInto(previous, source);
+                    remember(keyOf(chain[i], !forward), source);
+                }
+                std::shared_ptr<Fact> target = i == 0 ?
+                    (forward ? this->findOutFact(*node) : this->findInFact(*node)) : nullptr;
+                if (target == nullptr) {
+                    target = analysis->newInitialFact();
+                    if (forward) {
+                        (void) analysis->transferNode(node, source, target);
+                    } else {
+                        (void) analysis->transferNode(node, target, source);
+                    }
+                    replayNum++;
+                    remember(keyOf(chain[i], forward), target);
+                }
+                previous = target;
+                if (i + 1 == chain.size()) {
+                    requested = out == forward ? target : source;
+                }
+            }
+            return requested;
+        }
+
+        /**
+         * @param index a node index
+         * @param out true for the out fact of the node, false for its in fact
+         * @return the cache key of the fact
+         */
+        [[nodiscard]] static std::size_t keyOf(std::size_t index, bool out)
+        {
+            return index * 2 + (out ? 1 : 0);
+        }
+
+        /**
+         * @param key a cache key
+         * @return the cached fact of key, marked as most recently used, nullptr if not cached
+         */
+        [[nodiscard]] std::shared_ptr<Fact> lookup(std::size_t key) const
+        {
+            auto it = lruIndex.find(key);
+            if (it == lruIndex.end()) {
+                return nullptr;
+            }
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->second;
+        }
+
+        /**
+         * @brief caches a recomputed fact, evicting the least recently used one if the cache is full
+         * @param key the cache key of the fact
+         * @param fact the fact
+         */
+        void remember(std::size_t key, const std::shared_ptr<Fact>& fact) const
+        {
+            if (cacheSize == 0) {
+                return;
+            }
+            auto it = lruIndex.find(key);
+            if (it != lruIndex.end()) {
+                it->second->second = fact;
+                lru.splice(lru.begin(), lru, it->second);
+                return;
+            }
+            lru.emplace_front(key, fact);
+            lruIndex.emplace(key, lru.begin());
+            if (lru.size() > cacheSize) {
+                lruIndex.erase(lru.back().first);
+                lru.pop_back();
+            }
+        }
+
+        std::unique_ptr<DataflowAnalysis<Fact>> analysis; ///< the solved analysis, replayed for queries
+
+        std::shared_ptr<fact::DataflowResult<Fact>> innerResult; ///< the result of the analysis, without facts
+
+        std::shared_ptr<graph::CFG> cfg; ///< the cfg of the analysis
+
+        bool forward; ///< whether the analysis is forward
+
+        std::size_t cacheSize; ///< the maximum number of cached facts
+
+        std::vector<bool> boundaries; ///< whether each node is a boundary, by node index
+
+        mutable std::list<std::pair<std::size_t, std::shared_ptr<Fact>>>
+            lru; ///< recomputed facts by cache key, the most recently used first
+
+        mutable std::unordered_map<std::size_t, typename std::list<std::pair<std::size_t, std::shared_ptr<Fact>>>::iterator>
+            lruIndex; ///< positions in lru by cache key
+
+        std::size_t storedNum; ///< the number of kept facts
+
+        std::size_t fullNum; ///< the number of facts in the solved result
+
+        mutable std::size_t queryNum; ///< the number of queries
+
+        mutable std::size_t hitNum; ///< the number of queries answered from the cache
+
+        mutable std::size_t replayNum; ///< the number of replayed transfer functions
+
+        mutable double queryTime; ///< the summed time of all queries, in seconds
+
+    };
+
+} // dataflow
+
+#endif //STATIC_ANALYZER_BOUNDARYDATAFLOWRESULT_H
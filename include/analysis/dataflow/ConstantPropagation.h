@@ -2,17 +2,72 @@
 #define STATIC_ANALYZER_CONSTANTPROPAGATION_H
 
 #include <memory>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "analysis/dataflow/AnalysisDriver.h"
-#include "analysis/dataflow/fact/MapFact.h"
+#include "analysis/dataflow/fact/FactCodec.h"
+#include "analysis/dataflow/fact/FlatMapFact.h"
+#include "analysis/dataflow/fact/PersistentMapFact.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/IR/Constants.h"
 
 namespace analyzer::analysis::dataflow {
 
+    /**
+     * @class WideConstantTable
+     * @brief interns the constants of more than 64 bits of constant propagation values
+     *
+     * A CPValue keeps such a constant as a pointer into a table, valid as long as the table.
+     * Equal constants share one entry, so the values of one table with equal wide constants hold
+     * the same pointer. A table is not thread-safe: every analysis interns into its own.
+     */
+    class WideConstantTable final {
+    public:
+
+        /**
+         * @param constant a constant of more than 64 bits
+         * @return the entry of this table equal to constant, added if there is none
+         */
+        [[nodiscard]] const llvm::APSInt* intern(const llvm::APSInt& constant);
+
+        /**
+         * @return the number of distinct constants in this table
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+
+        /**
+         * @brief hashes a constant by its bits, bit width and signedness
+         */
+        struct Hash {
+            std::size_t operator()(const llvm::APSInt& constant) const;
+        };
+
+        /**
+         * @brief compares constants of any bit width and signedness
+         */
+        struct Equal {
+            bool operator()(const llvm::APSInt& a, const llvm::APSInt& b) const;
+        };
+
+        std::unordered_set<llvm::APSInt, Hash, Equal> constants; ///< the interned constants, never moved
+
+    };
+
     /**
      * @class CPValue
      * @brief constant propagation value
+     *
+     * A value is a trivially copyable object: its kind, and for a constant its bit width,
+     * signedness and its bits inline, so evaluating expressions never allocates or locks for
+     * constants of up to 64 bits. A wider constant is interned in a WideConstantTable and the
+     * value keeps a pointer to it, so an unshared wide value is valid only as long as its table.
+     * Shared values are not canonical: facts compare them by value (see fact::MapValueEqual),
+     * and a shared wide value owns a copy of its constant.
      */
     class CPValue {
     public:
@@ -30,17 +85,42 @@ namespace analyzer::analysis::dataflow {
         /**
          * @brief make a constant value for constant propagation
          * @param constantValue the constant value
-         * @return the constant value for constant propagation
+         * @return the shared constant value for constant propagation
          */
         [[nodiscard]] static std::shared_ptr<CPValue> makeConstant(const llvm::APSInt &constantValue);
 
+        /**
+         * @param value a constant propagation value
+         * @return a shared value equal to value, owning its wide constant if any
+         */
+        [[nodiscard]] static std::shared_ptr<CPValue> share(const CPValue& value);
+
+        /**
+         * @return the Undefined value of constant propagation, unshared
+         */
+        [[nodiscard]] static CPValue undef();
+
+        /**
+         * @return the Not A Constant value of constant propagation, unshared
+         */
+        [[nodiscard]] static CPValue nac();
+
+        /**
+         * @param constantValue the constant value
+         * @param wideConstants the table to intern a constant of more than 64 bits in
+         * @return the constant value for constant propagation, unshared
+         * @throw std::runtime_error if the constant is wider than 64 bits and wideConstants is nullptr
+         */
+        [[nodiscard]] static CPValue constant(const llvm::APSInt &constantValue,
+                                              WideConstantTable* wideConstants = nullptr);
+
     public:
 
         /**
          * @class CPValueType
          * @brief constant propagation value kind
          */
-        enum class Kind {
+        enum class Kind : uint8_t {
             UNDEF, ///< undefined value for const propagation
             NAC, ///< Not A Constant value for const propagation
             CONSTANT ///< constant value for const propagation
@@ -50,41 +130,81 @@ namespace analyzer::analysis::dataflow {
          * @brief constructor for constant propagation value
          * @param kind the constant propagation value type
          * @param constantValue the constant value
+         * @param wideConstants the table to intern a constant of more than 64 bits in
+         * @throw std::runtime_error if the constant is wider than 64 bits and wideConstants is nullptr
          */
-        explicit CPValue(Kind kind, llvm::APSInt constantValue = llvm::APSInt());
+        explicit CPValue(Kind kind, const llvm::APSInt& constantValue = llvm::APSInt(),
+                         WideConstantTable* wideConstants = nullptr);
 
         /**
          * @return true if the constant propagation value is undefined, false otherwise
          */
-        [[nodiscard]] bool isUndef() const;
+        [[nodiscard]] bool isUndef() const
+        {
+            return kind == Kind::UNDEF;
+        }
 
         /**
          * @return true if the constant propagation value is not a constant, false otherwise
          */
-        [[nodiscard]] bool isNAC() const;
+        [[nodiscard]] bool isNAC() const
+        {
+            return kind == Kind::NAC;
+        }
 
         /**
          * @return true if the constant propagation value is a constant, false otherwise
          */
-        [[nodiscard]] bool isConstant() const;
+        [[nodiscard]] bool isConstant() const
+        {
+            return kind == Kind::CONSTANT;
+        }
 
         /**
          * @return the constant value
          */
-        [[nodiscard]] const llvm::APSInt& getConstantValue() const;
+        [[nodiscard]] llvm::APSInt getConstantValue() const;
+
+        /**
+         * @param wideConstants a wide constant table
+         * @return this value with its constant interned in wideConstants if it is wider than 64 bits
+         */
+        [[nodiscard]] CPValue internedIn(WideConstantTable& wideConstants) const;
 
         /**
          * @return the string representation of this constant propagation value
          */
         [[nodiscard]] std::string str() const;
 
+        /**
+         * @return a hash of this constant propagation value, equal for equal values
+         */
+        [[nodiscard]] std::size_t hash() const;
+
         /**
          * @brief operator== for constant propagation value
          * @param other the other constant propagation value
          * @return true if the constant propagation value is equal to the other constant propagation value, false otherwise
          */
-        bool operator==(const CPValue& other) const {
-            return kind == other.kind && constantValue == other.constantValue;
+        bool operator==(const CPValue& other) const
+        {
+            if (kind != other.kind) {
+                return false;
+            }
+            if (kind != Kind::CONSTANT) {
+                return true;
+            }
+            return bitWidth == other.bitWidth && unsignedValue == other.unsignedValue && bits == other.bits
+                && (wideValue == other.wideValue || (wideValue && other.wideValue && *wideValue == *other.wideValue));
+        }
+
+        /**
+         * @param other the other constant propagation value
+         * @return true if the constant propagation values are not equal, false otherwise
+         */
+        bool operator!=(const CPValue& other) const
+        {
+            return !(*this == other);
         }
 
     private:
@@ -95,19 +215,82 @@ namespace analyzer::analysis::dataflow {
 
         Kind kind; ///< constant propagation value kind
 
-        llvm::APSInt constantValue; ///< constant value
+        bool unsignedValue; ///< whether the constant is unsigned
+
+        unsigned bitWidth; ///< the bit width of the constant
+
+        uint64_t bits; ///< the bits of a constant of at most 64 bits, zero-extended
+
+        const llvm::APSInt* wideValue; ///< a constant of more than 64 bits in a WideConstantTable, nullptr otherwise
+
+        friend class HashCPFact;
+
+        friend class DenseCPFact;
+
+    };
+
+    static_assert(std::is_trivially_copyable_v<CPValue>, "a constant propagation value should copy as plain bytes");
+
+    /**
+     * @class fact::MapValueEqual<CPValue>
+     * @brief compares shared constant propagation values by value, since they are not interned
+     */
+    template <>
+    struct fact::MapValueEqual<CPValue> {
+
+        /**
+         * @param a a value, or nullptr
+         * @param b another value, or nullptr
+         * @return true if a and b are both nullptr or equal values
+         */
+        bool operator()(const std::shared_ptr<CPValue>& a, const std::shared_ptr<CPValue>& b) const
+        {
+            return a == b || (a && b && *a == *b);
+        }
+
+    };
+
+    /**
+     * @class fact::MapValueHash<CPValue>
+     * @brief hashes shared constant propagation values by value
+     */
+    template <>
+    struct fact::MapValueHash<CPValue> {
+
+        /**
+         * @param value a value, or nullptr
+         * @return the hash of value, 0 for nullptr
+         */
+        std::size_t operator()(const std::shared_ptr<CPValue>& value) const
+        {
+            return value ? value->hash() : 0;
+        }
+
+        /**
+         * @param value a value
+         * @return the hash of value
+         */
+        std::size_t operator()(const CPValue& value) const
+        {
+            return value.hash();
+        }
 
     };
 
     /**
      * @class CPFact
      * @brief constant propagation fact
+     *
+     * The base of the representations of constant propagation facts, told apart by getKind():
+     * HashCPFact, PersistentCPFact, FlatCPFact and DenseCPFact. A variable absent from a fact is
+     * Undef, and binding it to Undef removes it. Each representation overrides either the shared
+     * get and update or the unshared getValue and updateValue, which by default adapt each other.
      */
     class CPFact: public fact::MapFact<ir::Var, CPValue> {
     public:
 
         /**
-         * @brief get the CPValue of a given var
+         * @brief get the CPValue of a given var, shared by the call
          * @param key the var to be searched
          * @return the CPValue to which the specified key is mapped,
          * or Undef if this map contains no mapping for the given var
@@ -115,27 +298,519 @@ namespace analyzer::analysis::dataflow {
         [[nodiscard]] std::shared_ptr<CPValue> get(const std::shared_ptr<ir::Var>& key) const override;
 
         /**
-         * @brief Updates the key-value mapping in this fact.
+         * @brief Updates the key-value mapping in this fact, with the value of a shared one.
          * @param key the var to update
          * @param value the CPValue to be bound to the var
          * @return true if the update changes this fact, otherwise
          */
         bool update(const std::shared_ptr<ir::Var>& key, const std::shared_ptr<CPValue>& value) override;
 
+        /**
+         * @brief get the CPValue of a given var without sharing it
+         * @param key the var to be searched
+         * @return the CPValue to which the specified key is mapped,
+         * or Undef if this map contains no mapping for the given var
+         */
+        [[nodiscard]] virtual CPValue getValue(const std::shared_ptr<ir::Var>& key) const;
+
+        /**
+         * @brief Updates the key-value mapping in this fact with an unshared value.
+         * @param key the var to update
+         * @param value the CPValue to be bound to the var
+         * @return true if the update changes this fact, otherwise
+         */
+        virtual bool updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value);
+
+        /**
+         * @brief call processor for each key-value pairs in this fact, passing the values unshared,
+         * so that hash map and dense facts need not share a value per mapping
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const CPValue&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachValue(F&& processor);
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly in
+         * the templated forEach of the representation of this fact
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const std::shared_ptr<CPValue>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor);
+
+        /**
+         * @brief calls visitor once with this fact cast to its representation, all of which are
+         * final classes, so that the calls of visitor to the fact need no virtual dispatch
+         * @tparam F type of a callable taking HashCPFact&, PersistentCPFact&, FlatCPFact& and DenseCPFact&
+         * @param visitor the callable to call
+         */
+        template <typename F>
+        void visit(F&& visitor);
+
+    protected:
+
+        /**
+         * @brief Construct an empty fact of a subclass kind
+         * @param kind the representation of the subclass
+         */
+        explicit CPFact(Kind kind);
+
+    };
+
+    /**
+     * @class fact::MapFactSubclass<ir::Var, CPValue>
+     * @brief the map facts of the derived kinds over variables and values are constant propagation facts
+     */
+    template <>
+    struct fact::MapFactSubclass<ir::Var, CPValue> {
+        using type = CPFact; ///< the subclass
+    };
+
+    /**
+     * @class HashCPFact
+     * @brief constant propagation fact stored as a hash map of the values themselves
+     *
+     * The hash map is shared copy-on-write, as the one of MapFact, but keeps each CPValue inline,
+     * so binding a variable neither allocates nor shares a value. Constants wider than 64 bits are
+     * interned in a WideConstantTable of the fact, shared with its copies.
+     */
+    class HashCPFact final: public CPFact {
+    public:
+
+        static constexpr Kind KIND = Kind::HASH_MAP_DERIVED; ///< the kind of the facts of this class
+
+        [[nodiscard]] CPValue getValue(const std::shared_ptr<ir::Var>& key) const override;
+
+        bool updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value) override;
+
+        std::shared_ptr<CPValue> remove(const std::shared_ptr<ir::Var>& key) override;
+
+        bool copyFrom(std::shared_ptr<fact::MapFact<ir::Var, CPValue>> fact) override;
+
+        [[nodiscard]] std::shared_ptr<fact::MapFact<ir::Var, CPValue>> copy() const override;
+
+        void clear() override;
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Var>> keySet() const override;
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<CPValue>> valueSet() const override;
+
+        [[nodiscard]] bool isEmpty() const override;
+
+        [[nodiscard]] std::size_t size() const override;
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const override;
+
+        void forEach(std::function<void(std::shared_ptr<ir::Var>, std::shared_ptr<CPValue>)> processor) override;
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const std::shared_ptr<CPValue>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachValue([&](const std::shared_ptr<ir::Var>& key, const CPValue& value) {
+                processor(key, CPValue::share(value));
+            });
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this fact, passing the values unshared
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const CPValue&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachValue(F&& processor)
+        {
+            // hold the hash map, so that a processor mutating this fact clones it instead
+            std::shared_ptr<const Values> current = values;
+            for (const auto& [key, value] : *current) {
+                processor(key, value);
+            }
+        }
+
+        /**
+         * @param fact a map fact
+         * @return true if fact is a hash map constant propagation fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const fact::MapFact<ir::Var, CPValue>* fact)
+        {
+            return fact->getKind() == KIND;
+        }
+
+        /**
+         * @brief Construct an empty fact
+         * @param wideConstants the table interning the constants of more than 64 bits of this fact,
+         * nullptr to create one for the first of them
+         */
+        explicit HashCPFact(std::shared_ptr<WideConstantTable> wideConstants = nullptr);
+
+    private:
+
+        using Values = std::unordered_map<std::shared_ptr<ir::Var>, CPValue>; ///< the hash map type
+
+        /**
+         * @return the hash map shared by all empty hash map facts, never mutated
+         */
+        static const std::shared_ptr<Values>& emptyValues();
+
+        /**
+         * @brief clones the hash map of this fact if it is shared with any other fact
+         * @return the hash map of this fact, owned by this fact only
+         */
+        Values& mutableValues();
+
+        std::shared_ptr<WideConstantTable> wideConstants; ///< the table of the constants of more than 64 bits of this fact
+
+        std::shared_ptr<Values> values; ///< the values of the bound variables, shared copy-on-write
+
+    };
+
+    /**
+     * @class CPFactOf
+     * @brief constant propagation fact stored in another map fact representation
+     *
+     * Adds the Undef-as-absent get and update of CPFact on top of Storage, calling the methods of
+     * Storage statically. The class is final, so calls through a pointer to it need no virtual
+     * dispatch either.
+     *
+     * @tparam Storage the map fact representation, a subclass of CPFact
+     */
+    template <typename Storage>
+    class CPFactOf final: public Storage {
+    public:
+
+        /**
+         * @brief get the CPValue of a given var
+         * @param key the var to be searched
+         * @return the CPValue to which the specified key is mapped,
+         * or Undef if this map contains no mapping for the given var
+         */
+        [[nodiscard]] std::shared_ptr<CPValue> get(const std::shared_ptr<ir::Var>& key) const override
+        {
+            std::shared_ptr<CPValue> value = Storage::get(key);
+            if (value) {
+                return value;
+            }
+            return CPValue::getUndef();
+        }
+
+        /**
+         * @brief Updates the key-value mapping in this fact.
+         * @param key the var to update
+         * @param value the CPValue to be bound to the var
+         * @return true if the update changes this fact, otherwise
+         */
+        bool update(const std::shared_ptr<ir::Var>& key, const std::shared_ptr<CPValue>& value) override
+        {
+            if (value->isUndef()) {
+                return Storage::remove(key) != nullptr;
+            }
+            return Storage::update(key, value);
+        }
+
+        [[nodiscard]] CPValue getValue(const std::shared_ptr<ir::Var>& key) const override
+        {
+            std::shared_ptr<CPValue> value = Storage::get(key);
+            return value ? *value : CPValue::undef();
+        }
+
+        bool updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value) override
+        {
+            if (getValue(key) == value) {
+                return false;
+            }
+            return update(key, CPValue::share(value));
+        }
+
+        [[nodiscard]] std::shared_ptr<fact::MapFact<ir::Var, CPValue>> copy() const override
+        {
+            return std::make_shared<CPFactOf>(*this);
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this fact, passing the values unshared
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const CPValue&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachValue(F&& processor)
+        {
+            Storage::forEach([&](const std::shared_ptr<ir::Var>& key, const std::shared_ptr<CPValue>& value) {
+                processor(key, *value);
+            });
+        }
+
     };
 
+    using PersistentCPFact = CPFactOf<fact::PersistentMapFact<ir::Var, CPValue, CPFact>>; ///< see PersistentMapFact
+
+    using FlatCPFact = CPFactOf<fact::FlatMapFact<ir::Var, CPValue, CPFact>>; ///< see FlatMapFact
+
+    /**
+     * @class DenseCPFact
+     * @brief constant propagation fact stored as dense arrays over the variables of an ir
+     *
+     * The value of the variable with index i is kept in three parallel arrays: its lattice tag
+     * (Undef, constant or NAC), its constant bits, and its bit width and signedness. Undef and NAC
+     * keep zero bits and format, so two facts over the same universe are equal exactly when the
+     * arrays are, and meetWith and copyFrom are single loops without branches that the compiler
+     * can vectorize. Constants wider than 64 bits keep the address of their entry in a
+     * WideConstantTable as their bits, so the fast paths between two dense facts require them to
+     * share the table as well as the universe. Combining with any other map fact falls back to
+     * the per-mapping methods.
+     */
+    class DenseCPFact final: public CPFact {
+    public:
+
+        static constexpr Kind KIND = Kind::DENSE; ///< the kind of the facts of this class
+
+        using Universe = std::vector<std::shared_ptr<ir::Var>>; ///< all variables, indexed by getIndex()
+
+        [[nodiscard]] CPValue getValue(const std::shared_ptr<ir::Var>& key) const override;
+
+        bool updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value) override;
+
+        std::shared_ptr<CPValue> remove(const std::shared_ptr<ir::Var>& key) override;
+
+        bool copyFrom(std::shared_ptr<fact::MapFact<ir::Var, CPValue>> fact) override;
+
+        /**
+         * @brief Meets the values of other fact into this fact, variable by variable.
+         * @param other another dense fact over the same universe and wide constant table
+         * @return true if this fact changed as a result of the call, otherwise false.
+         */
+        bool meetWith(const DenseCPFact& other);
+
+        [[nodiscard]] std::shared_ptr<fact::MapFact<ir::Var, CPValue>> copy() const override;
+
+        void clear() override;
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Var>> keySet() const override;
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<CPValue>> valueSet() const override;
+
+        [[nodiscard]] bool isEmpty() const override;
+
+        [[nodiscard]] std::size_t size() const override;
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const override;
+
+        void forEach(std::function<void(std::shared_ptr<ir::Var>, std::shared_ptr<CPValue>)> processor) override;
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const std::shared_ptr<CPValue>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachValue([&](const std::shared_ptr<ir::Var>& key, const CPValue& value) {
+                processor(key, CPValue::share(value));
+            });
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this fact, passing the values unshared
+         * @tparam F type of a callable taking const std::shared_ptr<ir::Var>& and const CPValue&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachValue(F&& processor)
+        {
+            for (std::size_t i = 0; i < tags.size(); i++) {
+                if (tags[i] != UNDEF_TAG) {
+                    processor((*universe)[i], valueAt(i));
+                }
+            }
+        }
+
+        /**
+         * @return the universe of this fact
+         */
+        [[nodiscard]] const std::shared_ptr<const Universe>& getUniverse() const
+        {
+            return universe;
+        }
+
+        /**
+         * @return the table interning the constants of more than 64 bits of this fact
+         */
+        [[nodiscard]] const std::shared_ptr<WideConstantTable>& getWideConstants() const
+        {
+            return wideConstants;
+        }
+
+        /**
+         * @param fact a map fact
+         * @return true if fact is a dense fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const fact::MapFact<ir::Var, CPValue>* fact)
+        {
+            return fact->getKind() == KIND;
+        }
+
+        /**
+         * @brief Construct a fact mapping every variable of a universe to Undef
+         * @param universe all variables that may be mapped, each at the position of its index
+         * @param wideConstants the table interning the constants of more than 64 bits of this fact,
+         * shared by the facts to combine with this one
+         */
+        explicit DenseCPFact(std::shared_ptr<const Universe> universe,
+                             std::shared_ptr<WideConstantTable> wideConstants = std::make_shared<WideConstantTable>());
+
+    private:
+
+        static constexpr uint8_t UNDEF_TAG = 0; ///< the tag of Undef, the identity of the bitwise or of tags
+
+        static constexpr uint8_t CONSTANT_TAG = 1; ///< the tag of a constant
+
+        static constexpr uint8_t NAC_TAG = 3; ///< the tag of NAC, absorbing under the bitwise or of tags
+
+        /**
+         * @param i a variable index
+         * @return the value of the i-th variable
+         */
+        [[nodiscard]] CPValue valueAt(std::size_t i) const;
+
+        /**
+         * @param i a variable index
+         * @param value the new value of the i-th variable
+         * @return true if the value of the i-th variable changed, otherwise false
+         */
+        bool setValueAt(std::size_t i, const CPValue& value);
+
+        /**
+         * @param key a variable
+         * @return the index of key in the universe
+         * @throw std::runtime_error if key is not in the universe
+         */
+        [[nodiscard]] std::size_t indexOf(const std::shared_ptr<ir::Var>& key) const;
+
+        /**
+         * @param other another map fact
+         * @return other as a dense fact if it shares the universe and wide constant table of this, otherwise nullptr
+         */
+        [[nodiscard]] const DenseCPFact* sameUniverse(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const;
+
+        std::shared_ptr<const Universe> universe; ///< all variables that may be mapped by this fact
+
+        std::shared_ptr<WideConstantTable> wideConstants; ///< the table of the constants of more than 64 bits of this fact
+
+        std::vector<uint8_t> tags; ///< the lattice tag of each variable
+
+        std::vector<uint64_t> constants; ///< the constant bits of each variable, 0 unless it is a constant
+
+        std::vector<uint32_t> formats; ///< the bit width and signedness of each variable, 0 unless it is a constant
+
+    };
+
+    template <typename F>
+    void CPFact::visit(F&& visitor)
+    {
+        switch (getKind()) {
+            case PersistentCPFact::KIND:
+                visitor(static_cast<PersistentCPFact&>(*this));
+                return;
+            case FlatCPFact::KIND:
+                visitor(static_cast<FlatCPFact&>(*this));
+                return;
+            case DenseCPFact::KIND:
+                visitor(static_cast<DenseCPFact&>(*this));
+                return;
+            default:
+                visitor(static_cast<HashCPFact&>(*this));
+        }
+    }
+
+    template <typename F>
+    void CPFact::forEachValue(F&& processor)
+    {
+        visit([&](auto& fact) {
+            fact.forEachValue(processor);
+        });
+    }
+
+    template <typename F>
+    void CPFact::forEach(F&& processor)
+    {
+        visit([&](auto& fact) {
+            fact.forEach(processor);
+        });
+    }
+
+    /**
+     * @class fact::FactValueCodec<CPValue>
+     * @brief encodes a CPValue as its kind, and for a constant also its bit width, signedness and value
+     */
+    template <>
+    struct fact::FactValueCodec<CPValue> {
+
+        /**
+         * @param value a constant propagation value
+         * @param writer the writer to append the encoding to
+         */
+        static void encode(const CPValue& value, fact::ByteWriter& writer);
+
+        /**
+         * @param reader the reader of an encoding
+         * @return the shared value
+         * @throw std::runtime_error if the encoding is invalid
+         */
+        [[nodiscard]] static std::shared_ptr<CPValue> decode(fact::ByteReader& reader);
+
+    };
+
+    /**
+     * @class fact::FactCodec<CPFact>
+     * @brief the codec of constant propagation facts of any representation, decoding into hash map facts
+     */
+    template <>
+    class fact::FactCodec<CPFact>: public fact::MapFactCodec<ir::Var, CPValue, CPFact, HashCPFact> {
+    public:
+
+        using MapFactCodec::MapFactCodec;
+
+    };
 
     /**
      * @class CPResult
      * @brief constant propagation result
+     *
+     * Besides the facts, the result keeps the value of each recorded clang expression in a dense
+     * array. A result built over three-address code uses the numbers the tac gave the expressions
+     * when lowering them as slots, so recording a value there is a plain array store. Without a
+     * tac, the slots follow the order the expressions were first recorded and a compact
+     * open-addressing map gives the slot of each expression. The expression values are accessed
+     * virtually, so that a BoundaryCPResult can forward them to the result it wraps.
      */
     class CPResult : public fact::DataflowResult<CPFact> {
     public:
     
         /**
          * @brief constructor for constant propagation result
+         * @param myTAC the three-address code numbering the recorded clang exprs,
+         * nullptr to number them in the order they are first recorded
          */
-        explicit CPResult();
+        explicit CPResult(std::shared_ptr<const ir::tac::TAC> myTAC = nullptr);
+
+        /**
+         * @brief update the constant propagation value of a given clang expr
+         * @param expr the clang expr to be updated, an expression of the tac of this result if any
+         * @param value the constant propagation value to be bound to the clang expr
+         */
+        virtual void updateExprValue(const clang::Expr* expr, const CPValue& value);
+
+        /**
+         * @brief update the constant propagation value of a clang expr numbered by the tac of this result
+         * @param number the number of the clang expr, see ir::tac::ExprTemp::number
+         * @param value the constant propagation value to be bound to the clang expr
+         */
+        virtual void updateExprValueAt(std::size_t number, const CPValue& value);
 
         /**
          * @brief update the constant propagation value of a given clang expr
@@ -152,16 +827,100 @@ namespace analyzer::analysis::dataflow {
          */
         [[nodiscard]] std::shared_ptr<CPValue> getExprValue(const clang::Expr* expr) const;
 
+        /**
+         * @brief get the constant propagation value of a given clang expr without sharing it
+         * @param expr the clang expr to be searched
+         * @return the constant propagation value to which the specified clang expr is mapped,
+         * or nullptr if this map contains no mapping for the given clang expr
+         */
+        [[nodiscard]] virtual const CPValue* findExprValue(const clang::Expr* expr) const;
+
+        /**
+         * @return the number of clang expressions whose values are recorded
+         */
+        [[nodiscard]] virtual std::size_t getExprValueNum() const;
+
+    private:
+
+        std::shared_ptr<const ir::tac::TAC> tac; ///< the tac numbering the clang expressions, nullptr if exprIndices does
+
+        llvm::DenseMap<const clang::Expr*, unsigned> exprIndices; ///< the slot of each recorded clang expression, without tac
+
+        std::vector<CPValue> exprValues; ///< the constant propagation value of the clang expression of each slot
+
+        std::vector<bool> recorded; ///< whether the value of the clang expression of each slot is recorded
+
+        std::size_t recordedNum; ///< the number of recorded clang expressions
+
+        /**
+         * @param expr a clang expr
+         * @return the slot of expr, exprValues.size() if it has none
+         */
+        [[nodiscard]] std::size_t slotOf(const clang::Expr* expr) const;
+
+        WideConstantTable wideConstants; ///< the constants of more than 64 bits of exprValues
+
+    };
+
+    /**
+     * @class BoundaryCPResult
+     * @brief a constant propagation result keeping its facts only at block boundaries
+     *
+     * The facts are queried from a BoundaryDataflowResult, and the values of clang expressions are
+     * those of the CPResult of the replayed analysis, into which replays keep recording with the
+     * option "expr-values" set to "full". Only the facts kept at block boundaries are found by
+     * findInFact and findOutFact of the boundary result, none by the ones of this result.
+     */
+    class BoundaryCPResult final: public CPResult {
+    public:
+
+        /**
+         * @brief constructor for a constant propagation result keeping its facts at block boundaries
+         * @param boundaryResult the boundary result, its inner result a CPResult
+         * @throw std::runtime_error if the inner result of boundaryResult is no CPResult
+         */
+        explicit BoundaryCPResult(std::shared_ptr<BoundaryDataflowResult<CPFact>> boundaryResult);
+
+        [[nodiscard]] std::shared_ptr<CPFact> getInFact(std::shared_ptr<ir::Stmt> node) const override;
+
+        [[nodiscard]] std::shared_ptr<CPFact> getOutFact(std::shared_ptr<ir::Stmt> node) const override;
+
+        using CPResult::updateExprValue;
+
+        void updateExprValue(const clang::Expr* expr, const CPValue& value) override;
+
+        void updateExprValueAt(std::size_t number, const CPValue& value) override;
+
+        [[nodiscard]] const CPValue* findExprValue(const clang::Expr* expr) const override;
+
+        [[nodiscard]] std::size_t getExprValueNum() const override;
+
+        /**
+         * @return the boundary result answering the fact queries, with their counters
+         */
+        [[nodiscard]] const std::shared_ptr<BoundaryDataflowResult<CPFact>>& getBoundaryResult() const;
+
     private:
 
-        std::unordered_map<const clang::Expr*, std::shared_ptr<CPValue>>
-            exprValues; ///< map from clang expression to constant propagation dataflow value
+        std::shared_ptr<BoundaryDataflowResult<CPFact>> boundaryResult; ///< the facts at block boundaries
+
+        std::shared_ptr<CPResult> innerResult; ///< the result of the replayed analysis, keeping the expression values
 
     };
 
     /**
      * @class ConstantPropagation
      * @brief constant propagation analysis
+     *
+     * Setting the option "use-tac" to true evaluates statements over the three-address code
+     * of the ir instead of walking the clang ast, with identical results. The option "map-fact"
+     * selects the representation of the facts: "hash-map" (the default) for CPFact,
+     * "persistent" for PersistentCPFact, "flat" for FlatCPFact, or "dense" for DenseCPFact.
+     * The option "expr-values" selects which values of clang expressions the CPResult records:
+     * "full" (the default) records them on every evaluation, "final" only evaluates the
+     * statements once more at the fixed point to record them, with the same values as "full",
+     * and "off" records none. With the option "fact-storage" set to "boundary", the result is
+     * a BoundaryCPResult.
      */
     class ConstantPropagation: public AnalysisDriver<CPFact> {
     public:
@@ -177,6 +936,9 @@ namespace analyzer::analysis::dataflow {
         [[nodiscard]] std::unique_ptr<DataflowAnalysis<CPFact>>
             makeAnalysis(const std::shared_ptr<graph::CFG>& cfg) const override;
 
+        [[nodiscard]] std::shared_ptr<fact::DataflowResult<CPFact>>
+            wrapBoundaryResult(const std::shared_ptr<BoundaryDataflowResult<CPFact>>& boundaryResult) const override;
+
     };
 
 } // dataflow
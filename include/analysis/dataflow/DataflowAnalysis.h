@@ -51,6 +51,53 @@ namespace analyzer::analysis::dataflow {
          */
         virtual bool transferNode(std::shared_ptr<ir::Stmt> stmt, std::shared_ptr<Fact> in, std::shared_ptr<Fact> out) const = 0;
 
+        /**
+         * @brief Delta propagation (see solver::DeltaWorkListSolver) needs a meet that is set union
+         * and a transfer function distributing over it, like gen/kill problems.
+         * @return true if this analysis supports transferNodeDelta, otherwise false.
+         */
+        [[nodiscard]] virtual bool supportsDeltaTransfer() const = 0;
+
+        /**
+         * @brief Delta node transfer function for the analysis.
+         * Transfers only the facts newly added to the in (out) fact to the out (in) fact
+         * for forward (backward) analysis, where the out (in) fact has already been
+         * transferred from the rest of the in (out) fact.
+         * @param stmt stmt to be transferred
+         * @param delta the facts newly added to the in (out) fact, already met into it
+         * @param in in facts
+         * @param out out facts
+         * @return the facts newly added to the out (in) fact, empty if it did not change
+         */
+        [[nodiscard]] virtual std::shared_ptr<Fact> transferNodeDelta(std::shared_ptr<ir::Stmt> stmt,
+            std::shared_ptr<Fact> delta, std::shared_ptr<Fact> in, std::shared_ptr<Fact> out) const = 0;
+
+        /**
+         * @brief Widening (see solver::WTOSolver) lets an analysis over a lattice of infinite height
+         * converge, by extrapolating the facts at the heads of the components of the cfg, which every
+         * cycle passes through. The transfer function of such an analysis must compute the out (in)
+         * fact from the in (out) fact alone, so that narrowing can lower the facts again.
+         * @return true if this analysis supports widenInto and narrowInto, otherwise false.
+         */
+        [[nodiscard]] virtual bool supportsWidening() const = 0;
+
+        /**
+         * @brief Widening operator of the analysis, applied to the in (out) fact of a component head
+         * for forward (backward) analysis instead of meetInto, from the second visit of the head on.
+         * @param fact the meet of the facts flowing into the head
+         * @param target the fact of the head, to be replaced by its widening with fact
+         */
+        virtual void widenInto(std::shared_ptr<Fact> fact, std::shared_ptr<Fact> target) const = 0;
+
+        /**
+         * @brief Narrowing operator of the analysis, applied to the in (out) fact of a component head
+         * for forward (backward) analysis once its component has stabilized, to recover the precision
+         * lost by widening.
+         * @param fact the meet of the facts flowing into the head
+         * @param target the fact of the head, to be replaced by its narrowing with fact
+         */
+        virtual void narrowInto(std::shared_ptr<Fact> fact, std::shared_ptr<Fact> target) const = 0;
+
         /**
          * @brief By default, a data-flow analysis does not have edge transfer, i.e.,
          * does not need to perform transfer for any edges.
@@ -71,6 +118,13 @@ namespace analyzer::analysis::dataflow {
         [[nodiscard, maybe_unused]] virtual std::shared_ptr<Fact> transferEdge
             (std::shared_ptr<graph::CFGEdge> edge, std::shared_ptr<Fact> nodeFact) const = 0;
 
+        /**
+         * @brief Called by the analysis driver once the solver has reached the fixed point,
+         * before the result is post-processed, e.g. to compute what is only needed at the fixed point.
+         * @param result the solved result
+         */
+        virtual void onSolved(const std::shared_ptr<fact::DataflowResult<Fact>>& result) = 0;
+
         /**
          * @return the control-flow graph that this analysis works on.
          */
@@ -109,6 +163,45 @@ namespace analyzer::analysis::dataflow {
             throw std::runtime_error("Transfer Edge is unsupported in dataflow analysis by default.");
         }
 
+        [[nodiscard]] bool supportsDeltaTransfer() const override
+        {
+            return false;
+        }
+
+        [[nodiscard]] std::shared_ptr<Fact> transferNodeDelta(
+                [[maybe_unused]] std::shared_ptr<ir::Stmt> stmt,
+                [[maybe_unused]] std::shared_ptr<Fact> delta,
+                [[maybe_unused]] std::shared_ptr<Fact> in,
+                [[maybe_unused]] std::shared_ptr<Fact> out) const override
+        {
+            World::getLogger().Error("Delta transfer is unsupported in dataflow analysis by default.");
+            throw std::runtime_error("Delta transfer is unsupported in dataflow analysis by default.");
+        }
+
+        [[nodiscard]] bool supportsWidening() const override
+        {
+            return false;
+        }
+
+        void widenInto([[maybe_unused]] std::shared_ptr<Fact> fact,
+                       [[maybe_unused]] std::shared_ptr<Fact> target) const override
+        {
+            World::getLogger().Error("Widening is unsupported in dataflow analysis by default.");
+            throw std::runtime_error("Widening is unsupported in dataflow analysis by default.");
+        }
+
+        void narrowInto([[maybe_unused]] std::shared_ptr<Fact> fact,
+                        [[maybe_unused]] std::shared_ptr<Fact> target) const override
+        {
+            World::getLogger().Error("Narrowing is unsupported in dataflow analysis by default.");
+            throw std::runtime_error("Narrowing is unsupported in dataflow analysis by default.");
+        }
+
+        void onSolved([[maybe_unused]] const std::shared_ptr<fact::DataflowResult<Fact>>& result) override
+        {
+
+        }
+
         [[nodiscard]] std::shared_ptr<graph::CFG> getCFG() const override
         {
             return cfg;
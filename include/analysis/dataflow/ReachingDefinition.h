@@ -4,13 +4,16 @@
 #include <memory>
 
 #include "analysis/dataflow/AnalysisDriver.h"
-#include "analysis/dataflow/fact/SetFact.h"
+#include "analysis/dataflow/fact/SetFactBuilder.h"
 
 namespace analyzer::analysis::dataflow {
 
     /**
      * @class ReachingDefinition
      * @brief reaching definition analysis
+     *
+     * The option "set-fact" selects the representation of the facts (see SetFactBuilder),
+     * e.g. "bit-vector" for BitVectorSetFact, with identical results.
      */
     class ReachingDefinition: public AnalysisDriver<fact::SetFact<ir::Stmt>> {
     public:
@@ -0,0 +1,250 @@
+#ifndef STATIC_ANALYZER_BITVECTORSETFACT_H
+#define STATIC_ANALYZER_BITVECTORSETFACT_H
+
+#include <stdexcept>
+#include <vector>
+
+#include <llvm/ADT/BitVector.h>
+
+#include "analysis/dataflow/fact/SetFact.h"
+#include "World.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class BitVectorSetFact
+     * @brief set-like data-flow facts stored as a dense bit vector over a fixed universe of elements
+     *
+     * Every element is identified by its getIndex(), which must be its position in the universe,
+     * e.g. the statements of a cfg or the variables of an ir. Facts over the same universe object
+     * are combined word by word (union, intersection, difference and equality), and the size is a
+     * population count. Combining with any other set fact falls back to the per-element methods.
+     *
+     * @tparam E elements type, providing std::size_t getIndex() const
+     */
+    template <typename E>
+    class BitVectorSetFact final: public SetFact<E> {
+    public:
+
+        using Universe = std::vector<std::shared_ptr<E>>; ///< all elements, indexed by getIndex()
+
+        [[nodiscard]] bool contains(const std::shared_ptr<E>& e) const override
+        {
+            std::size_t index = e->getIndex();
+            return index < bits.size() && bits.test(index) && (*universe)[index] == e;
+        }
+
+        bool add(const std::shared_ptr<E>& e) override
+        {
+            std::size_t index = indexOf(e);
+            if (bits.test(index)) {
+                return false;
+            }
+            bits.set(index);
+            return true;
+        }
+
+        bool remove(const std::shared_ptr<E>& e) override
+        {
+            if (!contains(e)) {
+                return false;
+            }
+            bits.reset(e->getIndex());
+            return true;
+        }
+
+        bool removeIf(std::function<bool(const std::shared_ptr<E>&)> filter) override
+        {
+            return removeElementsIf(filter);
+        }
+
+        /**
+         * @brief Removes all the elements of this fact that satisfy the given predicate, calling it directly.
+         * @tparam F type of a callable taking const std::shared_ptr<E>& and returning bool
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeIf(F&& filter)
+        {
+            return removeElementsIf(filter);
+        }
+
+        bool removeAll(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const BitVectorSetFact<E>* o = sameUniverse(other)) {
+                bool changed = bits.anyCommon(o->bits);
+                bits.reset(o->bits);
+                return changed;
+            }
+            return SetFact<E>::removeAll(other);
+        }
+
+        bool unionN(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const BitVectorSetFact<E>* o = sameUniverse(other)) {
+                bool changed = o->bits.test(bits);
+                bits |= o->bits;
+                return changed;
+            }
+            return SetFact<E>::unionN(other);
+        }
+
+        bool intersect(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const BitVectorSetFact<E>* o = sameUniverse(other)) {
+                bool changed = bits.test(o->bits);
+                bits &= o->bits;
+                return changed;
+            }
+            return SetFact<E>::intersect(other);
+        }
+
+        void setSetFact(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const BitVectorSetFact<E>* o = sameUniverse(other)) {
+                bits = o->bits;
+                return;
+            }
+            SetFact<E>::setSetFact(other);
+        }
+
+        [[nodiscard]] std::shared_ptr<SetFact<E>> copy() const override
+        {
+            return std::make_shared<BitVectorSetFact<E>>(*this);
+        }
+
+        void clear() override
+        {
+            bits.reset();
+        }
+
+        [[nodiscard]] bool isEmpty() const override
+        {
+            return bits.none();
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return bits.count();
+        }
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<SetFact<E>>& other) const override
+        {
+            if (const BitVectorSetFact<E>* o = sameUniverse(other)) {
+                return bits == o->bits;
+            }
+            return SetFact<E>::equalsTo(other);
+        }
+
+        void forEach(std::function<void(std::shared_ptr<E>)> processor) override
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @brief call processor for each elements in this set fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<E>&
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @return the universe of this fact
+         */
+        [[nodiscard]] const std::shared_ptr<const Universe>& getUniverse() const
+        {
+            return universe;
+        }
+
+        /**
+         * @param fact a set fact
+         * @return true if fact is a bit vector set fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const SetFact<E>* fact)
+        {
+            return fact->getKind() == SetFact<E>::Kind::BIT_VECTOR;
+        }
+
+        /**
+         * @brief Construct an empty set over a universe
+         * @param universe all elements that may be added, each at the position of its index
+         */
+        explicit BitVectorSetFact(std::shared_ptr<const Universe> universe)
+            :SetFact<E>(SetFact<E>::Kind::BIT_VECTOR), universe(std::move(universe)),
+            bits(static_cast<unsigned>(this->universe->size()))
+        {
+
+        }
+
+    private:
+
+        /**
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeElementsIf(F& filter)
+        {
+            bool changed = false;
+            for (unsigned index : bits.set_bits()) {
+                if (filter((*universe)[index])) {
+                    bits.reset(index);
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        /**
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEachElement(F& processor)
+        {
+            for (unsigned index : bits.set_bits()) {
+                processor((*universe)[index]);
+            }
+        }
+
+        /**
+         * @param e an element
+         * @return the index of e in the universe
+         * @throw std::runtime_error if e is not in the universe
+         */
+        [[nodiscard]] std::size_t indexOf(const std::shared_ptr<E>& e) const
+        {
+            std::size_t index = e->getIndex();
+            if (index >= bits.size() || (*universe)[index] != e) {
+                World::getLogger().Error("Element is not in the universe of the bit vector set fact");
+                throw std::runtime_error("Element is not in the universe of the bit vector set fact");
+            }
+            return index;
+        }
+
+        /**
+         * @param other another set fact
+         * @return other as a bit vector set fact if it shares the universe of this, otherwise nullptr
+         */
+        [[nodiscard]] const BitVectorSetFact<E>* sameUniverse(const std::shared_ptr<SetFact<E>>& other) const
+        {
+            if (!classof(other.get())) {
+                return nullptr;
+            }
+            const auto* o = static_cast<const BitVectorSetFact<E>*>(other.get());
+            return o->universe == universe ? o : nullptr;
+        }
+
+        std::shared_ptr<const Universe> universe; ///< all elements that may be in this fact
+
+        llvm::BitVector bits; ///< bit i is set iff the i-th element of the universe is in this fact
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_BITVECTORSETFACT_H
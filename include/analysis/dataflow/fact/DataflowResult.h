@@ -2,29 +2,58 @@
 #define STATIC_ANALYZER_DATAFLOWRESULT_H
 
 #include <unordered_map>
+#include <vector>
 
+#include "analysis/dataflow/fact/HashConsTable.h"
 #include "analysis/dataflow/fact/NodeResult.h"
 
 namespace analyzer::analysis::dataflow::fact {
 
+    /**
+     * @class DataflowResult
+     * @brief the in and out facts of the statements of a method
+     *
+     * The facts of a statement are stored at the position of its index, the node index in the cfg,
+     * so looking up a node is an array access. A statement whose index is already taken by another
+     * one, e.g. a nop contracted out of the cfg, is kept in a hash map instead. findInFact and
+     * findOutFact return a reference to the stored fact without copying the pointer.
+     *
+     * @tparam Fact the type of dataflow fact
+     */
     template <typename Fact>
     class DataflowResult: public NodeResult<Fact> {
     public:
 
         [[nodiscard]] std::shared_ptr<Fact> getInFact(std::shared_ptr<ir::Stmt> node) const override
         {
-            if (inFacts.find(node) != inFacts.end()) {
-                return inFacts.at(node);
-            }
-            return nullptr;
+            return findInFact(*node);
         }
 
         [[nodiscard]] std::shared_ptr<Fact> getOutFact(std::shared_ptr<ir::Stmt> node) const override
         {
-            if (outFacts.find(node) != outFacts.end()) {
-                return outFacts.at(node);
-            }
-            return nullptr;
+            return findOutFact(*node);
+        }
+
+        /**
+         * @brief get the flowing-in fact of a given node without sharing it
+         * @param node a statement to get the in fact
+         * @return the stored dataflow fact, nullptr if not exist
+         */
+        [[nodiscard]] const std::shared_ptr<Fact>& findInFact(const ir::Stmt& node) const
+        {
+            const Entry* entry = find(node);
+            return entry != nullptr ? entry->inFact : noFact();
+        }
+
+        /**
+         * @brief get the flowing-out fact of a given node without sharing it
+         * @param node a statement to get the out fact
+         * @return the stored dataflow fact, nullptr if not exist
+         */
+        [[nodiscard]] const std::shared_ptr<Fact>& findOutFact(const ir::Stmt& node) const
+        {
+            const Entry* entry = find(node);
+            return entry != nullptr ? entry->outFact : noFact();
         }
 
         /**
@@ -33,7 +62,7 @@ namespace analyzer::analysis::dataflow::fact {
          * @param fact a dataflow fact
          */
         void setInFact(std::shared_ptr<ir::Stmt> node, std::shared_ptr<Fact> fact) {
-            inFacts.insert_or_assign(node, fact);
+            entryOf(node).inFact = std::move(fact);
         }
 
         /**
@@ -42,7 +71,46 @@ namespace analyzer::analysis::dataflow::fact {
          * @param fact a dataflow fact
          */
         void setOutFact(std::shared_ptr<ir::Stmt> node, std::shared_ptr<Fact> fact) {
-            outFacts.insert_or_assign(node, fact);
+            entryOf(node).outFact = std::move(fact);
+        }
+
+        /**
+         * @brief Reserves room for the facts of the nodes of a cfg.
+         * @param nodeNum the number of nodes in the cfg
+         */
+        void reserve(std::size_t nodeNum) {
+            entries.reserve(nodeNum);
+        }
+
+        /**
+         * @brief Drops all in and out facts.
+         */
+        void clearFacts() {
+            entries.clear();
+            overflow.clear();
+        }
+
+        /**
+         * @brief Replaces every in and out fact by its canonical fact in a hash-consing table,
+         * so that statements with equal facts share one fact object.
+         * The facts must not be mutated afterwards.
+         * @param table the hash-consing table
+         */
+        void internFacts(HashConsTable<Fact>& table) {
+            auto intern = [&](Entry& entry) {
+                if (entry.inFact) {
+                    entry.inFact = table.intern(entry.inFact);
+                }
+                if (entry.outFact) {
+                    entry.outFact = table.intern(entry.outFact);
+                }
+            };
+            for (Entry& entry : entries) {
+                intern(entry);
+            }
+            for (auto& [_, entry] : overflow) {
+                intern(entry);
+            }
         }
 
         /**
@@ -50,29 +118,90 @@ namespace analyzer::analysis::dataflow::fact {
          * @param inFacts all in-flowing facts
          * @param outFacts all out-flowing facts
          */
-        DataflowResult(std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>> inFacts,
-            std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>> outFacts)
-            :inFacts(std::move(inFacts)), outFacts(std::move(outFacts))
+        DataflowResult(const std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>>& inFacts,
+            const std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>>& outFacts)
+            :entries(), overflow()
         {
-
+            for (const auto& [node, fact] : inFacts) {
+                setInFact(node, fact);
+            }
+            for (const auto& [node, fact] : outFacts) {
+                setOutFact(node, fact);
+            }
         }
 
         /**
          * @brief construct an empty dataflow result
          */
         DataflowResult()
-            :DataflowResult({}, {})
+            :entries(), overflow()
         {
 
         }
 
     private:
 
-        std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>>
-            inFacts; ///< in-flowing facts of each statement
+        /**
+         * @struct Entry
+         * @brief the facts of a statement
+         */
+        struct Entry {
+            std::shared_ptr<ir::Stmt> node; ///< the statement, nullptr for an unused position
+            std::shared_ptr<Fact> inFact; ///< the in-flowing fact of the statement
+            std::shared_ptr<Fact> outFact; ///< the out-flowing fact of the statement
+        };
+
+        /**
+         * @return a null fact to return references to
+         */
+        static const std::shared_ptr<Fact>& noFact()
+        {
+            static const std::shared_ptr<Fact> none = nullptr;
+            return none;
+        }
+
+        /**
+         * @param node a statement
+         * @return the facts of node, nullptr if there are none
+         */
+        [[nodiscard]] const Entry* find(const ir::Stmt& node) const
+        {
+            std::size_t index = node.getIndex();
+            if (index < entries.size() && entries[index].node.get() == &node) {
+                return &entries[index];
+            }
+            if (overflow.empty()) {
+                return nullptr;
+            }
+            auto it = overflow.find(&node);
+            return it != overflow.end() ? &it->second : nullptr;
+        }
+
+        /**
+         * @param node a statement
+         * @return the facts of node, added if there are none
+         */
+        Entry& entryOf(const std::shared_ptr<ir::Stmt>& node)
+        {
+            std::size_t index = node->getIndex();
+            if (index >= entries.size()) {
+                entries.resize(index + 1);
+            }
+            Entry& entry = entries[index];
+            if (entry.node == nullptr) {
+                entry.node = node;
+            }
+            if (entry.node == node) {
+                return entry;
+            }
+            Entry& other = overflow[node.get()];
+            other.node = node;
+            return other;
+        }
+
+        std::vector<Entry> entries; ///< the facts of each statement, at the position of its index
 
-        std::unordered_map<std::shared_ptr<ir::Stmt>, std::shared_ptr<Fact>>
-            outFacts; ///< out-flowing facts of each statement
+        std::unordered_map<const ir::Stmt*, Entry> overflow; ///< the facts of statements whose position is taken
 
     };
 
@@ -0,0 +1,410 @@
+#ifndef STATIC_ANALYZER_FACTCODEC_H
+#define STATIC_ANALYZER_FACTCODEC_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "analysis/dataflow/fact/MapFact.h"
+#include "analysis/dataflow/fact/SetFact.h"
+#include "ir/IR.h"
+#include "World.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class ByteWriter
+     * @brief appends integers to a byte buffer in the variable-length encoding of LEB128
+     */
+    class ByteWriter final {
+    public:
+
+        /**
+         * @param value a byte to append
+         */
+        void writeByte(uint8_t value)
+        {
+            bytes.emplace_back(value);
+        }
+
+        /**
+         * @param value an unsigned integer to append, in 1 byte per 7 significant bits
+         */
+        void writeVarint(uint64_t value)
+        {
+            while (value >= 0x80) {
+                bytes.emplace_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            bytes.emplace_back(static_cast<uint8_t>(value));
+        }
+
+        /**
+         * @param value a signed integer to append, zigzag-encoded so that small negative values stay short
+         */
+        void writeSignedVarint(int64_t value)
+        {
+            writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        /**
+         * @return the bytes written so far
+         */
+        [[nodiscard]] std::vector<uint8_t>& getBytes()
+        {
+            return bytes;
+        }
+
+    private:
+
+        std::vector<uint8_t> bytes; ///< the bytes written so far
+
+    };
+
+    /**
+     * @class ByteReader
+     * @brief reads back the integers written by a ByteWriter
+     */
+    class ByteReader final {
+    public:
+
+        /**
+         * @return the next byte
+         * @throw std::runtime_error if the bytes are exhausted
+         */
+        uint8_t readByte()
+        {
+            if (position == bytes.size()) {
+                World::getLogger().Error("Truncated dataflow fact record");
+                throw std::runtime_error("Truncated dataflow fact record");
+            }
+            return bytes[position++];
+        }
+
+        /**
+         * @return the next unsigned integer
+         * @throw std::runtime_error if the bytes are exhausted or encode more than 64 bits
+         */
+        uint64_t readVarint()
+        {
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = readByte();
+                // the tenth byte holds the last bit only
+                if (shift == 63 && (byte & 0x7e) != 0) {
+                    break;
+                }
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (byte < 0x80) {
+                    return value;
+                }
+            }
+            World::getLogger().Error("Dataflow fact record holds an integer of more than 64 bits");
+            throw std::runtime_error("Dataflow fact record holds an integer of more than 64 bits");
+        }
+
+        /**
+         * @return the next signed integer
+         * @throw std::runtime_error if the bytes are exhausted
+         */
+        int64_t readSignedVarint()
+        {
+            uint64_t value = readVarint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        /**
+         * @param bytes the bytes to read
+         */
+        explicit ByteReader(std::vector<uint8_t> bytes)
+            :bytes(std::move(bytes)), position(0)
+        {
+
+        }
+
+    private:
+
+        std::vector<uint8_t> bytes; ///< the bytes to read
+
+        std::size_t position; ///< the position of the next byte to read
+
+    };
+
+    /**
+     * @class FactElements
+     * @brief the elements of the facts of an ir that a codec can encode, indexed by getIndex()
+     * @tparam E element type, ir::Var or ir::Stmt
+     */
+    template <typename E>
+    struct FactElements;
+
+    /**
+     * @class FactElements<ir::Var>
+     * @brief the variables of an ir
+     */
+    template <>
+    struct FactElements<ir::Var> {
+
+        /**
+         * @param ir an ir
+         * @return the variables of ir, each at the position of its index
+         */
+        [[nodiscard]] static std::vector<std::shared_ptr<ir::Var>> of(const ir::IR& ir)
+        {
+            return ir.getVarsByIndex();
+        }
+
+    };
+
+    /**
+     * @class FactElements<ir::Stmt>
+     * @brief the nodes of the cfg of an ir
+     */
+    template <>
+    struct FactElements<ir::Stmt> {
+
+        /**
+         * @param ir an ir
+         * @return the nodes of the cfg of ir, which are indexed by Stmt::getIndex()
+         */
+        [[nodiscard]] static std::vector<std::shared_ptr<ir::Stmt>> of(const ir::IR& ir)
+        {
+            return ir.getCFG()->getNodes();
+        }
+
+    };
+
+    /**
+     * @class ElementCodec
+     * @brief encodes the elements of the facts of one ir as their indices
+     * @tparam E element type, see FactElements
+     */
+    template <typename E>
+    class ElementCodec {
+    public:
+
+        /**
+         * @param e an element
+         * @return the index of e
+         * @throw std::runtime_error if e is no element of the ir
+         */
+        [[nodiscard]] std::size_t indexOf(const std::shared_ptr<E>& e) const
+        {
+            std::size_t index = e->getIndex();
+            if (index >= elements.size() || elements[index] != e) {
+                World::getLogger().Error("Cannot encode a fact element outside the ir, index "
+                    + std::to_string(index));
+                throw std::runtime_error("Cannot encode a fact element outside the ir, index "
+                    + std::to_string(index));
+            }
+            return index;
+        }
+
+        /**
+         * @param index an index read from a record
+         * @return the element of index
+         * @throw std::runtime_error if there is no element of index
+         */
+        [[nodiscard]] const std::shared_ptr<E>& elementOf(uint64_t index) const
+        {
+            if (index >= elements.size() || elements[index] == nullptr) {
+                World::getLogger().Error("Invalid fact element index " + std::to_string(index));
+                throw std::runtime_error("Invalid fact element index " + std::to_string(index));
+            }
+            return elements[index];
+        }
+
+        /**
+         * @param ir the ir of the facts to encode and decode
+         */
+        explicit ElementCodec(const ir::IR& ir)
+            :elements(FactElements<E>::of(ir))
+        {
+
+        }
+
+    private:
+
+        std::vector<std::shared_ptr<E>> elements; ///< the elements, at the position of their index
+
+    };
+
+    /**
+     * @class FactValueCodec
+     * @brief encodes the values of map facts, to be specialized for each value type,
+     * providing static void encode(const V&, ByteWriter&) and static std::shared_ptr<V> decode(ByteReader&)
+     * @tparam V value type
+     */
+    template <typename V>
+    struct FactValueCodec;
+
+    /**
+     * @class SetFactCodec
+     * @brief encodes a set fact as its size and the gaps between its sorted element indices
+     * @tparam E element type, see FactElements
+     * @tparam Fact the set fact class to decode into, default-constructible
+     */
+    template <typename E, typename Fact = SetFact<E>>
+    class SetFactCodec {
+    public:
+
+        /**
+         * @param fact a set fact
+         * @param writer the writer to append the encoding to
+         */
+        void encode(const std::shared_ptr<Fact>& fact, ByteWriter& writer) const
+        {
+            std::vector<std::size_t> indices;
+            fact->forEach([&](const std::shared_ptr<E>& e) {
+                indices.emplace_back(elementCodec.indexOf(e));
+            });
+            std::sort(indices.begin(), indices.end());
+            writer.writeVarint(indices.size());
+            std::size_t previous = 0;
+            for (std::size_t index : indices) {
+                writer.writeVarint(index - previous);
+                previous = index;
+            }
+        }
+
+        /**
+         * @param reader the reader of an encoding
+         * @return a new set fact, of the default representation of Fact
+         */
+        [[nodiscard]] std::shared_ptr<Fact> decode(ByteReader& reader) const
+        {
+            auto fact = std::make_shared<Fact>();
+            uint64_t size = reader.readVarint();
+            uint64_t index = 0;
+            for (uint64_t i = 0; i < size; i++) {
+                index += reader.readVarint();
+                fact->add(elementCodec.elementOf(index));
+            }
+            return fact;
+        }
+
+        /**
+         * @param ir the ir of the facts to encode and decode
+         */
+        explicit SetFactCodec(const ir::IR& ir)
+            :elementCodec(ir)
+        {
+
+        }
+
+    private:
+
+        ElementCodec<E> elementCodec; ///< the codec of the elements
+
+    };
+
+    /**
+     * @class MapFactCodec
+     * @brief encodes a map fact as its size, and the gaps between its sorted key indices each
+     * followed by the encoding of the value
+     * @tparam K key type, see FactElements
+     * @tparam V value type, copyable, see FactValueCodec
+     * @tparam Fact the map fact class to encode and decode
+     * @tparam Decoded the representation to decode into, Fact or a subclass of it, default-constructible
+     */
+    template <typename K, typename V, typename Fact = MapFact<K, V>, typename Decoded = Fact>
+    class MapFactCodec {
+    public:
+
+        /**
+         * @param fact a map fact
+         * @param writer the writer to append the encoding to
+         */
+        void encode(const std::shared_ptr<Fact>& fact, ByteWriter& writer) const
+        {
+            // copy the values, which a fact may create on the fly, e.g. DenseCPFact
+            std::vector<std::pair<std::size_t, V>> mappings;
+            fact->forEachValue([&](const std::shared_ptr<K>& key, const V& value) {
+                mappings.emplace_back(keyCodec.indexOf(key), value);
+            });
+            std::sort(mappings.begin(), mappings.end(),
+                [](const std::pair<std::size_t, V>& a, const std::pair<std::size_t, V>& b) {
+                    return a.first < b.first;
+                });
+            writer.writeVarint(mappings.size());
+            std::size_t previous = 0;
+            for (const auto& [index, value] : mappings) {
+                writer.writeVarint(index - previous);
+                FactValueCodec<V>::encode(value, writer);
+                previous = index;
+            }
+        }
+
+        /**
+         * @param reader the reader of an encoding
+         * @return a new map fact, of the representation Decoded
+         */
+        [[nodiscard]] std::shared_ptr<Fact> decode(ByteReader& reader) const
+        {
+            auto fact = std::make_shared<Decoded>();
+            uint64_t size = reader.readVarint();
+            uint64_t index = 0;
+            for (uint64_t i = 0; i < size; i++) {
+                index += reader.readVarint();
+                const std::shared_ptr<K>& key = keyCodec.elementOf(index);
+                fact->update(key, FactValueCodec<V>::decode(reader));
+            }
+            return fact;
+        }
+
+        /**
+         * @param ir the ir of the facts to encode and decode
+         */
+        explicit MapFactCodec(const ir::IR& ir)
+            :keyCodec(ir)
+        {
+
+        }
+
+    private:
+
+        ElementCodec<K> keyCodec; ///< the codec of the keys
+
+    };
+
+    /**
+     * @class FactCodec
+     * @brief the binary codec of a fact type, specialized for SetFact and MapFact, and for CPFact
+     * next to it. A codec is constructed from the ir of the facts, and provides
+     * void encode(const std::shared_ptr<Fact>&, ByteWriter&) const and
+     * std::shared_ptr<Fact> decode(ByteReader&) const.
+     * @tparam Fact the fact type
+     */
+    template <typename Fact>
+    class FactCodec;
+
+    /**
+     * @class FactCodec<SetFact<E>>
+     * @brief the codec of set facts, see SetFactCodec
+     */
+    template <typename E>
+    class FactCodec<SetFact<E>>: public SetFactCodec<E> {
+    public:
+
+        using SetFactCodec<E>::SetFactCodec;
+
+    };
+
+    /**
+     * @class FactCodec<MapFact<K, V>>
+     * @brief the codec of map facts, see MapFactCodec
+     */
+    template <typename K, typename V>
+    class FactCodec<MapFact<K, V>>: public MapFactCodec<K, V> {
+    public:
+
+        using MapFactCodec<K, V>::MapFactCodec;
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_FACTCODEC_H
@@ -0,0 +1,301 @@
+#ifndef STATIC_ANALYZER_FLATMAPFACT_H
+#define STATIC_ANALYZER_FLATMAPFACT_H
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include "analysis/dataflow/fact/MapFact.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class FlatMapFact
+     * @brief map-like data-flow facts stored as a vector of mappings sorted by key index
+     *
+     * The mappings lie contiguously in a small vector, inline for up to INLINE_SIZE of them, so
+     * the small facts of most functions need no heap allocation. Between two flat facts, copyFrom,
+     * joinWith and equalsTo are linear merge-joins over the sorted mappings, and copyFrom only
+     * overwrites the values in place when both facts map the same keys. Combining with any other
+     * map fact falls back to the per-mapping methods.
+     *
+     * @tparam K key type, providing std::size_t getIndex() const
+     * @tparam V value type
+     * @tparam Base the map fact class to store flat, MapFact<K, V> or a subclass of it
+     * with a protected constructor taking a MapFact<K, V>::Kind. Facts over a subclass get the kind
+     * FLAT_DERIVED, so the subclass must be the MapFactSubclass of MapFact<K, V>.
+     */
+    template <typename K, typename V, typename Base>
+    class FlatMapFact: public Base {
+    public:
+
+        static_assert(std::is_same_v<Base, MapFact<K, V>> || std::is_same_v<Base, typename MapFactSubclass<K, V>::type>,
+                      "a map fact of a derived kind must be a MapFactSubclass");
+
+        /**
+         * @brief the kind of the facts of this class, told apart by the base without RTTI
+         */
+        static constexpr typename MapFact<K, V>::Kind KIND = std::is_same_v<Base, MapFact<K, V>> ?
+            MapFact<K, V>::Kind::FLAT : MapFact<K, V>::Kind::FLAT_DERIVED;
+
+        static constexpr unsigned INLINE_SIZE = 8; ///< the number of mappings stored without heap allocation
+
+        [[nodiscard]] std::shared_ptr<V> get(const std::shared_ptr<K>& key) const override
+        {
+            auto it = lowerBound(key);
+            return it != entries.end() && it->first == key ? it->second : nullptr;
+        }
+
+        bool update(const std::shared_ptr<K>& key, const std::shared_ptr<V>& value) override
+        {
+            auto it = lowerBound(key);
+            if (it == entries.end() || it->first != key) {
+                entries.insert(it, Entry(key, value));
+                return true;
+            }
+            if (MapValueEqual<V>()(it->second, value)) {
+                return false;
+            }
+            it->second = value;
+            return true;
+        }
+
+        std::shared_ptr<V> remove(const std::shared_ptr<K>& key) override
+        {
+            auto it = lowerBound(key);
+            if (it == entries.end() || it->first != key) {
+                return nullptr;
+            }
+            std::shared_ptr<V> result = std::move(it->second);
+            entries.erase(it);
+            return result;
+        }
+
+        bool copyFrom(const std::shared_ptr<MapFact<K, V>> fact) override
+        {
+            if (const FlatMapFact* o = sameFlat(fact)) {
+                return joinWith(*o, [](const std::shared_ptr<V>&, const std::shared_ptr<V>& value) {
+                    return value;
+                });
+            }
+            return MapFact<K, V>::copyFrom(fact);
+        }
+
+        /**
+         * @brief Merges the mappings of other flat fact into this fact in one merge-join.
+         *
+         * Keys mapped only by other are mapped to their value in other, and keys mapped by both
+         * are mapped to the result of combine.
+         *
+         * @tparam F function type of std::shared_ptr<V>(const std::shared_ptr<V>&, const std::shared_ptr<V>&)
+         * @param other another flat fact
+         * @param combine a function from the values of a key in this and other to its new value
+         * @return true if this fact changed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool joinWith(const FlatMapFact& other, F combine)
+        {
+            if (&other == this) {
+                return false;
+            }
+            bool changed = false;
+            if (sameKeys(other)) {
+                for (std::size_t i = 0; i < entries.size(); i++) {
+                    std::shared_ptr<V> value = combine(entries[i].second, other.entries[i].second);
+                    if (!MapValueEqual<V>()(value, entries[i].second)) {
+                        entries[i].second = std::move(value);
+                        changed = true;
+                    }
+                }
+                return changed;
+            }
+            Entries result;
+            result.reserve(entries.size() + other.entries.size());
+            auto it = entries.begin();
+            auto oit = other.entries.begin();
+            while (it != entries.end() || oit != other.entries.end()) {
+                if (oit == other.entries.end() || (it != entries.end() && less(it->first, oit->first))) {
+                    result.emplace_back(std::move(*it++));
+                } else if (it == entries.end() || less(oit->first, it->first)) {
+                    result.emplace_back(*oit++);
+                    changed = true;
+                } else {
+                    std::shared_ptr<V> value = combine(it->second, oit->second);
+                    changed = changed || !MapValueEqual<V>()(value, it->second);
+                    result.emplace_back(std::move(it->first), std::move(value));
+                    ++it;
+                    ++oit;
+                }
+            }
+            entries = std::move(result);
+            return changed;
+        }
+
+        [[nodiscard]] std::shared_ptr<MapFact<K, V>> copy() const override
+        {
+            return std::make_shared<FlatMapFact>(*this);
+        }
+
+        void clear() override
+        {
+            entries.clear();
+        }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<K>> keySet() const override
+        {
+            std::unordered_set<std::shared_ptr<K>> result;
+            for (const Entry& entry : entries) {
+                result.emplace(entry.first);
+            }
+            return result;
+        }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<V>> valueSet() const override
+        {
+            std::unordered_set<std::shared_ptr<V>> result;
+            for (const Entry& entry : entries) {
+                result.emplace(entry.second);
+            }
+            return result;
+        }
+
+        [[nodiscard]] bool isEmpty() const override
+        {
+            return entries.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return entries.size();
+        }
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<MapFact<K, V>>& other) const override
+        {
+            if (const FlatMapFact* o = sameFlat(other)) {
+                return entries.size() == o->entries.size()
+                    && std::equal(entries.begin(), entries.end(), o->entries.begin(),
+                        [](const Entry& a, const Entry& b) {
+                            return a.first == b.first && MapValueEqual<V>()(a.second, b.second);
+                        });
+            }
+            return MapFact<K, V>::equalsTo(other);
+        }
+
+        void forEach(std::function<void(std::shared_ptr<K>, std::shared_ptr<V>)> processor) override
+        {
+            forEachMapping(processor);
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<K>& and const std::shared_ptr<V>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachMapping(processor);
+        }
+
+        /**
+         * @param fact a map fact
+         * @return true if fact is a flat map fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const MapFact<K, V>* fact)
+        {
+            return fact->getKind() == KIND;
+        }
+
+        /**
+         * @brief Construct an empty map
+         */
+        FlatMapFact()
+            :Base(KIND)
+        {
+
+        }
+
+    private:
+
+        using Entry = std::pair<std::shared_ptr<K>, std::shared_ptr<V>>; ///< a mapping
+
+        using Entries = llvm::SmallVector<Entry, INLINE_SIZE>; ///< mappings sorted by key
+
+        /**
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachMapping(F& processor)
+        {
+            for (const Entry& entry : entries) {
+                processor(entry.first, entry.second);
+            }
+        }
+
+        /**
+         * @param a a key
+         * @param b another key
+         * @return true if a is ordered before b, by index and then by address
+         */
+        static bool less(const std::shared_ptr<K>& a, const std::shared_ptr<K>& b)
+        {
+            std::size_t ai = a->getIndex();
+            std::size_t bi = b->getIndex();
+            return ai < bi || (ai == bi && std::less<K*>()(a.get(), b.get()));
+        }
+
+        /**
+         * @param key a key
+         * @return the first mapping whose key is not ordered before key
+         */
+        [[nodiscard]] typename Entries::iterator lowerBound(const std::shared_ptr<K>& key)
+        {
+            return std::lower_bound(entries.begin(), entries.end(), key,
+                [](const Entry& entry, const std::shared_ptr<K>& k) {
+                    return less(entry.first, k);
+                });
+        }
+
+        /**
+         * @param key a key
+         * @return the first mapping whose key is not ordered before key
+         */
+        [[nodiscard]] typename Entries::const_iterator lowerBound(const std::shared_ptr<K>& key) const
+        {
+            return std::lower_bound(entries.begin(), entries.end(), key,
+                [](const Entry& entry, const std::shared_ptr<K>& k) {
+                    return less(entry.first, k);
+                });
+        }
+
+        /**
+         * @param other another flat fact
+         * @return true if this and other map exactly the same keys
+         */
+        [[nodiscard]] bool sameKeys(const FlatMapFact& other) const
+        {
+            return entries.size() == other.entries.size()
+                && std::equal(entries.begin(), entries.end(), other.entries.begin(),
+                    [](const Entry& a, const Entry& b) {
+                        return a.first == b.first;
+                    });
+        }
+
+        /**
+         * @param other another map fact
+         * @return other as a flat map fact of the same base, nullptr if it is of another kind
+         */
+        [[nodiscard]] static const FlatMapFact* sameFlat(const std::shared_ptr<MapFact<K, V>>& other)
+        {
+            return classof(other.get()) ? static_cast<const FlatMapFact*>(other.get()) : nullptr;
+        }
+
+        Entries entries; ///< the mappings of this fact, sorted by key
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_FLATMAPFACT_H
@@ -0,0 +1,132 @@
+#ifndef STATIC_ANALYZER_HASHCONSTABLE_H
+#define STATIC_ANALYZER_HASHCONSTABLE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "analysis/dataflow/fact/MapFact.h"
+#include "analysis/dataflow/fact/SetFact.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class HashConsTable
+     * @brief a hash-consing table keeping one canonical object for each distinct fact content
+     *
+     * Each canonical fact is stored with its hash, computed once when it is interned, so looking
+     * up a fact compares it only with the canonical facts of the same hash. After all facts of a
+     * result are interned, facts with equal content are the same object and can be compared by
+     * pointer. Canonical facts are shared, so they must not be mutated any more.
+     *
+     * @tparam Fact type of dataflow facts, a SetFact or a MapFact
+     */
+    template <typename Fact>
+    class HashConsTable final {
+    public:
+
+        /**
+         * @brief Construct an empty table
+         */
+        HashConsTable()
+            :internedNum(0), uniqueNum(0)
+        {
+
+        }
+
+        /**
+         * @param fact a dataflow fact
+         * @return the canonical fact equal to fact, which is fact itself if it is new to this table
+         */
+        [[nodiscard]] std::shared_ptr<Fact> intern(const std::shared_ptr<Fact>& fact)
+        {
+            internedNum++;
+            std::vector<std::shared_ptr<Fact>>& bucket = buckets[hashOf(*fact)];
+            for (const std::shared_ptr<Fact>& canonical : bucket) {
+                if (canonical == fact || canonical->equalsTo(fact)) {
+                    return canonical;
+                }
+            }
+            bucket.emplace_back(fact);
+            uniqueNum++;
+            return fact;
+        }
+
+        /**
+         * @return the number of facts interned into this table
+         */
+        [[nodiscard]] std::size_t getInternedNum() const
+        {
+            return internedNum;
+        }
+
+        /**
+         * @return the number of distinct facts stored in this table
+         */
+        [[nodiscard]] std::size_t getUniqueNum() const
+        {
+            return uniqueNum;
+        }
+
+        /**
+         * @return the number of interned facts per distinct fact, 1 if nothing is interned
+         */
+        [[nodiscard]] double getDedupRatio() const
+        {
+            return uniqueNum == 0 ? 1.0 : static_cast<double>(internedNum) / static_cast<double>(uniqueNum);
+        }
+
+    private:
+
+        /**
+         * @param x a hash value
+         * @return x with its bits mixed, so that summing mixed hashes does not cancel out
+         */
+        static std::size_t mix(std::size_t x)
+        {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return x;
+        }
+
+        /**
+         * @param fact a set fact
+         * @return a hash of the elements of fact, independent of their order
+         */
+        template <typename E>
+        static std::size_t hashOf(SetFact<E>& fact)
+        {
+            std::size_t hash = fact.size();
+            fact.forEach([&](const std::shared_ptr<E>& e) {
+                hash += mix(std::hash<std::shared_ptr<E>>()(e));
+            });
+            return hash;
+        }
+
+        /**
+         * @param fact a map fact, of type Fact
+         * @return a hash of the mappings of fact, independent of their order
+         */
+        template <typename K, typename V>
+        static std::size_t hashOf(MapFact<K, V>& fact)
+        {
+            std::size_t hash = fact.size();
+            // the values of Fact itself, which a subclass of MapFact may pass without sharing them
+            static_cast<Fact&>(fact).forEachValue([&](const std::shared_ptr<K>& key, const V& value) {
+                hash += mix(std::hash<std::shared_ptr<K>>()(key) * 31 + MapValueHash<V>()(value));
+            });
+            return hash;
+        }
+
+        std::unordered_map<std::size_t, std::vector<std::shared_ptr<Fact>>>
+            buckets; ///< canonical facts by their hash
+
+        std::size_t internedNum; ///< the number of facts interned into this table
+
+        std::size_t uniqueNum; ///< the number of distinct facts stored in this table
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_HASHCONSTABLE_H
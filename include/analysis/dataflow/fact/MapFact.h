@@ -4,16 +4,105 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 #include "util/Copyable.h"
 
 namespace analyzer::analysis::dataflow::fact {
 
+    template <typename K, typename V>
+    class MapFact;
+
+    template <typename K, typename V, typename Base = MapFact<K, V>>
+    class PersistentMapFact;
+
+    template <typename K, typename V, typename Base = MapFact<K, V>>
+    class FlatMapFact;
+
+    /**
+     * @class MapFactSubclass
+     * @brief the subclass of MapFact<K, V> with representations of the derived kinds, MapFact<K, V>
+     * itself unless specialized
+     *
+     * A subclass of MapFact<K, V> stored in another representation (e.g. CPFact) specializes this
+     * template, and provides a templated forEach itself, so that the templated forEach of MapFact
+     * casts the facts of the derived kinds to it and calls its forEach statically.
+     *
+     * @tparam K key type
+     * @tparam V value type
+     */
+    template <typename K, typename V>
+    struct MapFactSubclass {
+        using type = MapFact<K, V>; ///< the subclass
+    };
+
+    /**
+     * @class MapValueEqual
+     * @brief the equality of the values of map facts, identity unless specialized
+     *
+     * A value type whose equal values may be distinct objects specializes this template,
+     * together with MapValueHash, to compare the values themselves.
+     *
+     * @tparam V value type
+     */
+    template <typename V>
+    struct MapValueEqual {
+
+        /**
+         * @param a a value, or nullptr
+         * @param b another value, or nullptr
+         * @return true if a and b are the same object
+         */
+        bool operator()(const std::shared_ptr<V>& a, const std::shared_ptr<V>& b) const
+        {
+            return a == b;
+        }
+    };
+
+    /**
+     * @class MapValueHash
+     * @brief the hash of the values of map facts, consistent with MapValueEqual
+     * @tparam V value type
+     */
+    template <typename V>
+    struct MapValueHash {
+
+        /**
+         * @param value a value
+         * @return a hash of value, equal for values equal under MapValueEqual
+         */
+        std::size_t operator()(const std::shared_ptr<V>& value) const
+        {
+            return std::hash<std::shared_ptr<V>>()(value);
+        }
+
+        /**
+         * @param value a value stored in a map fact
+         * @return a hash of the address of value, i.e. of its identity
+         */
+        std::size_t operator()(const V& value) const
+        {
+            return std::hash<const V*>()(&value);
+        }
+
+    };
+
     /**
      * @class MapFact
      * @brief Represents map-like data-flow facts.
      *
-     * Elements are checked by identity rather than equality !!!
+     * Elements are checked by identity rather than equality !!! Values are compared with
+     * MapValueEqual, which is identity as well unless the value type specializes it.
+     *
+     * This class keeps its mappings in a hash map shared copy-on-write: copy() shares the hash map,
+     * which is cloned on the first mutation that really changes it, and two facts sharing a hash
+     * map are equal in O(1). Subclasses with another representation
+     * (see PersistentMapFact, FlatMapFact, HashCPFact and DenseCPFact) override every virtual method and are told apart by getKind().
+     * Binary operations between facts of different kinds fall back to the per-mapping methods.
+     * The templated forEach switches once on the kind, and calls the templated forEach of the
+     * representation with its callable directly, see MapFactSubclass for the derived kinds.
+     * Subclasses of kind HASH_MAP must not override forEach.
      *
      * @tparam K key type
      * @tparam V value type
@@ -22,6 +111,27 @@ namespace analyzer::analysis::dataflow::fact {
     class MapFact: public util::Copyable<MapFact<K, V>> {
     public:
 
+        /**
+         * @brief the representation of a map fact
+         */
+        enum class Kind {
+            HASH_MAP, ///< a hash map of mappings, this class itself
+            HASH_MAP_DERIVED, ///< a hash map of values in a subclass of MapFact, e.g. HashCPFact
+            PERSISTENT, ///< a persistent hash trie sharing structure with its copies, see PersistentMapFact
+            PERSISTENT_DERIVED, ///< a persistent hash trie in a subclass of MapFact, e.g. CPFact
+            FLAT, ///< a small vector of mappings sorted by key index, see FlatMapFact
+            FLAT_DERIVED, ///< a small vector of mappings in a subclass of MapFact, e.g. CPFact
+            DENSE, ///< dense arrays of values over all key indices, see DenseCPFact
+        };
+
+        /**
+         * @return the representation of this map fact
+         */
+        [[nodiscard]] Kind getKind() const
+        {
+            return kind;
+        }
+
         /**
          * @brief get the value of a given key
          * @param key the key to be searched
@@ -30,10 +140,8 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual std::shared_ptr<V> get(const std::shared_ptr<K>& key) const
         {
-            if (map.find(key) == map.end()) {
-                return nullptr;
-            }
-            return map.at(key);
+            auto it = map->find(key);
+            return it == map->end() ? nullptr : it->second;
         }
 
         /**
@@ -44,14 +152,11 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool update(const std::shared_ptr<K>& key, const std::shared_ptr<V>& value)
         {
-            if (map.find(key) == map.end()) {
-                map.emplace(key, value);
-                return true;
-            }
-            if (map.at(key) == value) {
+            auto it = map->find(key);
+            if (it != map->end() && MapValueEqual<V>()(it->second, value)) {
                 return false;
             }
-            map.at(key) = value;
+            mutableMap().insert_or_assign(key, value);
             return true;
         }
 
@@ -62,11 +167,12 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual std::shared_ptr<V> remove(const std::shared_ptr<K>& key)
         {
-            if (map.find(key) == map.end()) {
+            auto it = map->find(key);
+            if (it == map->end()) {
                 return nullptr;
             }
-            std::shared_ptr<V> result = map.at(key);
-            map.erase(key);
+            std::shared_ptr<V> result = it->second;
+            mutableMap().erase(key);
             return result;
         }
 
@@ -78,19 +184,28 @@ namespace analyzer::analysis::dataflow::fact {
         virtual bool copyFrom(const std::shared_ptr<MapFact<K, V>> fact)
         {
             bool changed = false;
-            for (const auto& [key, value] : fact->getMap()) {
-                changed = update(key, value) || changed;
+            if (isHashMapWith(fact)) {
+                if (map == fact->map) {
+                    return false;
+                }
+                for (const auto& [key, value] : *fact->map) {
+                    changed = update(key, value) || changed;
+                }
+                return changed;
             }
+            fact->forEach([&](const std::shared_ptr<K>& key, const std::shared_ptr<V>& value) {
+                changed = update(key, value) || changed;
+            });
             return changed;
         }
 
         /**
-         * @brief creates and returns a copy of this fact
+         * @brief creates and returns a copy sharing the hash map of this fact until either is mutated
          * @return a copy of this fact
          */
         [[nodiscard]] std::shared_ptr<MapFact<K, V>> copy() const override
         {
-            return std::make_shared<MapFact<K, V>>(map);
+            return std::make_shared<MapFact<K, V>>(*this);
         }
 
         /**
@@ -98,7 +213,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual void clear()
         {
-            map.clear();
+            map = emptyMap();
         }
 
         /**
@@ -107,7 +222,7 @@ namespace analyzer::analysis::dataflow::fact {
         [[nodiscard]] virtual std::unordered_set<std::shared_ptr<K>> keySet() const
         {
             std::unordered_set<std::shared_ptr<K>> result;
-            for (auto& [k, _] : map) {
+            for (auto& [k, _] : *map) {
                 result.emplace(k);
             }
             return result;
@@ -119,7 +234,7 @@ namespace analyzer::analysis::dataflow::fact {
         [[nodiscard]] virtual std::unordered_set<std::shared_ptr<V>> valueSet() const
         {
             std::unordered_set<std::shared_ptr<V>> result;
-            for (auto& [_, v] : map) {
+            for (auto& [_, v] : *map) {
                 result.emplace(v);
             }
             return result;
@@ -130,7 +245,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual bool isEmpty() const
         {
-            return map.empty();
+            return map->empty();
         }
 
         /**
@@ -138,7 +253,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual std::size_t size() const
         {
-            return map.size();
+            return map->size();
         }
 
         /**
@@ -148,7 +263,26 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual bool equalsTo(const std::shared_ptr<MapFact<K, V>>& other) const
         {
-            return map == other->getMap();
+            if (isHashMapWith(other) && map == other->map) {
+                return true;
+            }
+            if (size() != other->size()) {
+                return false;
+            }
+            if (isHashMapWith(other)) {
+                for (const auto& [key, value] : *other->map) {
+                    auto it = map->find(key);
+                    if (it == map->end() || !MapValueEqual<V>()(it->second, value)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            bool equal = true;
+            other->forEach([&](const std::shared_ptr<K>& key, const std::shared_ptr<V>& value) {
+                equal = equal && MapValueEqual<V>()(get(key), value);
+            });
+            return equal;
         }
 
         /**
@@ -157,17 +291,61 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual void forEach(std::function<void(std::shared_ptr<K>, std::shared_ptr<V>)> processor)
         {
-            for (auto [k, v] : map) {
-                processor(k, v);
+            forEachInHashMap(processor);
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly in
+         * the templated forEach of the representation of this fact
+         * @tparam F type of a callable taking const std::shared_ptr<K>& and const std::shared_ptr<V>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            using Subclass = typename MapFactSubclass<K, V>::type;
+            switch (kind) {
+                case Kind::HASH_MAP:
+                    forEachInHashMap(processor);
+                    return;
+                case Kind::PERSISTENT:
+                    static_cast<PersistentMapFact<K, V>&>(*this).forEach(processor);
+                    return;
+                case Kind::FLAT:
+                    static_cast<FlatMapFact<K, V>&>(*this).forEach(processor);
+                    return;
+                default:
+                    // only a specialized MapFactSubclass has facts of the derived kinds
+                    if constexpr (!std::is_same_v<Subclass, MapFact<K, V>>) {
+                        static_cast<Subclass&>(*this).forEach(processor);
+                    }
             }
         }
 
+        /**
+         * @brief call processor for each key-value pairs in this map fact, passing the value itself
+         *
+         * A subclass whose values are not stored as objects, e.g. DenseCPFact, hides this method
+         * with one passing temporary values, so callers must compare and hash the values with
+         * MapValueEqual and MapValueHash rather than by address.
+         *
+         * @tparam F type of a callable taking const std::shared_ptr<K>& and const V&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachValue(F&& processor)
+        {
+            forEach([&](const std::shared_ptr<K>& key, const std::shared_ptr<V>& value) {
+                processor(key, *value);
+            });
+        }
+
         /**
          * @brief Constructs a new MapFact with the same mappings as specified Map.
          * @param map the map whose mappings are to be placed in this map.
          */
         explicit MapFact(std::unordered_map<std::shared_ptr<K>, std::shared_ptr<V>> map)
-            :map(std::move(map))
+            :kind(Kind::HASH_MAP), map(std::make_shared<Map>(std::move(map)))
         {
 
         }
@@ -176,26 +354,82 @@ namespace analyzer::analysis::dataflow::fact {
          * @brief Construct an empty set
          */
         MapFact()
-            : MapFact(std::unordered_map<std::shared_ptr<K>, std::shared_ptr<V>>{})
+            :kind(Kind::HASH_MAP), map(emptyMap())
+        {
+
+        }
+
+        virtual ~MapFact() = default;
+
+    protected:
+
+        /**
+         * @brief Construct an empty map of a subclass kind
+         * @param kind the representation of the subclass
+         */
+        explicit MapFact(Kind kind)
+            :kind(kind), map(emptyMap())
         {
 
         }
 
+        /**
+         * @param other another map fact
+         * @return true if both this and other keep their mappings in the inner hash map
+         */
+        [[nodiscard]] bool isHashMapWith(const std::shared_ptr<MapFact<K, V>>& other) const
+        {
+            return kind == Kind::HASH_MAP && other->kind == Kind::HASH_MAP;
+        }
+
     private:
 
+        using Map = std::unordered_map<std::shared_ptr<K>, std::shared_ptr<V>>; ///< the hash map type
+
+        /**
+         * @return the hash map shared by all empty hash map facts, never mutated
+         */
+        static const std::shared_ptr<Map>& emptyMap()
+        {
+            static const std::shared_ptr<Map> empty = std::make_shared<Map>();
+            return empty;
+        }
+
         /**
-         * @return a constant reference to the inner map
+         * @param processor a processor function to process each key-value pair of the hash map
          */
-        const std::unordered_map<std::shared_ptr<K>, std::shared_ptr<V>>& getMap() const
+        template <typename F>
+        void forEachInHashMap(F& processor)
         {
-            return map;
+            // hold the hash map, so that a processor mutating this fact clones it instead
+            std::shared_ptr<const Map> current = map;
+            for (const auto& [k, v] : *current) {
+                processor(k, v);
+            }
         }
 
-        std::unordered_map<std::shared_ptr<K>, std::shared_ptr<V>>
-            map; ///< The map holding the mappings of this MapFact.
+        /**
+         * @brief clones the hash map of this fact if it is shared with any other fact
+         * @return the hash map of this fact, owned by this fact only
+         */
+        Map& mutableMap()
+        {
+            if (map.use_count() > 1) {
+                map = std::make_shared<Map>(*map);
+            }
+            return *map;
+        }
+
+        Kind kind; ///< the representation of this map fact
+
+        std::shared_ptr<Map> map; ///< The map holding the mappings of this MapFact, shared copy-on-write, unused by subclasses.
 
     };
 
 } // fact
 
+// the representations the templated forEach of MapFact dispatches to
+#include "analysis/dataflow/fact/FlatMapFact.h"
+#include "analysis/dataflow/fact/PersistentMapFact.h"
+
 #endif //STATIC_ANALYZER_MAPFACT_H
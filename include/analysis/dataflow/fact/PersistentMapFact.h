@@ -0,0 +1,189 @@
+#ifndef STATIC_ANALYZER_PERSISTENTMAPFACT_H
+#define STATIC_ANALYZER_PERSISTENTMAPFACT_H
+
+#include <type_traits>
+
+#include "analysis/dataflow/fact/MapFact.h"
+#include "util/PersistentHashMap.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class PersistentMapFact
+     * @brief map-like data-flow facts stored in a persistent hash trie
+     *
+     * A copy shares the whole trie with the original in O(1), and an update copies only the path
+     * to the changed mapping, so the facts of neighbouring statements share almost all of their
+     * storage. copyFrom and comparisons between persistent facts skip every subtree the two facts
+     * share. Combining with any other map fact falls back to the per-mapping methods.
+     *
+     * @tparam K key type
+     * @tparam V value type
+     * @tparam Base the map fact class to store persistently, MapFact<K, V> or a subclass of it
+     * with a protected constructor taking a MapFact<K, V>::Kind. Facts over a subclass get the kind
+     * PERSISTENT_DERIVED, so the subclass must be the MapFactSubclass of MapFact<K, V>.
+     */
+    template <typename K, typename V, typename Base>
+    class PersistentMapFact: public Base {
+    public:
+
+        static_assert(std::is_same_v<Base, MapFact<K, V>> || std::is_same_v<Base, typename MapFactSubclass<K, V>::type>,
+                      "a map fact of a derived kind must be a MapFactSubclass");
+
+        /**
+         * @brief the kind of the facts of this class, told apart by the base without RTTI
+         */
+        static constexpr typename MapFact<K, V>::Kind KIND = std::is_same_v<Base, MapFact<K, V>> ?
+            MapFact<K, V>::Kind::PERSISTENT : MapFact<K, V>::Kind::PERSISTENT_DERIVED;
+
+        [[nodiscard]] std::shared_ptr<V> get(const std::shared_ptr<K>& key) const override
+        {
+            const std::shared_ptr<V>* value = map.find(key);
+            return value ? *value : nullptr;
+        }
+
+        bool update(const std::shared_ptr<K>& key, const std::shared_ptr<V>& value) override
+        {
+            return assign(map.insert(key, value));
+        }
+
+        std::shared_ptr<V> remove(const std::shared_ptr<K>& key) override
+        {
+            std::shared_ptr<V> result = get(key);
+            if (result) {
+                map = map.erase(key);
+            }
+            return result;
+        }
+
+        bool copyFrom(const std::shared_ptr<MapFact<K, V>> fact) override
+        {
+            if (const PersistentMapFact* o = samePersistent(fact)) {
+                return assign(map.updateWith(o->map));
+            }
+            return MapFact<K, V>::copyFrom(fact);
+        }
+
+        [[nodiscard]] std::shared_ptr<MapFact<K, V>> copy() const override
+        {
+            return std::make_shared<PersistentMapFact>(*this);
+        }
+
+        void clear() override
+        {
+            map = Trie();
+        }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<K>> keySet() const override
+        {
+            std::unordered_set<std::shared_ptr<K>> result;
+            map.forEach([&](const typename Trie::Entry& entry) {
+                result.emplace(entry.first);
+            });
+            return result;
+        }
+
+        [[nodiscard]] std::unordered_set<std::shared_ptr<V>> valueSet() const override
+        {
+            std::unordered_set<std::shared_ptr<V>> result;
+            map.forEach([&](const typename Trie::Entry& entry) {
+                result.emplace(entry.second);
+            });
+            return result;
+        }
+
+        [[nodiscard]] bool isEmpty() const override
+        {
+            return map.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return map.size();
+        }
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<MapFact<K, V>>& other) const override
+        {
+            if (const PersistentMapFact* o = samePersistent(other)) {
+                return map == o->map;
+            }
+            return MapFact<K, V>::equalsTo(other);
+        }
+
+        void forEach(std::function<void(std::shared_ptr<K>, std::shared_ptr<V>)> processor) override
+        {
+            forEachMapping(processor);
+        }
+
+        /**
+         * @brief call processor for each key-value pairs in this map fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<K>& and const std::shared_ptr<V>&
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachMapping(processor);
+        }
+
+        /**
+         * @param fact a map fact
+         * @return true if fact is a persistent map fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const MapFact<K, V>* fact)
+        {
+            return fact->getKind() == KIND;
+        }
+
+        /**
+         * @brief Construct an empty map
+         */
+        PersistentMapFact()
+            :Base(KIND)
+        {
+
+        }
+
+    private:
+
+        using Trie = util::PersistentHashMap<std::shared_ptr<K>, std::shared_ptr<V>,
+            std::hash<std::shared_ptr<K>>, MapValueEqual<V>>; ///< the trie type
+
+        /**
+         * @param processor a processor function to process each key-value pair
+         */
+        template <typename F>
+        void forEachMapping(F& processor)
+        {
+            map.forEach([&](const typename Trie::Entry& entry) {
+                processor(entry.first, entry.second);
+            });
+        }
+
+        /**
+         * @param newMap the new content of this fact
+         * @return true if newMap differs from the old content, otherwise false
+         */
+        bool assign(Trie newMap)
+        {
+            bool changed = !newMap.isSameAs(map);
+            map = std::move(newMap);
+            return changed;
+        }
+
+        /**
+         * @param other another map fact
+         * @return other as a persistent map fact of the same base, nullptr if it is of another kind
+         */
+        [[nodiscard]] static const PersistentMapFact* samePersistent(const std::shared_ptr<MapFact<K, V>>& other)
+        {
+            return classof(other.get()) ? static_cast<const PersistentMapFact*>(other.get()) : nullptr;
+        }
+
+        Trie map; ///< the mappings of this fact
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_PERSISTENTMAPFACT_H
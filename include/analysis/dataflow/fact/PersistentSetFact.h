@@ -0,0 +1,224 @@
+#ifndef STATIC_ANALYZER_PERSISTENTSETFACT_H
+#define STATIC_ANALYZER_PERSISTENTSETFACT_H
+
+#include <vector>
+
+#include "analysis/dataflow/fact/SetFact.h"
+#include "util/PersistentHashMap.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class PersistentSetFact
+     * @brief set-like data-flow facts stored in a persistent hash trie
+     *
+     * A copy shares the whole trie with the original in O(1), and an update copies only the path
+     * to the changed element, so the facts of neighbouring statements share almost all of their
+     * storage. Unions and comparisons between persistent facts skip every subtree the two facts
+     * share. Combining with any other set fact falls back to the per-element methods.
+     *
+     * @tparam E elements type
+     */
+    template <typename E>
+    class PersistentSetFact final: public SetFact<E> {
+    public:
+
+        [[nodiscard]] bool contains(const std::shared_ptr<E>& e) const override
+        {
+            return set.find(e) != nullptr;
+        }
+
+        bool add(const std::shared_ptr<E>& e) override
+        {
+            return assign(set.insert(e, true));
+        }
+
+        bool remove(const std::shared_ptr<E>& e) override
+        {
+            return assign(set.erase(e));
+        }
+
+        bool removeIf(std::function<bool(const std::shared_ptr<E>&)> filter) override
+        {
+            return removeElementsIf(filter);
+        }
+
+        /**
+         * @brief Removes all the elements of this fact that satisfy the given predicate, calling it directly.
+         * @tparam F type of a callable taking const std::shared_ptr<E>& and returning bool
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeIf(F&& filter)
+        {
+            return removeElementsIf(filter);
+        }
+
+        bool removeAll(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const PersistentSetFact<E>* o = samePersistent(other)) {
+                if (o->set.isSameAs(set)) {
+                    bool changed = !set.empty();
+                    set = Trie();
+                    return changed;
+                }
+                if (o->set.size() < set.size()) {
+                    Trie newSet = set;
+                    o->set.forEach([&](const typename Trie::Entry& entry) {
+                        newSet = newSet.erase(entry.first);
+                    });
+                    return assign(std::move(newSet));
+                }
+            }
+            return SetFact<E>::removeAll(other);
+        }
+
+        bool unionN(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const PersistentSetFact<E>* o = samePersistent(other)) {
+                return assign(set.unionWith(o->set));
+            }
+            return SetFact<E>::unionN(other);
+        }
+
+        bool intersect(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const PersistentSetFact<E>* o = samePersistent(other); o && o->set.isSameAs(set)) {
+                return false;
+            }
+            return SetFact<E>::intersect(other);
+        }
+
+        void setSetFact(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const PersistentSetFact<E>* o = samePersistent(other)) {
+                set = o->set;
+                return;
+            }
+            SetFact<E>::setSetFact(other);
+        }
+
+        [[nodiscard]] std::shared_ptr<SetFact<E>> copy() const override
+        {
+            return std::make_shared<PersistentSetFact<E>>(*this);
+        }
+
+        void clear() override
+        {
+            set = Trie();
+        }
+
+        [[nodiscard]] bool isEmpty() const override
+        {
+            return set.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return set.size();
+        }
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<SetFact<E>>& other) const override
+        {
+            if (const PersistentSetFact<E>* o = samePersistent(other)) {
+                return set == o->set;
+            }
+            return SetFact<E>::equalsTo(other);
+        }
+
+        void forEach(std::function<void(std::shared_ptr<E>)> processor) override
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @brief call processor for each elements in this set fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<E>&
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @param fact a set fact
+         * @return true if fact is a persistent set fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const SetFact<E>* fact)
+        {
+            return fact->getKind() == SetFact<E>::Kind::PERSISTENT;
+        }
+
+        /**
+         * @brief Construct an empty set
+         */
+        PersistentSetFact()
+            :SetFact<E>(SetFact<E>::Kind::PERSISTENT)
+        {
+
+        }
+
+    private:
+
+        using Trie = util::PersistentHashMap<std::shared_ptr<E>, bool>; ///< the trie type, mapping elements to true
+
+        /**
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeElementsIf(F& filter)
+        {
+            std::vector<std::shared_ptr<E>> toRemove;
+            set.forEach([&](const typename Trie::Entry& entry) {
+                if (filter(entry.first)) {
+                    toRemove.emplace_back(entry.first);
+                }
+            });
+            for (const std::shared_ptr<E>& e : toRemove) {
+                set = set.erase(e);
+            }
+            return !toRemove.empty();
+        }
+
+        /**
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEachElement(F& processor)
+        {
+            set.forEach([&](const typename Trie::Entry& entry) {
+                processor(entry.first);
+            });
+        }
+
+        /**
+         * @param newSet the new content of this fact
+         * @return true if newSet differs from the old content, otherwise false
+         */
+        bool assign(Trie newSet)
+        {
+            bool changed = !newSet.isSameAs(set);
+            set = std::move(newSet);
+            return changed;
+        }
+
+        /**
+         * @param other another set fact
+         * @return other as a persistent set fact, nullptr if it is of another kind
+         */
+        [[nodiscard]] static const PersistentSetFact<E>* samePersistent(const std::shared_ptr<SetFact<E>>& other)
+        {
+            return classof(other.get()) ? static_cast<const PersistentSetFact<E>*>(other.get()) : nullptr;
+        }
+
+        Trie set; ///< the elements of this fact
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_PERSISTENTSETFACT_H
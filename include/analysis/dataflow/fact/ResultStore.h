@@ -0,0 +1,217 @@
+#ifndef STATIC_ANALYZER_RESULTSTORE_H
+#define STATIC_ANALYZER_RESULTSTORE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "analysis/dataflow/fact/DataflowResult.h"
+#include "analysis/dataflow/fact/FactCodec.h"
+#include "util/AppendOnlyFile.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class ResultStore
+     * @brief keeps the dataflow results of many methods on disk, loading each back on demand
+     *
+     * A stored result is encoded into one record of an util::AppendOnlyFile, and only the position
+     * of the record is kept in memory, keyed by the method signature of the ir. A record holds each
+     * distinct fact object of the result once, encoded by the codec of the fact type, followed by
+     * the numbers of the in and out facts of every statement, so facts shared between statements,
+     * e.g. hash-consed ones, are encoded once and shared again when loaded. Statements are listed
+     * in the order of the nodes of the cfg, followed by the statements outside the cfg.
+     *
+     * Results of different methods may be stored and loaded concurrently, e.g. by the workers of a
+     * parallel analysis. Storing a method again replaces its result, its old record stays in the
+     * file unused. Only the facts are stored, not the rest of a subclass of DataflowResult, and
+     * loaded facts have the default representation of Fact.
+     *
+     * @tparam Fact the type of dataflow facts
+     * @tparam Codec the binary codec of the facts, see FactCodec
+     */
+    template <typename Fact, typename Codec = FactCodec<Fact>>
+    class ResultStore final {
+    public:
+
+        /**
+         * @brief Encodes and appends the result of a method.
+         * @param ir the ir of the method
+         * @param result the dataflow result of the method
+         * @throw std::runtime_error if the result holds facts of elements outside ir, or the file cannot grow
+         */
+        void store(const std::shared_ptr<ir::IR>& ir, const DataflowResult<Fact>& result)
+        {
+            Codec codec(*ir);
+            ByteWriter factWriter;
+            ByteWriter nodeWriter;
+            std::unordered_map<const Fact*, std::size_t> factNumbers;
+            auto numberOf = [&](const std::shared_ptr<Fact>& fact) -> std::size_t {
+                if (fact == nullptr) {
+                    return 0;
+                }
+                auto [it, inserted] = factNumbers.emplace(fact.get(), factNumbers.size() + 1);
+                if (inserted) {
+                    codec.encode(fact, factWriter);
+                }
+                return it->second;
+            };
+            for (const std::shared_ptr<ir::Stmt>& stmt : statementsOf(*ir)) {
+                nodeWriter.writeVarint(numberOf(result.getInFact(stmt)));
+                nodeWriter.writeVarint(numberOf(result.getOutFact(stmt)));
+            }
+            ByteWriter writer;
+            writer.writeVarint(factNumbers.size());
+            std::vector<uint8_t>& record = writer.getBytes();
+            record.insert(record.end(), factWriter.getBytes().begin(), factWriter.getBytes().end());
+            record.insert(record.end(), nodeWriter.getBytes().begin(), nodeWriter.getBytes().end());
+
+            Record position{0, record.size()};
+            try {
+                position.offset = file->append(record);
+            } catch (const std::runtime_error& e) {
+                World::getLogger().Error(e.what());
+                throw;
+            }
+            std::lock_guard<std::mutex> lock(indexMutex);
+            index.insert_or_assign(ir->getMethod().getMethodSignatureAsString(), position);
+        }
+
+        /**
+         * @brief Reads and decodes the result of a method.
+         * @param ir the ir of the method
+         * @return the stored dataflow result of the method, nullptr if it has not been stored
+         */
+        [[nodiscard]] std::shared_ptr<DataflowResult<Fact>> load(const std::shared_ptr<ir::IR>& ir) const
+        {
+            Record position;
+            {
+                std::lock_guard<std::mutex> lock(indexMutex);
+                auto it = index.find(ir->getMethod().getMethodSignatureAsString());
+                if (it == index.end()) {
+                    return nullptr;
+                }
+                position = it->second;
+            }
+            Codec codec(*ir);
+            ByteReader reader(file->read(position.offset, position.size));
+            std::vector<std::shared_ptr<Fact>> facts(reader.readVarint() + 1);
+            for (std::size_t i = 1; i < facts.size(); i++) {
+                facts[i] = codec.decode(reader);
+            }
+            auto factOf = [&](uint64_t number) -> const std::shared_ptr<Fact>& {
+                if (number >= facts.size()) {
+                    World::getLogger().Error("Invalid fact number " + std::to_string(number));
+                    throw std::runtime_error("Invalid fact number " + std::to_string(number));
+                }
+                return facts[number];
+            };
+            auto result = std::make_shared<DataflowResult<Fact>>();
+            result->reserve(ir->getCFG()->getNodeNum());
+            for (const std::shared_ptr<ir::Stmt>& stmt : statementsOf(*ir)) {
+                if (const std::shared_ptr<Fact>& inFact = factOf(reader.readVarint())) {
+                    result->setInFact(stmt, inFact);
+                }
+                if (const std::shared_ptr<Fact>& outFact = factOf(reader.readVarint())) {
+                    result->setOutFact(stmt, outFact);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @param ir the ir of a method
+         * @return true if the result of the method has been stored
+         */
+        [[nodiscard]] bool contains(const ir::IR& ir) const
+        {
+            std::lock_guard<std::mutex> lock(indexMutex);
+            return index.find(ir.getMethod().getMethodSignatureAsString()) != index.end();
+        }
+
+        /**
+         * @return the number of methods whose results are stored
+         */
+        [[nodiscard]] std::size_t getStoredNum() const
+        {
+            std::lock_guard<std::mutex> lock(indexMutex);
+            return index.size();
+        }
+
+        /**
+         * @return the number of bytes written to the file
+         */
+        [[nodiscard]] std::size_t getFileSize() const
+        {
+            return file->getSize();
+        }
+
+        /**
+         * @brief Creates an empty store.
+         * @param path the path of its file, replaced if it exists and removed with the store
+         * @param initialCapacity the initial size of the file in bytes, which grows as needed
+         * @throw std::runtime_error if the file cannot be created
+         */
+        explicit ResultStore(const std::string& path,
+                             std::size_t initialCapacity = util::AppendOnlyFile::INITIAL_CAPACITY)
+            :file(openFile(path, initialCapacity)), index(), indexMutex()
+        {
+
+        }
+
+    private:
+
+        /**
+         * @struct Record
+         * @brief the position of a stored result in the file
+         */
+        struct Record {
+            std::size_t offset; ///< the offset of the record
+            std::size_t size; ///< the size of the record in bytes
+        };
+
+        /**
+         * @param path the path of the file
+         * @param initialCapacity the initial size of the file in bytes
+         * @return the created file
+         * @throw std::runtime_error if the file cannot be created
+         */
+        static std::unique_ptr<util::AppendOnlyFile> openFile(const std::string& path, std::size_t initialCapacity)
+        {
+            try {
+                return std::make_unique<util::AppendOnlyFile>(path, initialCapacity);
+            } catch (const std::runtime_error& e) {
+                World::getLogger().Error(e.what());
+                throw;
+            }
+        }
+
+        /**
+         * @param ir an ir
+         * @return the statements whose facts are stored, in the order of their records
+         */
+        [[nodiscard]] static std::vector<std::shared_ptr<ir::Stmt>> statementsOf(const ir::IR& ir)
+        {
+            std::shared_ptr<graph::CFG> cfg = ir.getCFG();
+            std::vector<std::shared_ptr<ir::Stmt>> stmts = cfg->getNodes();
+            for (const std::shared_ptr<ir::Stmt>& stmt : ir.getStmts()) {
+                if (cfg->getNodeIndex(stmt) == cfg->getNodeNum()) {
+                    stmts.emplace_back(stmt);
+                }
+            }
+            return stmts;
+        }
+
+        std::unique_ptr<util::AppendOnlyFile> file; ///< the file of the records
+
+        std::unordered_map<std::string, Record> index; ///< the record of each method, by method signature
+
+        mutable std::mutex indexMutex; ///< guards index
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_RESULTSTORE_H
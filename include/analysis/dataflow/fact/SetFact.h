@@ -4,23 +4,62 @@
 #include <unordered_set>
 #include <functional>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "util/Copyable.h"
 
 namespace analyzer::analysis::dataflow::fact {
 
+    template <typename E>
+    class BitVectorSetFact;
+
+    template <typename E>
+    class SparseBitVectorSetFact;
+
+    template <typename E>
+    class PersistentSetFact;
+
     /**
      * @class SetFact
      * @brief Represents set-like data-flow facts.
      *
      * Elements are checked by identity rather than equality !!!
      *
+     * This class keeps its elements in a hash set shared copy-on-write: copy() and setSetFact() of
+     * another hash set fact share the hash set, which is cloned on the first mutation that really
+     * changes it, and two facts sharing a hash set are equal in O(1). Subclasses with another representation (see
+     * BitVectorSetFact, SparseBitVectorSetFact and PersistentSetFact) override every virtual method
+     * and are told apart by getKind().
+     * Binary operations between facts of different kinds fall back to the per-element methods.
+     * The templated forEach and removeIf switch once on the kind, and call the templated method of
+     * the final subclass of the representation with their callable directly.
+     * Subclasses of kind HASH_SET must not override forEach or removeIf.
+     *
      * @tparam E elements type
      */
     template <typename E>
     class SetFact: public util::Copyable<SetFact<E>> {
     public:
 
+        /**
+         * @brief the representation of a set fact
+         */
+        enum class Kind {
+            HASH_SET, ///< a hash set of elements, this class itself
+            BIT_VECTOR, ///< a dense bit vector over element indices, see BitVectorSetFact
+            SPARSE_BIT_VECTOR, ///< a sparse bit vector over element indices, see SparseBitVectorSetFact
+            PERSISTENT, ///< a persistent hash trie sharing structure with its copies, see PersistentSetFact
+        };
+
+        /**
+         * @return the representation of this set fact
+         */
+        [[nodiscard]] Kind getKind() const
+        {
+            return kind;
+        }
+
         /**
          * @brief check the existence of an element
          * @param e the element to be checked
@@ -28,7 +67,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual bool contains(const std::shared_ptr<E>& e) const
         {
-            return set.find(e) != set.end();
+            return set->find(e) != set->end();
         }
 
         /**
@@ -38,7 +77,11 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool add(const std::shared_ptr<E>& e)
         {
-            return set.emplace(e).second;
+            if (contains(e)) {
+                return false;
+            }
+            mutableSet().emplace(e);
+            return true;
         }
 
         /**
@@ -48,7 +91,11 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool remove(const std::shared_ptr<E>& e)
         {
-            return set.erase(e) == 1;
+            if (!contains(e)) {
+                return false;
+            }
+            mutableSet().erase(e);
+            return true;
         }
 
         /**
@@ -58,17 +105,29 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool removeIf(std::function<bool(const std::shared_ptr<E>&)> filter)
         {
-            std::size_t oldSize = set.size();
-            std::vector<std::shared_ptr<E>> toRemove;
-            for (const std::shared_ptr<E>& e : set) {
-                if (filter(e)) {
-                    toRemove.emplace_back(e);
-                }
-            }
-            for (const std::shared_ptr<E>& e : toRemove) {
-                set.erase(e);
+            return removeFromHashSetIf(filter);
+        }
+
+        /**
+         * @brief Removes all the elements of this fact that satisfy the given predicate, calling
+         * the predicate directly in the templated removeIf of the representation of this fact.
+         * @tparam F type of a callable taking const std::shared_ptr<E>& and returning bool
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeIf(F&& filter)
+        {
+            switch (kind) {
+                case Kind::BIT_VECTOR:
+                    return static_cast<BitVectorSetFact<E>&>(*this).removeIf(filter);
+                case Kind::SPARSE_BIT_VECTOR:
+                    return static_cast<SparseBitVectorSetFact<E>&>(*this).removeIf(filter);
+                case Kind::PERSISTENT:
+                    return static_cast<PersistentSetFact<E>&>(*this).removeIf(filter);
+                default:
+                    return removeFromHashSetIf(filter);
             }
-            return set.size() != oldSize;
         }
 
         /**
@@ -78,6 +137,11 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool removeAll(const std::shared_ptr<SetFact<E>>& other)
         {
+            if (isHashSetWith(other) && set == other->set) {
+                bool changed = !set->empty();
+                clear();
+                return changed;
+            }
             return removeIf([&](const std::shared_ptr<E>& e) -> bool {
                return other->contains(e);
             });
@@ -90,9 +154,28 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool unionN(const std::shared_ptr<SetFact<E>>& other)
         {
-            std::size_t oldSize = set.size();
-            set.insert(other->getSet().begin(), other->getSet().end());
-            return set.size() != oldSize;
+            if (isHashSetWith(other)) {
+                if (set == other->set) {
+                    return false;
+                }
+                if (set->empty()) {
+                    set = other->set;
+                    return !set->empty();
+                }
+                bool changed = false;
+                for (const std::shared_ptr<E>& e : *other->set) {
+                    if (!contains(e)) {
+                        mutableSet().emplace(e);
+                        changed = true;
+                    }
+                }
+                return changed;
+            }
+            bool changed = false;
+            other->forEach([&](const std::shared_ptr<E>& e) {
+                changed |= add(e);
+            });
+            return changed;
         }
 
         /**
@@ -103,11 +186,9 @@ namespace analyzer::analysis::dataflow::fact {
         [[nodiscard]] virtual std::shared_ptr<SetFact<E>>
             unionWith(const std::shared_ptr<SetFact<E>>& other) const
         {
-            std::unordered_set<std::shared_ptr<E>> result;
-            std::set_union(set.begin(), set.end(),
-                           other->getSet().begin(), other->getSet().end(),
-                           std::inserter(result, result.begin()));
-            return std::make_shared<SetFact<E>>(std::move(result));
+            std::shared_ptr<SetFact<E>> result = copy();
+            result->unionN(other);
+            return result;
         }
 
         /**
@@ -117,6 +198,9 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual bool intersect(const std::shared_ptr<SetFact<E>>& other)
         {
+            if (isHashSetWith(other) && set == other->set) {
+                return false;
+            }
             return removeIf([&] (const std::shared_ptr<E>& e) -> bool {
                 return !other->contains(e);
             });
@@ -130,11 +214,9 @@ namespace analyzer::analysis::dataflow::fact {
         [[nodiscard]] virtual std::shared_ptr<SetFact<E>>
             intersectWith(const std::shared_ptr<SetFact<E>>& other) const
         {
-            std::unordered_set<std::shared_ptr<E>> result;
-            std::set_intersection(set.begin(), set.end(),
-                           other->getSet().begin(), other->getSet().end(),
-                           std::inserter(result, result.begin()));
-            return std::make_shared<SetFact<E>>(std::move(result));
+            std::shared_ptr<SetFact<E>> result = copy();
+            result->intersect(other);
+            return result;
         }
 
         /**
@@ -143,16 +225,26 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual void setSetFact(const std::shared_ptr<SetFact<E>>& other)
         {
-            set = other->getSet();
+            if (isHashSetWith(other)) {
+                set = other->set;
+                return;
+            }
+            if (other.get() == this) {
+                return;
+            }
+            clear();
+            other->forEach([&](const std::shared_ptr<E>& e) {
+                add(e);
+            });
         }
 
         /**
-         * @brief creates and returns
+         * @brief creates and returns a copy sharing the hash set of this fact until either is mutated
          * @return a copy of this fact
          */
         [[nodiscard]] std::shared_ptr<SetFact<E>> copy() const override
         {
-            return std::make_shared<SetFact<E>>(set);
+            return std::make_shared<SetFact<E>>(*this);
         }
 
         /**
@@ -160,7 +252,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual void clear()
         {
-            set.clear();
+            set = emptySet();
         }
 
         /**
@@ -168,7 +260,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual bool isEmpty() const
         {
-            return set.empty();
+            return set->empty();
         }
 
         /**
@@ -176,7 +268,7 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual std::size_t size() const
         {
-            return set.size();
+            return set->size();
         }
 
         /**
@@ -186,7 +278,17 @@ namespace analyzer::analysis::dataflow::fact {
          */
         [[nodiscard]] virtual bool equalsTo(const std::shared_ptr<SetFact<E>>& other) const
         {
-            return set == other->getSet();
+            if (isHashSetWith(other)) {
+                return set == other->set || *set == *other->set;
+            }
+            if (size() != other->size()) {
+                return false;
+            }
+            bool equal = true;
+            other->forEach([&](const std::shared_ptr<E>& e) {
+                equal = equal && contains(e);
+            });
+            return equal;
         }
 
         /**
@@ -195,8 +297,30 @@ namespace analyzer::analysis::dataflow::fact {
          */
         virtual void forEach(std::function<void(std::shared_ptr<E>)> processor)
         {
-            for (std::shared_ptr<E> e : set) {
-                processor(e);
+            forEachInHashSet(processor);
+        }
+
+        /**
+         * @brief call processor for each elements in this set fact, calling it directly in the
+         * templated forEach of the representation of this fact
+         * @tparam F type of a callable taking const std::shared_ptr<E>&
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            switch (kind) {
+                case Kind::BIT_VECTOR:
+                    static_cast<BitVectorSetFact<E>&>(*this).forEach(processor);
+                    return;
+                case Kind::SPARSE_BIT_VECTOR:
+                    static_cast<SparseBitVectorSetFact<E>&>(*this).forEach(processor);
+                    return;
+                case Kind::PERSISTENT:
+                    static_cast<PersistentSetFact<E>&>(*this).forEach(processor);
+                    return;
+                default:
+                    forEachInHashSet(processor);
             }
         }
 
@@ -205,7 +329,7 @@ namespace analyzer::analysis::dataflow::fact {
          * @param set
          */
         explicit SetFact(std::unordered_set<std::shared_ptr<E>> set)
-            :set(std::move(set))
+            :kind(Kind::HASH_SET), set(std::make_shared<Set>(std::move(set)))
         {
 
         }
@@ -214,26 +338,106 @@ namespace analyzer::analysis::dataflow::fact {
          * @brief Construct an empty set
          */
         SetFact()
-            : SetFact(std::unordered_set<std::shared_ptr<E>>{})
+            :kind(Kind::HASH_SET), set(emptySet())
+        {
+
+        }
+
+        virtual ~SetFact() = default;
+
+    protected:
+
+        /**
+         * @brief Construct an empty set of a subclass kind
+         * @param kind the representation of the subclass
+         */
+        explicit SetFact(Kind kind)
+            :kind(kind), set(emptySet())
         {
 
         }
 
+        /**
+         * @param other another set fact
+         * @return true if both this and other keep their elements in the inner hash set
+         */
+        [[nodiscard]] bool isHashSetWith(const std::shared_ptr<SetFact<E>>& other) const
+        {
+            return kind == Kind::HASH_SET && other->kind == Kind::HASH_SET;
+        }
+
     private:
 
+        using Set = std::unordered_set<std::shared_ptr<E>>; ///< the hash set type
+
+        /**
+         * @return the hash set shared by all empty hash set facts, never mutated
+         */
+        static const std::shared_ptr<Set>& emptySet()
+        {
+            static const std::shared_ptr<Set> empty = std::make_shared<Set>();
+            return empty;
+        }
+
         /**
-         * @return a const reference to the inner set
+         * @param filter a predicate for elements to be removed from the hash set
+         * @return true if any elements were removed as a result of the call, otherwise false.
          */
-        const std::unordered_set<std::shared_ptr<E>>& getSet() const
+        template <typename F>
+        bool removeFromHashSetIf(F& filter)
         {
-            return set;
+            std::vector<std::shared_ptr<E>> toRemove;
+            for (const std::shared_ptr<E>& e : *set) {
+                if (filter(e)) {
+                    toRemove.emplace_back(e);
+                }
+            }
+            if (toRemove.empty()) {
+                return false;
+            }
+            Set& s = mutableSet();
+            for (const std::shared_ptr<E>& e : toRemove) {
+                s.erase(e);
+            }
+            return true;
         }
 
-        std::unordered_set<std::shared_ptr<E>> set; ///< the inner set of this dataflow fact
+        /**
+         * @param processor a processor function to process each element of the hash set
+         */
+        template <typename F>
+        void forEachInHashSet(F& processor)
+        {
+            // hold the hash set, so that a processor mutating this fact clones it instead
+            std::shared_ptr<const Set> current = set;
+            for (const std::shared_ptr<E>& e : *current) {
+                processor(e);
+            }
+        }
+
+        /**
+         * @brief clones the hash set of this fact if it is shared with any other fact
+         * @return the hash set of this fact, owned by this fact only
+         */
+        Set& mutableSet()
+        {
+            if (set.use_count() > 1) {
+                set = std::make_shared<Set>(*set);
+            }
+            return *set;
+        }
+
+        Kind kind; ///< the representation of this set fact
+
+        std::shared_ptr<Set> set; ///< the inner set of this dataflow fact, shared copy-on-write, unused by subclasses
 
     };
 
 } // fact
 
+// the representations the templated methods of SetFact dispatch to
+#include "analysis/dataflow/fact/BitVectorSetFact.h"
+#include "analysis/dataflow/fact/PersistentSetFact.h"
+#include "analysis/dataflow/fact/SparseBitVectorSetFact.h"
 
 #endif //STATIC_ANALYZER_SETFACT_H
@@ -0,0 +1,106 @@
+#ifndef STATIC_ANALYZER_SETFACTBUILDER_H
+#define STATIC_ANALYZER_SETFACTBUILDER_H
+
+#include <stdexcept>
+#include <string>
+
+#include "analysis/dataflow/fact/BitVectorSetFact.h"
+#include "analysis/dataflow/fact/PersistentSetFact.h"
+#include "analysis/dataflow/fact/SparseBitVectorSetFact.h"
+#include "World.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class SetFactBuilder
+     * @brief creates the set facts of one analysis run in the representation chosen by an option
+     *
+     * The option values are "hash-set" (also the empty value), "bit-vector", "sparse-bit-vector",
+     * "persistent" and "auto". "auto" picks a dense bit vector for universes smaller than
+     * SPARSE_THRESHOLD elements, and a sparse one otherwise, where most program points hold only a
+     * small part of the universe and a dense bit vector per fact would waste memory.
+     *
+     * @tparam E elements type, providing std::size_t getIndex() const
+     */
+    template <typename E>
+    class SetFactBuilder final {
+    public:
+
+        using Universe = typename BitVectorSetFact<E>::Universe; ///< all elements, indexed by getIndex()
+
+        static constexpr std::size_t SPARSE_THRESHOLD = 4096; ///< the smallest universe made sparse by "auto"
+
+        /**
+         * @param option the representation option, see the class comment
+         * @param universe all elements that may be in the facts, each at the position of its index
+         * @throw std::runtime_error if option is unknown
+         */
+        SetFactBuilder(const std::string& option, std::shared_ptr<const Universe> universe)
+            :kind(parseKind(option, universe->size())), universe(std::move(universe))
+        {
+
+        }
+
+        /**
+         * @return a new empty set fact
+         */
+        [[nodiscard]] std::shared_ptr<SetFact<E>> newSetFact() const
+        {
+            switch (kind) {
+                case SetFact<E>::Kind::BIT_VECTOR:
+                    return std::make_shared<BitVectorSetFact<E>>(universe);
+                case SetFact<E>::Kind::SPARSE_BIT_VECTOR:
+                    return std::make_shared<SparseBitVectorSetFact<E>>(universe);
+                case SetFact<E>::Kind::PERSISTENT:
+                    return std::make_shared<PersistentSetFact<E>>();
+                default:
+                    return std::make_shared<SetFact<E>>();
+            }
+        }
+
+        /**
+         * @return the representation of the facts created by this builder
+         */
+        [[nodiscard]] typename SetFact<E>::Kind getKind() const
+        {
+            return kind;
+        }
+
+    private:
+
+        /**
+         * @param option the representation option
+         * @param universeSize the number of elements in the universe
+         * @return the representation chosen by the option for the universe
+         */
+        static typename SetFact<E>::Kind parseKind(const std::string& option, std::size_t universeSize)
+        {
+            if (option.empty() || option == "hash-set") {
+                return SetFact<E>::Kind::HASH_SET;
+            }
+            if (option == "bit-vector") {
+                return SetFact<E>::Kind::BIT_VECTOR;
+            }
+            if (option == "sparse-bit-vector") {
+                return SetFact<E>::Kind::SPARSE_BIT_VECTOR;
+            }
+            if (option == "persistent") {
+                return SetFact<E>::Kind::PERSISTENT;
+            }
+            if (option == "auto") {
+                return universeSize < SPARSE_THRESHOLD ?
+                    SetFact<E>::Kind::BIT_VECTOR : SetFact<E>::Kind::SPARSE_BIT_VECTOR;
+            }
+            World::getLogger().Error("Unknown set fact representation: " + option);
+            throw std::runtime_error("Unknown set fact representation: " + option);
+        }
+
+        typename SetFact<E>::Kind kind; ///< the representation of the created facts
+
+        std::shared_ptr<const Universe> universe; ///< all elements that may be in the created facts
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_SETFACTBUILDER_H
@@ -0,0 +1,241 @@
+#ifndef STATIC_ANALYZER_SPARSEBITVECTORSETFACT_H
+#define STATIC_ANALYZER_SPARSEBITVECTORSETFACT_H
+
+#include <stdexcept>
+#include <vector>
+
+#include <llvm/ADT/SparseBitVector.h>
+
+#include "analysis/dataflow/fact/BitVectorSetFact.h"
+#include "World.h"
+
+namespace analyzer::analysis::dataflow::fact {
+
+    /**
+     * @class SparseBitVectorSetFact
+     * @brief set-like data-flow facts stored as a sparse bit vector over a fixed universe of elements
+     *
+     * The bits are kept in a sorted list of 128-bit chunks holding at least one element
+     * (llvm::SparseBitVector), so the memory of a fact grows with its elements rather than with
+     * the universe. Facts over the same universe object are combined by merging their chunk lists.
+     * Combining with any other set fact falls back to the per-element methods.
+     *
+     * @tparam E elements type, providing std::size_t getIndex() const
+     */
+    template <typename E>
+    class SparseBitVectorSetFact final: public SetFact<E> {
+    public:
+
+        using Universe = typename BitVectorSetFact<E>::Universe; ///< all elements, indexed by getIndex()
+
+        [[nodiscard]] bool contains(const std::shared_ptr<E>& e) const override
+        {
+            std::size_t index = e->getIndex();
+            return index < universe->size() && bits.test(index) && (*universe)[index] == e;
+        }
+
+        bool add(const std::shared_ptr<E>& e) override
+        {
+            return bits.test_and_set(indexOf(e));
+        }
+
+        bool remove(const std::shared_ptr<E>& e) override
+        {
+            if (!contains(e)) {
+                return false;
+            }
+            bits.reset(e->getIndex());
+            return true;
+        }
+
+        bool removeIf(std::function<bool(const std::shared_ptr<E>&)> filter) override
+        {
+            return removeElementsIf(filter);
+        }
+
+        /**
+         * @brief Removes all the elements of this fact that satisfy the given predicate, calling it directly.
+         * @tparam F type of a callable taking const std::shared_ptr<E>& and returning bool
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeIf(F&& filter)
+        {
+            return removeElementsIf(filter);
+        }
+
+        bool removeAll(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const SparseBitVectorSetFact<E>* o = sameUniverse(other)) {
+                return bits.intersectWithComplement(o->bits);
+            }
+            return SetFact<E>::removeAll(other);
+        }
+
+        bool unionN(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const SparseBitVectorSetFact<E>* o = sameUniverse(other)) {
+                return bits |= o->bits;
+            }
+            return SetFact<E>::unionN(other);
+        }
+
+        bool intersect(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const SparseBitVectorSetFact<E>* o = sameUniverse(other)) {
+                return bits &= o->bits;
+            }
+            return SetFact<E>::intersect(other);
+        }
+
+        void setSetFact(const std::shared_ptr<SetFact<E>>& other) override
+        {
+            if (const SparseBitVectorSetFact<E>* o = sameUniverse(other)) {
+                bits = o->bits;
+                return;
+            }
+            SetFact<E>::setSetFact(other);
+        }
+
+        [[nodiscard]] std::shared_ptr<SetFact<E>> copy() const override
+        {
+            return std::make_shared<SparseBitVectorSetFact<E>>(*this);
+        }
+
+        void clear() override
+        {
+            bits.clear();
+        }
+
+        [[nodiscard]] bool isEmpty() const override
+        {
+            return bits.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return bits.count();
+        }
+
+        [[nodiscard]] bool equalsTo(const std::shared_ptr<SetFact<E>>& other) const override
+        {
+            if (const SparseBitVectorSetFact<E>* o = sameUniverse(other)) {
+                return bits == o->bits;
+            }
+            return SetFact<E>::equalsTo(other);
+        }
+
+        void forEach(std::function<void(std::shared_ptr<E>)> processor) override
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @brief call processor for each elements in this set fact, calling it directly
+         * @tparam F type of a callable taking const std::shared_ptr<E>&
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEach(F&& processor)
+        {
+            forEachElement(processor);
+        }
+
+        /**
+         * @return the universe of this fact
+         */
+        [[nodiscard]] const std::shared_ptr<const Universe>& getUniverse() const
+        {
+            return universe;
+        }
+
+        /**
+         * @param fact a set fact
+         * @return true if fact is a sparse bit vector set fact, for llvm::isa and llvm::dyn_cast
+         */
+        static bool classof(const SetFact<E>* fact)
+        {
+            return fact->getKind() == SetFact<E>::Kind::SPARSE_BIT_VECTOR;
+        }
+
+        /**
+         * @brief Construct an empty set over a universe
+         * @param universe all elements that may be added, each at the position of its index
+         */
+        explicit SparseBitVectorSetFact(std::shared_ptr<const Universe> universe)
+            :SetFact<E>(SetFact<E>::Kind::SPARSE_BIT_VECTOR), universe(std::move(universe))
+        {
+
+        }
+
+    private:
+
+        /**
+         * @param filter a predicate for elements to be removed
+         * @return true if any elements were removed as a result of the call, otherwise false.
+         */
+        template <typename F>
+        bool removeElementsIf(F& filter)
+        {
+            // resetting a bit may free its chunk, so do not reset while iterating
+            std::vector<unsigned> toRemove;
+            for (unsigned index : bits) {
+                if (filter((*universe)[index])) {
+                    toRemove.emplace_back(index);
+                }
+            }
+            for (unsigned index : toRemove) {
+                bits.reset(index);
+            }
+            return !toRemove.empty();
+        }
+
+        /**
+         * @param processor a processor function to process each element
+         */
+        template <typename F>
+        void forEachElement(F& processor)
+        {
+            for (unsigned index : bits) {
+                processor((*universe)[index]);
+            }
+        }
+
+        /**
+         * @param e an element
+         * @return the index of e in the universe
+         * @throw std::runtime_error if e is not in the universe
+         */
+        [[nodiscard]] unsigned indexOf(const std::shared_ptr<E>& e) const
+        {
+            std::size_t index = e->getIndex();
+            if (index >= universe->size() || (*universe)[index] != e) {
+                World::getLogger().Error("Element is not in the universe of the sparse bit vector set fact");
+                throw std::runtime_error("Element is not in the universe of the sparse bit vector set fact");
+            }
+            return static_cast<unsigned>(index);
+        }
+
+        /**
+         * @param other another set fact
+         * @return other as a sparse bit vector set fact if it shares the universe of this, otherwise nullptr
+         */
+        [[nodiscard]] const SparseBitVectorSetFact<E>* sameUniverse(const std::shared_ptr<SetFact<E>>& other) const
+        {
+            if (!classof(other.get())) {
+                return nullptr;
+            }
+            const auto* o = static_cast<const SparseBitVectorSetFact<E>*>(other.get());
+            return o->universe == universe ? o : nullptr;
+        }
+
+        std::shared_ptr<const Universe> universe; ///< all elements that may be in this fact
+
+        llvm::SparseBitVector<128> bits; ///< bit i is set iff the i-th element of the universe is in this fact
+
+    };
+
+} // fact
+
+#endif //STATIC_ANALYZER_SPARSEBITVECTORSETFACT_H
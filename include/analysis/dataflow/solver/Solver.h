@@ -1,11 +1,16 @@
 #ifndef STATIC_ANALYZER_SOLVER_H
 #define STATIC_ANALYZER_SOLVER_H
 
+#include <algorithm>
 #include <memory>
 #include <queue>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "analysis/dataflow/fact/DataflowResult.h"
 #include "analysis/dataflow/DataflowAnalysis.h"
+#include "analysis/graph/WeakTopologicalOrder.h"
 
 namespace analyzer::analysis::dataflow::solver {
 
@@ -26,6 +31,11 @@ namespace analyzer::analysis::dataflow::solver {
         [[nodiscard]] virtual std::shared_ptr<fact::DataflowResult<Fact>>
             solve(const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis) const = 0;
 
+        /**
+         * @return the number of node transfers done by the last call of solve
+         */
+        [[nodiscard]] virtual std::size_t getVisitNum() const = 0;
+
         virtual ~Solver() = default;
 
     };
@@ -45,10 +55,17 @@ namespace analyzer::analysis::dataflow::solver {
             World::getLogger().Info("Initializing dataflow facts ...");
             std::shared_ptr<fact::DataflowResult<Fact>> result = initialize(dataflowAnalysis);
             World::getLogger().Info("Doing the solving ...");
+            visitNum = 0;
             doSolve(dataflowAnalysis, result);
+            World::getLogger().Info("Solved in " + std::to_string(visitNum) + " node visits");
             return result;
         }
 
+        [[nodiscard]] std::size_t getVisitNum() const override
+        {
+            return visitNum;
+        }
+
     protected:
 
         /**
@@ -113,6 +130,23 @@ namespace analyzer::analysis::dataflow::solver {
                 const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
                 std::shared_ptr<fact::DataflowResult<Fact>> result) const = 0;
 
+        /**
+         * @brief counts a node transfer of the current solving
+         */
+        void countVisit() const
+        {
+            visitNum++;
+        }
+
+        /**
+         * @brief construct a solver
+         */
+        AbstractSolver()
+            :visitNum(0)
+        {
+
+        }
+
     private:
 
         [[nodiscard]] std::shared_ptr<fact::DataflowResult<Fact>>
@@ -120,6 +154,7 @@ namespace analyzer::analysis::dataflow::solver {
         {
             std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
             std::shared_ptr<fact::DataflowResult<Fact>> result = dataflowAnalysis->getResult();
+            result->reserve(cfg->getNodeNum());
             if (dataflowAnalysis->isForward()) {
                 this->initializeForward(dataflowAnalysis, result);
             } else {
@@ -138,6 +173,8 @@ namespace analyzer::analysis::dataflow::solver {
             }
         }
 
+        mutable std::size_t visitNum; ///< the number of node transfers of the last solving
+
     };
 
     /**
@@ -153,26 +190,28 @@ namespace analyzer::analysis::dataflow::solver {
                 const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
                 std::shared_ptr<fact::DataflowResult<Fact>> result) const override
         {
-            std::queue<std::shared_ptr<ir::Stmt>> workList;
+            std::queue<std::size_t> workList;
             std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
-            workList.push(cfg->getEntry());
-            for (std::shared_ptr<ir::Stmt>& s : cfg->getIR()->getStmts()) {
-                workList.push(s);
+            // nodes are numbered in reverse postorder, so seed the work list in that order
+            for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+                workList.push(i);
             }
-            workList.push(cfg->getExit());
+            std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
             while (!workList.empty()) {
-                std::shared_ptr<ir::Stmt> stmt = workList.front();
+                std::size_t index = workList.front();
                 workList.pop();
-                if (stmt == cfg->getEntry()) {
+                if (index == entry) {
                     continue;
                 }
-                for (const std::shared_ptr<ir::Stmt>& pred : cfg->getPredsOf(stmt)) {
-                    dataflowAnalysis->meetInto(result->getOutFact(pred),
-                                               result->getInFact(stmt));
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                for (std::size_t pred : cfg->getPredIndicesOf(index)) {
+                    dataflowAnalysis->meetInto(result->findOutFact(*cfg->getNode(pred)),
+                                               result->findInFact(*stmt));
                 }
+                this->countVisit();
                 if (dataflowAnalysis->transferNode(stmt,
-                    result->getInFact(stmt), result->getOutFact(stmt))) {
-                    for (const std::shared_ptr<ir::Stmt>& succ : cfg->getSuccsOf(stmt)) {
+                    result->findInFact(*stmt), result->findOutFact(*stmt))) {
+                    for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
                         workList.push(succ);
                     }
                 }
@@ -183,26 +222,28 @@ namespace analyzer::analysis::dataflow::solver {
                 const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
                 std::shared_ptr<fact::DataflowResult<Fact>> result) const override
         {
-            std::queue<std::shared_ptr<ir::Stmt>> workList;
+            std::queue<std::size_t> workList;
             std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
-            workList.push(cfg->getExit());
-            for (std::shared_ptr<ir::Stmt>& s: cfg->getIR()->getStmts()) {
-                workList.push(s);
+            // the reverse of the node numbering is a postorder of the cfg
+            for (std::size_t i = cfg->getNodeNum(); i > 0; i--) {
+                workList.push(i - 1);
             }
-            workList.push(cfg->getEntry());
+            std::size_t exit = cfg->getNodeIndex(cfg->getExit());
             while (!workList.empty()) {
-                std::shared_ptr<ir::Stmt> stmt = workList.front();
+                std::size_t index = workList.front();
                 workList.pop();
-                if (stmt == cfg->getExit()) {
+                if (index == exit) {
                     continue;
                 }
-                for (const std::shared_ptr<ir::Stmt>& succ : cfg->getSuccsOf(stmt)) {
-                    dataflowAnalysis->meetInto(result->getInFact(succ),
-                                               result->getOutFact(stmt));
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
+                    dataflowAnalysis->meetInto(result->findInFact(*cfg->getNode(succ)),
+                                               result->findOutFact(*stmt));
                 }
+                this->countVisit();
                 if (dataflowAnalysis->transferNode(stmt,
-                    result->getInFact(stmt), result->getOutFact(stmt))) {
-                    for (const std::shared_ptr<ir::Stmt>& pred : cfg->getPredsOf(stmt)) {
+                    result->findInFact(*stmt), result->findOutFact(*stmt))) {
+                    for (std::size_t pred : cfg->getPredIndicesOf(index)) {
                         workList.push(pred);
                     }
                 }
@@ -211,14 +252,511 @@ namespace analyzer::analysis::dataflow::solver {
 
     };
 
+    /**
+     * @class PriorityWorkListSolver
+     * @brief a work-list solver visiting the queued nodes in reverse postorder (postorder for
+     * backward analyses), each node queued at most once
+     *
+     * The nodes of a cfg are numbered in reverse postorder, so the work list is a heap of node
+     * indices, and a bit per node marks the queued ones. A node is visited after all of its
+     * queued predecessors (successors), except along back edges, so an acyclic region is solved
+     * in one pass and an inner loop is iterated before the nodes after it are visited again.
+     *
+     * @tparam Fact type of dataflow fact
+     */
+    template <typename Fact>
+    class PriorityWorkListSolver: public AbstractSolver<Fact> {
+    protected:
+
+        void doSolveForward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            PriorityWorkList workList(cfg->getNodeNum(), true);
+            std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+            while (!workList.empty()) {
+                std::size_t index = workList.pop();
+                if (index == entry) {
+                    continue;
+                }
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                for (std::size_t pred : cfg->getPredIndicesOf(index)) {
+                    dataflowAnalysis->meetInto(result->findOutFact(*cfg->getNode(pred)),
+                                               result->findInFact(*stmt));
+                }
+                this->countVisit();
+                if (dataflowAnalysis->transferNode(stmt,
+                    result->findInFact(*stmt), result->findOutFact(*stmt))) {
+                    for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
+                        workList.push(succ);
+                    }
+                }
+            }
+        }
+
+        void doSolveBackward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            PriorityWorkList workList(cfg->getNodeNum(), false);
+            std::size_t exit = cfg->getNodeIndex(cfg->getExit());
+            while (!workList.empty()) {
+                std::size_t index = workList.pop();
+                if (index == exit) {
+                    continue;
+                }
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
+                    dataflowAnalysis->meetInto(result->findInFact(*cfg->getNode(succ)),
+                                               result->findOutFact(*stmt));
+                }
+                this->countVisit();
+                if (dataflowAnalysis->transferNode(stmt,
+                    result->findInFact(*stmt), result->findOutFact(*stmt))) {
+                    for (std::size_t pred : cfg->getPredIndicesOf(index)) {
+                        workList.push(pred);
+                    }
+                }
+            }
+        }
+
+    private:
+
+        /**
+         * @class PriorityWorkList
+         * @brief a work list of node indices, popping the smallest (largest) index first,
+         * and ignoring the nodes already queued
+         */
+        class PriorityWorkList {
+        public:
+
+            /**
+             * @brief queues a node unless it is queued already
+             * @param index the index of the node
+             */
+            void push(std::size_t index)
+            {
+                if (queued[index]) {
+                    return;
+                }
+                queued[index] = true;
+                heap.emplace_back(index);
+                std::push_heap(heap.begin(), heap.end(), Later{ascending});
+            }
+
+            /**
+             * @return the first queued node, removed from the work list
+             */
+            std::size_t pop()
+            {
+                std::pop_heap(heap.begin(), heap.end(), Later{ascending});
+                std::size_t index = heap.back();
+                heap.pop_back();
+                queued[index] = false;
+                return index;
+            }
+
+            /**
+             * @return true if no node is queued, otherwise false
+             */
+            [[nodiscard]] bool empty() const
+            {
+                return heap.empty();
+            }
+
+            /**
+             * @brief Creates a work list with every node queued.
+             * @param nodeNum the number of nodes in the cfg
+             * @param ascending true to pop the smallest index first, false to pop the largest first
+             */
+            PriorityWorkList(std::size_t nodeNum, bool ascending)
+                :ascending(ascending), queued(nodeNum, true), heap(nodeNum)
+            {
+                // the indices in popping order already form a heap
+                for (std::size_t i = 0; i < nodeNum; i++) {
+                    heap[i] = ascending ? i : nodeNum - 1 - i;
+                }
+            }
+
+        private:
+
+            /**
+             * @struct Later
+             * @brief the heap order, true if a is popped after b
+             */
+            struct Later {
+                bool ascending; ///< whether smaller indices are popped first
+
+                bool operator()(std::size_t a, std::size_t b) const
+                {
+                    return ascending ? a > b : a < b;
+                }
+            };
+
+            bool ascending; ///< whether smaller indices are popped first
+
+            std::vector<bool> queued; ///< whether each node is queued
+
+            std::vector<std::size_t> heap; ///< the queued nodes, a heap in popping order
+
+        };
+
+    };
+
+    /**
+     * @class DeltaWorkListSolver
+     * @brief a work-list solver propagating only the facts newly added to each node (difference propagation)
+     *
+     * After one full transfer of every node, a node is revisited only for the facts newly flowing
+     * into it, which are met into its in (out) fact and transferred by transferNodeDelta, and only
+     * the facts that this adds to its out (in) fact flow on to its successors (predecessors).
+     * The analysis must support delta transfer, see DataflowAnalysis::supportsDeltaTransfer.
+     *
+     * @tparam Fact type of dataflow fact
+     */
+    template <typename Fact>
+    class DeltaWorkListSolver: public AbstractSolver<Fact> {
+    protected:
+
+        void doSolveForward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+            DeltaWorkList workList(dataflowAnalysis, cfg->getNodeNum());
+            // the first visit of each node transfers its whole in fact, and sends its whole out fact
+            for (std::size_t index = 0; index < cfg->getNodeNum(); index++) {
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                if (index != entry) {
+                    this->countVisit();
+                    (void) dataflowAnalysis->transferNode(stmt, result->findInFact(*stmt), result->findOutFact(*stmt));
+                }
+                for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
+                    workList.send(result->findOutFact(*stmt), succ);
+                }
+            }
+            while (!workList.empty()) {
+                auto [index, delta] = workList.pop();
+                if (index == entry) {
+                    continue;
+                }
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                dataflowAnalysis->meetInto(delta, result->findInFact(*stmt));
+                this->countVisit();
+                std::shared_ptr<Fact> outDelta = dataflowAnalysis->transferNodeDelta(stmt, delta,
+                    result->findInFact(*stmt), result->findOutFact(*stmt));
+                if (!outDelta->isEmpty()) {
+                    for (std::size_t succ : cfg->getSuccIndicesOf(index)) {
+                        workList.send(outDelta, succ);
+                    }
+                }
+            }
+        }
+
+        void doSolveBackward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            std::size_t exit = cfg->getNodeIndex(cfg->getExit());
+            DeltaWorkList workList(dataflowAnalysis, cfg->getNodeNum());
+            // the first visit of each node transfers its whole out fact, and sends its whole in fact
+            for (std::size_t i = cfg->getNodeNum(); i > 0; i--) {
+                std::size_t index = i - 1;
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                if (index != exit) {
+                    this->countVisit();
+                    (void) dataflowAnalysis->transferNode(stmt, result->findInFact(*stmt), result->findOutFact(*stmt));
+                }
+                for (std::size_t pred : cfg->getPredIndicesOf(index)) {
+                    workList.send(result->findInFact(*stmt), pred);
+                }
+            }
+            while (!workList.empty()) {
+                auto [index, delta] = workList.pop();
+                if (index == exit) {
+                    continue;
+                }
+                const std::shared_ptr<ir::Stmt>& stmt = cfg->getNode(index);
+                dataflowAnalysis->meetInto(delta, result->findOutFact(*stmt));
+                this->countVisit();
+                std::shared_ptr<Fact> inDelta = dataflowAnalysis->transferNodeDelta(stmt, delta,
+                    result->findInFact(*stmt), result->findOutFact(*stmt));
+                if (!inDelta->isEmpty()) {
+                    for (std::size_t pred : cfg->getPredIndicesOf(index)) {
+                        workList.send(inDelta, pred);
+                    }
+                }
+            }
+        }
+
+    private:
+
+        /**
+         * @class DeltaWorkList
+         * @brief a work list of nodes, each with the facts sent to it since its last visit
+         */
+        class DeltaWorkList {
+        public:
+
+            /**
+             * @param dataflowAnalysis the analysis creating and meeting the pending facts
+             * @param nodeNum the number of nodes in the cfg
+             */
+            DeltaWorkList(const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis, std::size_t nodeNum)
+                :dataflowAnalysis(dataflowAnalysis), pending(nodeNum)
+            {
+
+            }
+
+            /**
+             * @brief meets delta into the pending facts of a node, queueing the node if it is not queued
+             * @param delta facts flowing to the node
+             * @param index the index of the node
+             */
+            void send(const std::shared_ptr<Fact>& delta, std::size_t index)
+            {
+                if (!pending[index]) {
+                    pending[index] = dataflowAnalysis->newInitialFact();
+                    queue.push(index);
+                }
+                dataflowAnalysis->meetInto(delta, pending[index]);
+            }
+
+            /**
+             * @return the index of the first queued node and its pending facts, removing both
+             */
+            std::pair<std::size_t, std::shared_ptr<Fact>> pop()
+            {
+                std::size_t index = queue.front();
+                queue.pop();
+                return {index, std::move(pending[index])};
+            }
+
+            /**
+             * @return true if no node is queued, otherwise false
+             */
+            [[nodiscard]] bool empty() const
+            {
+                return queue.empty();
+            }
+
+        private:
+
+            const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis; ///< the analysis being solved
+
+            std::vector<std::shared_ptr<Fact>> pending; ///< facts sent to each node, nullptr if not queued
+
+            std::queue<std::size_t> queue; ///< the queued nodes
+
+        };
+
+    };
+
+    /**
+     * @class WTOSolver
+     * @brief a solver iterating the nested components of the weak topological order of the cfg
+     * (of the reversed cfg for backward analyses) by the recursive strategy of Bourdoncle
+     *
+     * The nodes are visited once in the order, except that a component is iterated until its
+     * head stabilizes, its nested components being stabilized in each iteration. Every cycle of
+     * the cfg passes through a head, so if the analysis supports widening (see
+     * DataflowAnalysis::supportsWidening), the facts of a head are widened from its second visit
+     * on, and narrowed by descending iterations once its component has stabilized. Otherwise
+     * the facts are only met, and the solver reaches the same fixed point as the work-list ones.
+     * The order is computed once per cfg and cached by it.
+     *
+     * @tparam Fact type of dataflow fact
+     */
+    template <typename Fact>
+    class WTOSolver: public AbstractSolver<Fact> {
+    protected:
+
+        void doSolveForward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            Iteration iteration{dataflowAnalysis, result, cfg, cfg->getWeakTopologicalOrder(),
+                cfg->getNodeIndex(cfg->getEntry()), true, dataflowAnalysis->supportsWidening()};
+            solveRange(iteration, 0, iteration.wto->getNodeNum());
+        }
+
+        void doSolveBackward(
+                const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis,
+                std::shared_ptr<fact::DataflowResult<Fact>> result) const override
+        {
+            std::shared_ptr<graph::CFG> cfg = dataflowAnalysis->getCFG();
+            Iteration iteration{dataflowAnalysis, result, cfg, cfg->getReverseWeakTopologicalOrder(),
+                cfg->getNodeIndex(cfg->getExit()), false, dataflowAnalysis->supportsWidening()};
+            solveRange(iteration, 0, iteration.wto->getNodeNum());
+        }
+
+    private:
+
+        /**
+         * @struct Iteration
+         * @brief the state of solving one analysis
+         */
+        struct Iteration {
+            const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis; ///< the analysis being solved
+            std::shared_ptr<fact::DataflowResult<Fact>> result; ///< the facts being solved
+            std::shared_ptr<graph::CFG> cfg; ///< the cfg of the analysis
+            std::shared_ptr<graph::WeakTopologicalOrder> wto; ///< the order in the direction of the analysis
+            std::size_t start; ///< the index of the entry (exit) node, never transferred
+            bool forward; ///< whether the analysis is forward
+            bool widening; ///< whether the analysis supports widening
+        };
+
+        /**
+         * @enum Update
+         * @brief how the facts flowing into a node update its in (out) fact
+         */
+        enum class Update {
+            MEET, ///< met into the fact
+            WIDEN, ///< met together, and widened into the fact
+            NARROW, ///< met together, and narrowed into the fact
+            REPLACE ///< met together, and replacing the fact
+        };
+
+        /**
+         * @brief solves the elements of the order in a range of positions, stabilizing each component
+         * @param iteration the state of the solving
+         * @param begin the first position
+         * @param end the position after the last one
+         */
+        void solveRange(const Iteration& iteration, std::size_t begin, std::size_t end) const
+        {
+            llvm::ArrayRef<std::size_t> order = iteration.wto->getOrder();
+            for (std::size_t position = begin; position < end; position = iteration.wto->getComponentEnd(position)) {
+                if (iteration.wto->isHead(order[position])) {
+                    solveComponent(iteration, position);
+                } else {
+                    (void) visit(iteration, order[position], Update::MEET);
+                }
+            }
+        }
+
+        /**
+         * @brief iterates a component until its head stabilizes, then narrows it if the analysis widens
+         * @param iteration the state of the solving
+         * @param position the position of the head of the component
+         */
+        void solveComponent(const Iteration& iteration, std::size_t position) const
+        {
+            std::size_t head = iteration.wto->getOrder()[position];
+            std::size_t end = iteration.wto->getComponentEnd(position);
+            (void) visit(iteration, head, Update::MEET);
+            do {
+                solveRange(iteration, position + 1, end);
+            } while (visit(iteration, head, iteration.widening ? Update::WIDEN : Update::MEET));
+            if (iteration.widening) {
+                while (visit(iteration, head, Update::NARROW)) {
+                    descendRange(iteration, position + 1, end);
+                }
+            }
+        }
+
+        /**
+         * @brief recomputes the facts in a range of positions once, narrowing the facts of the heads
+         * @param iteration the state of the solving
+         * @param begin the first position
+         * @param end the position after the last one
+         */
+        void descendRange(const Iteration& iteration, std::size_t begin, std::size_t end) const
+        {
+            llvm::ArrayRef<std::size_t> order = iteration.wto->getOrder();
+            for (std::size_t position = begin; position < end; position++) {
+                std::size_t index = order[position];
+                (void) visit(iteration, index, iteration.wto->isHead(index) ? Update::NARROW : Update::REPLACE);
+            }
+        }
+
+        /**
+         * @brief updates the in (out) fact of a node by the facts flowing into it, and transfers it
+         * @param iteration the state of the solving
+         * @param index the index of the node
+         * @param update how to update the in (out) fact
+         * @return true if the out (in) fact of the node changed, otherwise false
+         */
+        bool visit(const Iteration& iteration, std::size_t index, Update update) const
+        {
+            if (index == iteration.start) {
+                return false;
+            }
+            const std::unique_ptr<DataflowAnalysis<Fact>>& dataflowAnalysis = iteration.dataflowAnalysis;
+            const std::shared_ptr<fact::DataflowResult<Fact>>& result = iteration.result;
+            const std::shared_ptr<ir::Stmt>& stmt = iteration.cfg->getNode(index);
+            llvm::ArrayRef<std::size_t> sources = iteration.forward ?
+                iteration.cfg->getPredIndicesOf(index) : iteration.cfg->getSuccIndicesOf(index);
+            auto sourceFactOf = [&](std::size_t source) -> const std::shared_ptr<Fact>& {
+                const std::shared_ptr<ir::Stmt>& node = iteration.cfg->getNode(source);
+                return iteration.forward ? result->findOutFact(*node) : result->findInFact(*node);
+            };
+            if (update == Update::MEET) {
+                const std::shared_ptr<Fact>& target = iteration.forward ?
+                    result->findInFact(*stmt) : result->findOutFact(*stmt);
+                for (std::size_t source : sources) {
+                    dataflowAnalysis->meetInto(sourceFactOf(source), target);
+                }
+            } else {
+                std::shared_ptr<Fact> joined = dataflowAnalysis->newInitialFact();
+                for (std::size_t source : sources) {
+                    dataflowAnalysis->meetInto(sourceFactOf(source), joined);
+                }
+                if (update == Update::REPLACE) {
+                    if (iteration.forward) {
+                        result->setInFact(stmt, joined);
+                    } else {
+                        result->setOutFact(stmt, joined);
+                    }
+                } else {
+                    const std::shared_ptr<Fact>& target = iteration.forward ?
+                        result->findInFact(*stmt) : result->findOutFact(*stmt);
+                    if (update == Update::WIDEN) {
+                        dataflowAnalysis->widenInto(joined, target);
+                    } else {
+                        dataflowAnalysis->narrowInto(joined, target);
+                    }
+                }
+            }
+            this->countVisit();
+            return dataflowAnalysis->transferNode(stmt, result->findInFact(*stmt), result->findOutFact(*stmt));
+        }
+
+    };
+
     /**
      * @tparam Fact the dataflow fact
      * @brief factory method for obtaining a solver of a given dataflow fact
-     * @return a solver implemented by worklist
+     * @param option the solver option, "priority" (also the empty value), "worklist", "delta" or "wto"
+     * @param dataflowAnalysis the analysis to be solved, nullptr if unknown
+     * @return a solver iterating the weak topological order of the cfg for "wto", otherwise a solver
+     * implemented by worklist: visiting nodes in reverse postorder for "priority", in first-in-first-out
+     * order for "worklist", and propagating deltas if option is "delta" and the analysis supports
+     * delta transfer
+     * @throw std::runtime_error if option is unknown
      */
     template <typename Fact>
-    std::unique_ptr<Solver<Fact>> makeSolver() {
-        return std::make_unique<WorkListSolver<Fact>>();
+    std::unique_ptr<Solver<Fact>> makeSolver(const std::string& option = "",
+        const DataflowAnalysis<Fact>* dataflowAnalysis = nullptr) {
+        if (option == "delta") {
+            if (dataflowAnalysis != nullptr && dataflowAnalysis->supportsDeltaTransfer()) {
+                return std::make_unique<DeltaWorkListSolver<Fact>>();
+            }
+            World::getLogger().Warning("The analysis does not support delta propagation, using priority worklist solver.");
+        } else if (option == "worklist") {
+            return std::make_unique<WorkListSolver<Fact>>();
+        } else if (option == "wto") {
+            return std::make_unique<WTOSolver<Fact>>();
+        } else if (!option.empty() && option != "priority") {
+            World::getLogger().Error("Unknown dataflow solver: " + option);
+            throw std::runtime_error("Unknown dataflow solver: " + option);
+        }
+        return std::make_unique<PriorityWorkListSolver<Fact>>();
     }
 
 } // solver
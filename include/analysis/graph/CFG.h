@@ -4,6 +4,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
 
 namespace analyzer::ir {
     class IR;
@@ -12,6 +15,9 @@ namespace analyzer::ir {
 
 namespace analyzer::analysis::graph {
 
+    class DominatorTree;
+    class WeakTopologicalOrder;
+
     /**
      * @brief the interface for a CFG Edge
      * @class CFGEdge
@@ -116,6 +122,64 @@ namespace analyzer::analysis::graph {
          */
         [[nodiscard]] virtual std::size_t getEdgeNum() const = 0;
 
+        /**
+         * @return the number of nodes (including entry and exit) of this cfg
+         */
+        [[nodiscard]] virtual std::size_t getNodeNum() const = 0;
+
+        /**
+         * @return all nodes of this cfg in reverse postorder, the position of a node is its index
+         */
+        [[nodiscard]] virtual const std::vector<std::shared_ptr<ir::Stmt>>& getNodes() const = 0;
+
+        /**
+         * @brief get the node of a given index
+         * @param index a node index in [0, getNodeNum())
+         * @return the statement with the given index
+         */
+        [[nodiscard]] virtual const std::shared_ptr<ir::Stmt>& getNode(std::size_t index) const = 0;
+
+        /**
+         * @brief get the dense index of a given node
+         * @param stmt a statement (check by identity)
+         * @return the index of stmt, or getNodeNum() if stmt is not a node of this cfg
+         */
+        [[nodiscard]] virtual std::size_t getNodeIndex(const std::shared_ptr<ir::Stmt>& stmt) const = 0;
+
+        /**
+         * @brief get the predecessor indices of a given node without allocation
+         * @param index the index of a node
+         * @return a sorted and duplicate-free range of predecessor indices
+         */
+        [[nodiscard]] virtual llvm::ArrayRef<std::size_t> getPredIndicesOf(std::size_t index) const = 0;
+
+        /**
+         * @brief get the successor indices of a given node without allocation
+         * @param index the index of a node
+         * @return a sorted and duplicate-free range of successor indices
+         */
+        [[nodiscard]] virtual llvm::ArrayRef<std::size_t> getSuccIndicesOf(std::size_t index) const = 0;
+
+        /**
+         * @return the dominator tree of this cfg, computed on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<DominatorTree> getDominatorTree() const = 0;
+
+        /**
+         * @return the post-dominator tree of this cfg, computed on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<DominatorTree> getPostDominatorTree() const = 0;
+
+        /**
+         * @return the weak topological order of this cfg from entry, computed on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<WeakTopologicalOrder> getWeakTopologicalOrder() const = 0;
+
+        /**
+         * @return the weak topological order of the reversed cfg from exit, computed on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<WeakTopologicalOrder> getReverseWeakTopologicalOrder() const = 0;
+
         virtual ~CFG() = default;
     };
 
@@ -182,6 +246,26 @@ namespace analyzer::analysis::graph {
 
         [[nodiscard]] std::size_t getEdgeNum() const override;
 
+        [[nodiscard]] std::size_t getNodeNum() const override;
+
+        [[nodiscard]] const std::vector<std::shared_ptr<ir::Stmt>>& getNodes() const override;
+
+        [[nodiscard]] const std::shared_ptr<ir::Stmt>& getNode(std::size_t index) const override;
+
+        [[nodiscard]] std::size_t getNodeIndex(const std::shared_ptr<ir::Stmt>& stmt) const override;
+
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getPredIndicesOf(std::size_t index) const override;
+
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getSuccIndicesOf(std::size_t index) const override;
+
+        [[nodiscard]] std::shared_ptr<DominatorTree> getDominatorTree() const override;
+
+        [[nodiscard]] std::shared_ptr<DominatorTree> getPostDominatorTree() const override;
+
+        [[nodiscard]] std::shared_ptr<WeakTopologicalOrder> getWeakTopologicalOrder() const override;
+
+        [[nodiscard]] std::shared_ptr<WeakTopologicalOrder> getReverseWeakTopologicalOrder() const override;
+
         // the method below should not be called from user
 
         /**
@@ -208,6 +292,25 @@ namespace analyzer::analysis::graph {
          */
         void setExit(const std::shared_ptr<ir::Stmt>& exit);
 
+        /**
+         * @brief contract the empty nodes (nop statements other than entry and exit) that have a single
+         * successor or a single predecessor into their neighbours, must be called before freeze
+         *
+         * An empty node is kept if contracting it would create a self loop or a parallel edge,
+         * so every remaining edge still joins two distinct observable program points.
+         * @param[in,out] stmts all statements of this cfg except entry and exit, contracted nodes are removed
+         * @return the number of contracted nodes
+         */
+        std::size_t contractEmptyNodes(std::vector<std::shared_ptr<ir::Stmt>>& stmts);
+
+        /**
+         * @brief number the nodes in reverse postorder (unreachable nodes follow, exit comes last),
+         * record the numbers on the statements and freeze the edges into compressed sparse rows,
+         * no edge should be added after calling this
+         * @param stmts all statements of this cfg except entry and exit
+         */
+        void freeze(const std::vector<std::shared_ptr<ir::Stmt>>& stmts);
+
         /**
          * @brief construct an empty default cfg
          */
@@ -215,11 +318,25 @@ namespace analyzer::analysis::graph {
 
     private:
 
-        std::unordered_multimap<std::shared_ptr<ir::Stmt>, std::shared_ptr<CFGEdge>>
-            inEdges; ///< in edges of each statement
+        std::vector<std::shared_ptr<CFGEdge>> edges; ///< all edges in the order of insertion
+
+        std::vector<std::shared_ptr<ir::Stmt>> nodes; ///< all nodes in reverse postorder
+
+        std::vector<std::size_t> predOffsets; ///< row offsets of preds, of size getNodeNum() + 1
+
+        std::vector<std::size_t> preds; ///< sorted predecessor indices of each node
+
+        std::vector<std::size_t> succOffsets; ///< row offsets of succs, of size getNodeNum() + 1
+
+        std::vector<std::size_t> succs; ///< sorted successor indices of each node
 
-        std::unordered_multimap<std::shared_ptr<ir::Stmt>, std::shared_ptr<CFGEdge>>
-            outEdges; ///< out edges of each statement
+        std::vector<std::size_t> inEdgeOffsets; ///< row offsets of in edges, of size getNodeNum() + 1
+
+        std::vector<std::shared_ptr<CFGEdge>> inEdges; ///< in edges grouped by target index
+
+        std::vector<std::size_t> outEdgeOffsets; ///< row offsets of out edges, of size getNodeNum() + 1
+
+        std::vector<std::shared_ptr<CFGEdge>> outEdges; ///< out edges grouped by source index
 
         std::weak_ptr<ir::IR> myIR; ///< ir of this cfg
 
@@ -229,6 +346,14 @@ namespace analyzer::analysis::graph {
 
         std::size_t edgeNum; ///< number of edges in this cfg
 
+        mutable std::shared_ptr<DominatorTree> domTree; ///< cached dominator tree
+
+        mutable std::shared_ptr<DominatorTree> postDomTree; ///< cached post-dominator tree
+
+        mutable std::shared_ptr<WeakTopologicalOrder> wto; ///< cached weak topological order
+
+        mutable std::shared_ptr<WeakTopologicalOrder> reverseWTO; ///< cached weak topological order of the reversed cfg
+
     };
 
 } // graph
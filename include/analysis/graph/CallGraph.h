@@ -0,0 +1,128 @@
+#ifndef STATIC_ANALYZER_CALLGRAPH_H
+#define STATIC_ANALYZER_CALLGRAPH_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+namespace clang {
+    class Expr;
+}
+
+namespace analyzer::language {
+    class CPPMethod;
+}
+
+namespace analyzer::analysis::graph {
+
+    namespace lang = language;
+
+    /**
+     * @struct CallSite
+     * @brief a call or constructor call in a caller together with one of its resolved callees
+     */
+    struct CallSite {
+
+        const clang::Expr* callExpr; ///< the CallExpr or CXXConstructExpr in the body of the caller
+
+        std::size_t callee; ///< the method id of the callee
+
+    };
+
+    /**
+     * @class CallGraph
+     * @brief the whole-program call graph over the methods with a body
+     *
+     * Methods are identified by dense ids, assigned in the lexicographic order of their signatures.
+     * Direct calls and constructor calls are resolved by the signature of the called declaration, calls to
+     * functions without a body in the program (e.g. library functions) are dropped. Optionally,
+     * calls to virtual methods through an object are resolved by class hierarchy analysis to every
+     * overrider defined in the static receiver class or its subclasses. The call sites of the
+     * methods are collected in parallel and frozen into compressed sparse rows afterwards.
+     */
+    class CallGraph final {
+    public:
+
+        /**
+         * @brief build the call graph of a program
+         * @param allMethods all methods of the program, from signature to method (e.g. World::getAllMethods())
+         * @param resolveVirtualCalls whether to resolve virtual calls by class hierarchy analysis
+         * @param threadNum the number of worker threads, 0 for the hardware concurrency
+         */
+        explicit CallGraph(const std::unordered_map<std::string, std::shared_ptr<lang::CPPMethod>>& allMethods,
+                           bool resolveVirtualCalls = false, std::size_t threadNum = 0);
+
+        /**
+         * @return the number of methods in this call graph
+         */
+        [[nodiscard]] std::size_t getMethodNum() const;
+
+        /**
+         * @return the number of distinct caller-callee edges in this call graph
+         */
+        [[nodiscard]] std::size_t getEdgeNum() const;
+
+        /**
+         * @param id a method id
+         * @return the method with the given id
+         */
+        [[nodiscard]] const std::shared_ptr<lang::CPPMethod>& getMethod(std::size_t id) const;
+
+        /**
+         * @param method a method of the program
+         * @return the id of method, getMethodNum() if method is not in this call graph
+         */
+        [[nodiscard]] std::size_t getMethodId(const lang::CPPMethod& method) const;
+
+        /**
+         * @param id a method id
+         * @return the sorted ids of the methods called by the given method
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getCalleeIdsOf(std::size_t id) const;
+
+        /**
+         * @param id a method id
+         * @return the sorted ids of the methods calling the given method
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getCallerIdsOf(std::size_t id) const;
+
+        /**
+         * @param id a method id
+         * @return the resolved call sites in the given method, in source order,
+         * a virtual call site appears once for each of its callees
+         */
+        [[nodiscard]] llvm::ArrayRef<CallSite> getCallSitesOf(std::size_t id) const;
+
+        /**
+         * @param caller the id of the calling method
+         * @param callee the id of the called method
+         * @return true if caller calls callee
+         */
+        [[nodiscard]] bool hasEdge(std::size_t caller, std::size_t callee) const;
+
+    private:
+
+        std::vector<std::shared_ptr<lang::CPPMethod>> methods; ///< all methods, indexed by id
+
+        std::unordered_map<const lang::CPPMethod*, std::size_t> methodIds; ///< method -> id
+
+        std::vector<std::size_t> callSiteOffsets; ///< row offsets of call sites per caller
+
+        std::vector<CallSite> callSites; ///< call sites grouped by caller
+
+        std::vector<std::size_t> calleeOffsets; ///< row offsets of callees per caller
+
+        std::vector<std::size_t> callees; ///< sorted callee ids of each caller
+
+        std::vector<std::size_t> callerOffsets; ///< row offsets of callers per callee
+
+        std::vector<std::size_t> callers; ///< sorted caller ids of each callee
+
+    };
+
+} // graph
+
+#endif //STATIC_ANALYZER_CALLGRAPH_H
@@ -0,0 +1,175 @@
+#ifndef STATIC_ANALYZER_DOMINATORS_H
+#define STATIC_ANALYZER_DOMINATORS_H
+
+#include <memory>
+#include <vector>
+#include <unordered_set>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "analysis/graph/CFG.h"
+
+namespace analyzer::analysis::graph {
+
+    /**
+     * @class DominatorTree
+     * @brief the (post-)dominator tree of a cfg, together with its dominance frontiers
+     *
+     * The tree is computed by the iterative algorithm of Cooper, Harvey and Kennedy.
+     * Nodes are identified by their cfg node indices, nodes unreachable from the root
+     * (or, for post-dominators, that can not reach the exit) are not in the tree.
+     */
+    class DominatorTree final {
+    public:
+
+        /**
+         * @brief compute the dominator tree or the post-dominator tree of a cfg
+         * @param cfg a frozen cfg, which should outlive this tree
+         * @param isPostDom true for a post-dominator tree rooted at exit,
+         * false for a dominator tree rooted at entry
+         */
+        explicit DominatorTree(const CFG& cfg, bool isPostDom = false);
+
+        /**
+         * @return true if this is a post-dominator tree
+         */
+        [[nodiscard]] bool isPostDominatorTree() const;
+
+        /**
+         * @return the root of this tree, entry for dominators and exit for post-dominators
+         */
+        [[nodiscard]] std::shared_ptr<ir::Stmt> getRoot() const;
+
+        /**
+         * @param stmt a node of the cfg
+         * @return true if stmt is a node of this tree
+         */
+        [[nodiscard]] bool isReachable(const std::shared_ptr<ir::Stmt>& stmt) const;
+
+        /**
+         * @param stmt a node of the cfg
+         * @return the immediate (post-)dominator of stmt, nullptr for the root and unreachable nodes
+         */
+        [[nodiscard]] std::shared_ptr<ir::Stmt> getIDom(const std::shared_ptr<ir::Stmt>& stmt) const;
+
+        /**
+         * @param stmt a node of the cfg
+         * @return the nodes immediately (post-)dominated by stmt
+         */
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Stmt>>
+            getChildrenOf(const std::shared_ptr<ir::Stmt>& stmt) const;
+
+        /**
+         * @brief check dominance in constant time by dfs interval numbering of the tree
+         * @param a a node of the cfg
+         * @param b a node of the cfg
+         * @return true if a (post-)dominates b, every node of this tree dominates itself
+         */
+        [[nodiscard]] bool dominates(const std::shared_ptr<ir::Stmt>& a, const std::shared_ptr<ir::Stmt>& b) const;
+
+        /**
+         * @param a a node of the cfg
+         * @param b a node of the cfg
+         * @return true if a (post-)dominates b and a is not b
+         */
+        [[nodiscard]] bool strictlyDominates(const std::shared_ptr<ir::Stmt>& a,
+                                             const std::shared_ptr<ir::Stmt>& b) const;
+
+        /**
+         * @param stmt a node of the cfg
+         * @return the dominance frontier of stmt (the post-dominance frontier for post-dominators)
+         */
+        [[nodiscard]] std::unordered_set<std::shared_ptr<ir::Stmt>>
+            getDominanceFrontierOf(const std::shared_ptr<ir::Stmt>& stmt) const;
+
+        /**
+         * @return the number of cfg nodes, which is also the index of no node
+         */
+        [[nodiscard]] std::size_t getNodeNum() const;
+
+        /**
+         * @param index a node index
+         * @return the index of the immediate (post-)dominator, getNodeNum() for the root and unreachable nodes
+         */
+        [[nodiscard]] std::size_t getIDomIndex(std::size_t index) const;
+
+        /**
+         * @param index a node index
+         * @return the sorted indices of the nodes immediately (post-)dominated by the given node
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getChildIndicesOf(std::size_t index) const;
+
+        /**
+         * @param index a node index
+         * @return the sorted indices of the (post-)dominance frontier of the given node
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getFrontierIndicesOf(std::size_t index) const;
+
+        /**
+         * @param a a node index
+         * @param b a node index
+         * @return true if node a (post-)dominates node b
+         */
+        [[nodiscard]] bool dominates(std::size_t a, std::size_t b) const;
+
+        /**
+         * @return the reachable node indices in reverse postorder of the (reversed, for post-dominators) cfg
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getReversePostOrder() const;
+
+    private:
+
+        const CFG& cfg; ///< the cfg of this tree
+
+        bool isPostDom; ///< whether this is a post-dominator tree
+
+        std::size_t root; ///< index of the root
+
+        std::vector<std::size_t> idoms; ///< immediate dominator of each node, getNodeNum() if none
+
+        std::vector<std::size_t> rpo; ///< reachable nodes in reverse postorder
+
+        std::vector<std::size_t> childOffsets; ///< row offsets of tree children, of size getNodeNum() + 1
+
+        std::vector<std::size_t> children; ///< tree children of each node
+
+        std::vector<std::size_t> dfsIn; ///< preorder number of each node in the tree
+
+        std::vector<std::size_t> dfsOut; ///< postorder number of each node in the tree
+
+        std::vector<std::size_t> frontierOffsets; ///< row offsets of frontiers, of size getNodeNum() + 1
+
+        std::vector<std::size_t> frontiers; ///< sorted frontier of each node
+
+        /**
+         * @param index a node index
+         * @return the predecessors of the node in the direction of this tree
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> predsOf(std::size_t index) const;
+
+        /**
+         * @param index a node index
+         * @return the successors of the node in the direction of this tree
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> succsOf(std::size_t index) const;
+
+        /**
+         * @brief compute the reverse postorder and the immediate dominators
+         */
+        void computeIDoms();
+
+        /**
+         * @brief build the tree children and number them by dfs intervals
+         */
+        void computeIntervals();
+
+        /**
+         * @brief compute the dominance frontiers
+         */
+        void computeFrontiers();
+
+    };
+
+} // graph
+
+#endif //STATIC_ANALYZER_DOMINATORS_H
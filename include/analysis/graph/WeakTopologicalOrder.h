@@ -0,0 +1,133 @@
+#ifndef STATIC_ANALYZER_WEAKTOPOLOGICALORDER_H
+#define STATIC_ANALYZER_WEAKTOPOLOGICALORDER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "analysis/graph/CFG.h"
+
+namespace analyzer::analysis::graph {
+
+    /**
+     * @class WeakTopologicalOrder
+     * @brief a weak topological order of the nodes of a cfg, i.e. a hierarchical ordering
+     * of its nested strongly connected components
+     *
+     * The order is computed by the algorithm of Bourdoncle ("Efficient chaotic iteration
+     * strategies with widenings"), run from the entry first (the exit for a reversed order)
+     * and then from every node not visited yet, so it covers all nodes of the cfg. Every
+     * component is written as its head followed by its body, and every edge goes forward in
+     * the order unless it targets the head of a component containing its source.
+     *
+     * The order is kept flat: a component of a head at some position spans the positions up to
+     * getComponentEnd() of that position, and its nested components lie inside this range.
+     */
+    class WeakTopologicalOrder final {
+    public:
+
+        /**
+         * @brief compute the weak topological order of a cfg or of its reverse
+         * @param cfg a frozen cfg, which should outlive this order
+         * @param isReversed true to order the reversed cfg from exit, for backward analyses,
+         * false to order the cfg from entry
+         */
+        explicit WeakTopologicalOrder(const CFG& cfg, bool isReversed = false);
+
+        /**
+         * @return true if this is an order of the reversed cfg
+         */
+        [[nodiscard]] bool isReversed() const;
+
+        /**
+         * @return the number of cfg nodes, which is also the number of positions
+         */
+        [[nodiscard]] std::size_t getNodeNum() const;
+
+        /**
+         * @return the node indices in this order
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getOrder() const;
+
+        /**
+         * @param position a position in [0, getNodeNum())
+         * @return the position after the component headed at position, position + 1 if
+         * the node at position is no head or heads a component of itself only
+         */
+        [[nodiscard]] std::size_t getComponentEnd(std::size_t position) const;
+
+        /**
+         * @param index a node index
+         * @return the position of the node in this order
+         */
+        [[nodiscard]] std::size_t getPositionOf(std::size_t index) const;
+
+        /**
+         * @param index a node index
+         * @return true if the node is the head of a component
+         */
+        [[nodiscard]] bool isHead(std::size_t index) const;
+
+        /**
+         * @param stmt a node of the cfg
+         * @return true if stmt is the head of a component
+         */
+        [[nodiscard]] bool isHead(const std::shared_ptr<ir::Stmt>& stmt) const;
+
+        /**
+         * @param index a node index
+         * @return the number of components containing the node, including its own if it is a head
+         */
+        [[nodiscard]] std::size_t getDepthOf(std::size_t index) const;
+
+        /**
+         * @return the number of components
+         */
+        [[nodiscard]] std::size_t getHeadNum() const;
+
+        /**
+         * @return this order in the notation of Bourdoncle, e.g. "0 1 (2 3 (4 5) 6) 7" for node indices
+         */
+        [[nodiscard]] std::string str() const;
+
+    private:
+
+        const CFG& cfg; ///< the cfg of this order
+
+        bool reversed; ///< whether this is an order of the reversed cfg
+
+        std::vector<std::size_t> order; ///< node indices in this order
+
+        std::vector<std::size_t> componentEnds; ///< the end of the component at each position
+
+        std::vector<bool> heads; ///< whether each node is the head of a component
+
+        std::vector<std::size_t> positions; ///< the position of each node
+
+        std::vector<std::size_t> depths; ///< the nesting depth of each node
+
+        std::size_t headNum; ///< the number of components
+
+        /**
+         * @param index a node index
+         * @return the successors of the node in the direction of this order
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> succsOf(std::size_t index) const;
+
+        /**
+         * @brief compute the order and the components by an iterative form of the recursive algorithm
+         */
+        void computeOrder();
+
+        /**
+         * @brief compute the positions and nesting depths of the nodes
+         */
+        void computeDepths();
+
+    };
+
+} // graph
+
+#endif //STATIC_ANALYZER_WEAKTOPOLOGICALORDER_H
@@ -2,6 +2,7 @@
 #define STATIC_ANALYZER_ANALYSISCONFIG_H
 
 #include <string>
+#include <unordered_map>
 
 namespace analyzer::config {
 
@@ -17,6 +18,30 @@ namespace analyzer::config {
          */
         [[nodiscard]] virtual const std::string& getDescription() const = 0;
 
+        /**
+         * @brief get the value of an analysis specific option
+         * @param key the name of the option
+         * @param defaultValue the value to return if the option is not set
+         * @return the value of the option, or defaultValue if it is not set
+         */
+        [[nodiscard]] virtual std::string getOption(const std::string& key,
+                                                    const std::string& defaultValue = "") const = 0;
+
+        /**
+         * @brief get the value of a boolean option, "true", "on" and "1" are treated as true
+         * @param key the name of the option
+         * @param defaultValue the value to return if the option is not set
+         * @return the value of the option, or defaultValue if it is not set
+         */
+        [[nodiscard]] bool getBoolOption(const std::string& key, bool defaultValue = false) const
+        {
+            std::string value = getOption(key);
+            if (value.empty()) {
+                return defaultValue;
+            }
+            return value == "true" || value == "on" || value == "1";
+        }
+
         virtual ~AnalysisConfig() = default;
 
     };
@@ -26,16 +51,30 @@ namespace analyzer::config {
 
         [[nodiscard]] const std::string& getDescription() const override;
 
+        [[nodiscard]] std::string getOption(const std::string& key,
+                                            const std::string& defaultValue = "") const override;
+
         /**
-         * @brief construct a default analysis config that only has a description
+         * @brief set an analysis specific option
+         * @param key the name of the option
+         * @param value the value of the option
+         */
+        void setOption(const std::string& key, const std::string& value);
+
+        /**
+         * @brief construct a default analysis config that has a description and some options
          * @param description the description of the corresponding analysis
+         * @param options the analysis specific options, from option names to values
          */
-        explicit DefaultAnalysisConfig(std::string description = "");
+        explicit DefaultAnalysisConfig(std::string description = "",
+                                       std::unordered_map<std::string, std::string> options = {});
 
     private:
 
         std::string description; ///< the description of this analysis
 
+        std::unordered_map<std::string, std::string> options; ///< analysis specific options
+
     };
 
 }
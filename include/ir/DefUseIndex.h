@@ -0,0 +1,110 @@
+#ifndef STATIC_ANALYZER_DEFUSEINDEX_H
+#define STATIC_ANALYZER_DEFUSEINDEX_H
+
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "ir/IR.h"
+
+namespace analyzer::ir {
+
+    /**
+     * @class DefUseIndex
+     * @brief precomputed def-use and use-def chains of an ir at statement level
+     *
+     * The chains are derived once from the ssa form of the ir by resolving the phi functions,
+     * so a use is chained to exactly the definitions a reaching definition analysis would find
+     * (definitions in statements unreachable from entry excluded). All queries are array lookups.
+     */
+    class DefUseIndex final {
+    public:
+
+        /**
+         * @brief build the def-use index of an ir
+         * @param ir the ir to index
+         */
+        explicit DefUseIndex(const IR& ir);
+
+        /**
+         * @param var a variable of the ir
+         * @return the statements defining var, in reverse postorder
+         */
+        [[nodiscard]] llvm::ArrayRef<std::shared_ptr<Stmt>> getDefiningStmtsOf(const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @brief use-def chain
+         * @param stmt a statement using var
+         * @param var a variable of the ir
+         * @return the statements whose definition of var may reach the use in stmt, in reverse postorder
+         */
+        [[nodiscard]] llvm::ArrayRef<std::shared_ptr<Stmt>> getDefsOfUse(const std::shared_ptr<Stmt>& stmt,
+                                                                         const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @brief def-use chain
+         * @param stmt a statement defining var
+         * @param var a variable of the ir
+         * @return the statements whose use of var may be reached by the definition in stmt, in reverse postorder
+         */
+        [[nodiscard]] llvm::ArrayRef<std::shared_ptr<Stmt>> getUsesOfDef(const std::shared_ptr<Stmt>& stmt,
+                                                                         const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @param stmt a statement using var
+         * @param var a variable of the ir
+         * @return true if the value of var on method entry (a parameter or an uninitialized local)
+         * may reach the use in stmt
+         */
+        [[nodiscard]] bool isReachedByEntry(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @return the number of def-use edges in this index
+         */
+        [[nodiscard]] std::size_t getEdgeNum() const;
+
+    private:
+
+        std::shared_ptr<SSA> ssa; ///< the ssa form the chains are derived from
+
+        std::shared_ptr<graph::CFG> cfg; ///< the cfg of the ir
+
+        std::vector<std::shared_ptr<Var>> vars; ///< the variables of the ir, indexed by Var::getIndex
+
+        std::vector<std::size_t> varDefOffsets; ///< row offsets of defining statements per variable
+
+        std::vector<std::shared_ptr<Stmt>> varDefs; ///< defining statements grouped by variable
+
+        std::vector<std::size_t> useOffsets; ///< row offsets of uses per node, of size getNodeNum() + 1
+
+        std::vector<std::size_t> useVars; ///< sorted used variable indices of each node
+
+        std::vector<bool> useReachedByEntry; ///< whether the entry value reaches each use
+
+        std::vector<std::size_t> useDefOffsets; ///< row offsets of use-def chains per use
+
+        std::vector<std::shared_ptr<Stmt>> useDefs; ///< use-def chains grouped by use
+
+        std::vector<std::size_t> defUseOffsets; ///< row offsets of def-use chains per ssa definition
+
+        std::vector<std::shared_ptr<Stmt>> defUses; ///< def-use chains grouped by ssa definition
+
+        /**
+         * @param var a variable
+         * @return the index of var in the ir, vars.size() if var is not a variable of the ir
+         */
+        [[nodiscard]] std::size_t varIndexOf(const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @param stmt a statement
+         * @param var a variable
+         * @return the position of the use of var in stmt, useVars.size() if there is no such use
+         */
+        [[nodiscard]] std::size_t useSlotOf(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const;
+
+    };
+
+} // ir
+
+#endif //STATIC_ANALYZER_DEFUSEINDEX_H
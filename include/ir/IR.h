@@ -16,6 +16,14 @@ namespace analyzer::ir {
     namespace lang = language;
     namespace graph = analysis::graph;
 
+    class SSA;
+
+    class DefUseIndex;
+
+    namespace tac {
+        class TAC;
+    }
+
     /**
      * @class IR
      * @brief interface for intermediate representation
@@ -44,10 +52,31 @@ namespace analyzer::ir {
         [[nodiscard]] virtual std::vector<std::shared_ptr<Var>> getVars() const = 0;
 
         /**
-         * @return the statements in this ir
+         * @return the variables in this ir, each at the position of its index,
+         * i.e. the universe of the dense facts over them
+         */
+        [[nodiscard]] std::vector<std::shared_ptr<Var>> getVarsByIndex() const;
+
+        /**
+         * @return the statements in this ir, in reverse postorder of its cfg
          */
         [[nodiscard]] virtual std::vector<std::shared_ptr<Stmt>> getStmts() const = 0;
 
+        /**
+         * @return the ssa form of this ir, built on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<SSA> getSSA() const = 0;
+
+        /**
+         * @return the def-use and use-def chains of this ir, built on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<DefUseIndex> getDefUseIndex() const = 0;
+
+        /**
+         * @return the three-address code of this ir, lowered on the first query and cached
+         */
+        [[nodiscard]] virtual std::shared_ptr<tac::TAC> getTAC() const = 0;
+
         virtual ~IR() = default;
 
     };
@@ -69,6 +98,12 @@ namespace analyzer::ir {
 
         [[nodiscard]] std::vector<std::shared_ptr<Stmt>> getStmts() const override;
 
+        [[nodiscard]] std::shared_ptr<SSA> getSSA() const override;
+
+        [[nodiscard]] std::shared_ptr<DefUseIndex> getDefUseIndex() const override;
+
+        [[nodiscard]] std::shared_ptr<tac::TAC> getTAC() const override;
+
         // functions below should not be called from user
 
         /**
@@ -76,7 +111,7 @@ namespace analyzer::ir {
          * @param method the method this ir is representing
          * @param params the parameter variables in this ir
          * @param vars the variables concerned in this ir
-         * @param stmts the statements of this ir
+         * @param stmts the statements of this ir in reverse postorder
          * @param cfg the cfg derived from this ir
          */
         DefaultIR(const lang::CPPMethod& method,
@@ -93,10 +128,16 @@ namespace analyzer::ir {
 
         std::vector<std::shared_ptr<Var>> vars; ///< the variables concerned in this ir
 
-        std::vector<std::shared_ptr<Stmt>> stmts; ///< the statements of this ir
+        std::vector<std::shared_ptr<Stmt>> stmts; ///< the statements of this ir in reverse postorder
 
         std::shared_ptr<graph::CFG> cfg; ///< the cfg derived from this ir
 
+        mutable std::shared_ptr<SSA> ssa; ///< the cached ssa form of this ir
+
+        mutable std::shared_ptr<DefUseIndex> defUseIndex; ///< the cached def-use index of this ir
+
+        mutable std::shared_ptr<tac::TAC> tac; ///< the cached three-address code of this ir
+
     };
 
     /**
@@ -124,10 +165,21 @@ namespace analyzer::ir {
     class DefaultIRBuilder: public IRBuilder {
     public:
 
+        /**
+         * @brief construct a default ir builder
+         * @param simplifyCFG whether to contract the empty nop statements of the cfg where possible,
+         * statements carrying clang ast nodes are always kept
+         */
+        explicit DefaultIRBuilder(bool simplifyCFG = false);
+
         // the method below should not be called from user
 
         [[nodiscard]] std::shared_ptr<IR> buildIR(const lang::CPPMethod& method) const override;
 
+    private:
+
+        bool simplifyCFG; ///< whether to contract the empty nop statements of the cfg
+
     };
 
     /**
@@ -142,8 +194,9 @@ namespace analyzer::ir {
         /**
          * @brief construct a helper to build the default ir of method
          * @param method a cpp method
+         * @param simplifyCFG whether to contract the empty nop statements of the cfg
          */
-        explicit DefaultIRBuilderHelper(const lang::CPPMethod& method);
+        explicit DefaultIRBuilderHelper(const lang::CPPMethod& method, bool simplifyCFG = false);
 
         /**
          * @return a default ir built from method
@@ -154,13 +207,15 @@ namespace analyzer::ir {
 
         const lang::CPPMethod& method; ///< the method to build ir
 
+        bool simplifyCFG; ///< whether to contract the empty nop statements of the cfg
+
         std::vector<std::shared_ptr<Var>> params; ///< the parameter variables
 
         std::unordered_map<const clang::VarDecl*, std::shared_ptr<Var>> varPool; ///< all variables concerned
 
         std::unordered_map<const clang::Stmt*, std::shared_ptr<Stmt>> stmts; ///< all non-empty statements in this ir
 
-        std::vector<std::shared_ptr<Stmt>> stmtVec; ///< all statements in this ir
+        std::vector<std::shared_ptr<Stmt>> stmtVec; ///< all statements in this ir, in reverse postorder once built
 
         /**
          * @brief build parameter variables
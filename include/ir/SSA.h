@@ -0,0 +1,171 @@
+#ifndef STATIC_ANALYZER_SSA_H
+#define STATIC_ANALYZER_SSA_H
+
+#include <memory>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include "ir/IR.h"
+
+namespace analyzer::ir {
+
+    /**
+     * @class SSA
+     * @brief the static single assignment view of an ir
+     *
+     * Every definition of a variable gets a dense id. The first getVars().size() ids are the
+     * values of the variables on method entry (the id of such a definition equals the index of
+     * its variable), followed by the definitions of statements and the phi functions placed
+     * on the iterated dominance frontiers. Phi functions are attached to the cfg node at whose
+     * entry they are evaluated, with one operand per predecessor of that node. The statements
+     * themselves are not rewritten, each use of a variable in a statement is instead mapped
+     * to the unique definition reaching it.
+     */
+    class SSA final {
+    public:
+
+        /**
+         * @brief the kinds of ssa definitions
+         */
+        enum class DefKind {
+            ENTRY, ///< the value of a variable on method entry (a parameter or an uninitialized local)
+            STMT, ///< a definition by a statement
+            PHI ///< a phi function merging the definitions from the predecessors
+        };
+
+        /**
+         * @brief build the ssa form of an ir (minimal ssa, based on its cfg dominator tree)
+         * @param ir the ir to build ssa for
+         */
+        explicit SSA(const IR& ir);
+
+        /**
+         * @return the number of ssa definitions, which is also the id of no definition
+         */
+        [[nodiscard]] std::size_t getDefNum() const;
+
+        /**
+         * @param def a definition id
+         * @return the kind of the definition
+         */
+        [[nodiscard]] DefKind getDefKind(std::size_t def) const;
+
+        /**
+         * @param def a definition id
+         * @return the variable defined
+         */
+        [[nodiscard]] const std::shared_ptr<Var>& getDefVar(std::size_t def) const;
+
+        /**
+         * @param def a definition id
+         * @return the defining statement, the cfg entry for entry definitions
+         * and the node a phi function is attached to for phi definitions
+         */
+        [[nodiscard]] const std::shared_ptr<Stmt>& getDefStmt(std::size_t def) const;
+
+        /**
+         * @param def a phi definition id
+         * @return the operands of the phi function, the i-th operand comes from the i-th predecessor
+         * in getPredIndicesOf of its node, getDefNum() for a predecessor unreachable from entry
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getPhiOperands(std::size_t def) const;
+
+        /**
+         * @param stmt a statement or the exit of the cfg
+         * @return the ids of the phi functions at the entry of stmt
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getPhisAt(const std::shared_ptr<Stmt>& stmt) const;
+
+        /**
+         * @brief get the unique definition reaching a use
+         * @param stmt a statement using var
+         * @param var a variable of the ir
+         * @return the definition id, getDefNum() if stmt does not use var or is unreachable
+         */
+        [[nodiscard]] std::size_t getReachingDef(const std::shared_ptr<Stmt>& stmt,
+                                                 const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @param stmt a statement defining var
+         * @param var a variable of the ir
+         * @return the id of the definition of var by stmt, getDefNum() if stmt does not define var
+         */
+        [[nodiscard]] std::size_t getDefAt(const std::shared_ptr<Stmt>& stmt,
+                                           const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @param stmt a statement
+         * @return the definition ids reaching the uses of stmt, ordered by variable index
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getUseDefsOf(const std::shared_ptr<Stmt>& stmt) const;
+
+        /**
+         * @param stmt a statement
+         * @return the definition ids created by stmt, ordered by variable index
+         */
+        [[nodiscard]] llvm::ArrayRef<std::size_t> getDefsOf(const std::shared_ptr<Stmt>& stmt) const;
+
+        /**
+         * @return the number of phi functions placed
+         */
+        [[nodiscard]] std::size_t getPhiNum() const;
+
+    private:
+
+        std::shared_ptr<graph::CFG> cfg; ///< the cfg of the ir
+
+        std::vector<std::shared_ptr<Var>> vars; ///< the variables of the ir, indexed by Var::getIndex
+
+        std::vector<DefKind> defKinds; ///< kind of each definition
+
+        std::vector<std::size_t> defVars; ///< variable index of each definition
+
+        std::vector<std::size_t> defNodes; ///< cfg node index of each definition
+
+        std::vector<std::size_t> phiOffsets; ///< row offsets of phi functions per node, of size getNodeNum() + 1
+
+        std::vector<std::size_t> phis; ///< phi definition ids grouped by node
+
+        std::vector<std::size_t> phiOperandOffsets; ///< operand offset of each definition, of size getDefNum() + 1
+
+        std::vector<std::size_t> phiOperands; ///< phi operands grouped by definition
+
+        std::vector<std::size_t> useOffsets; ///< row offsets of uses per node, of size getNodeNum() + 1
+
+        std::vector<std::size_t> useVars; ///< sorted used variable indices of each node
+
+        std::vector<std::size_t> useDefs; ///< the reaching definition of each use
+
+        std::vector<std::size_t> defOffsets; ///< row offsets of definitions per node, of size getNodeNum() + 1
+
+        std::vector<std::size_t> stmtDefVars; ///< sorted defined variable indices of each node
+
+        std::vector<std::size_t> stmtDefs; ///< the definition id of each definition of a node
+
+        /**
+         * @param var a variable
+         * @return the index of var in the ir, vars.size() if var is not a variable of the ir
+         */
+        [[nodiscard]] std::size_t varIndexOf(const std::shared_ptr<Var>& var) const;
+
+        /**
+         * @brief collect the uses and the definitions of the statements
+         */
+        void collectAccesses();
+
+        /**
+         * @brief place phi functions on the iterated dominance frontiers of the definitions
+         */
+        void placePhis();
+
+        /**
+         * @brief rename the definitions and uses along the dominator tree
+         */
+        void rename();
+
+    };
+
+} // ir
+
+#endif //STATIC_ANALYZER_SSA_H
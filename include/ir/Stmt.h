@@ -63,6 +63,20 @@ namespace analyzer::ir {
          */
         [[nodiscard]] virtual const clang::Stmt* getClangStmt() const = 0;
 
+        /**
+         * @return the reverse postorder number of this statement in the cfg of its method,
+         * which is also its node index in that cfg (the entry is numbered 0)
+         */
+        [[nodiscard]] virtual std::size_t getIndex() const = 0;
+
+        // the method below should not be called from user
+
+        /**
+         * @brief set the reverse postorder number of this statement
+         * @param index the node index of this statement in its cfg
+         */
+        virtual void setIndex(std::size_t index) = 0;
+
         virtual ~Stmt() = default;
 
     };
@@ -92,6 +106,10 @@ namespace analyzer::ir {
 
         [[nodiscard]] const clang::Stmt* getClangStmt() const override;
 
+        [[nodiscard]] std::size_t getIndex() const override;
+
+        void setIndex(std::size_t index) override;
+
         /**
          * @brief construct an empty statement in a given method
          * @param method a cpp method
@@ -102,6 +120,8 @@ namespace analyzer::ir {
 
         const lang::CPPMethod& method; ///< the method containing this empty statement
 
+        std::size_t index; ///< the reverse postorder number of this statement
+
     };
 
     /**
@@ -158,6 +178,10 @@ namespace analyzer::ir {
 
         [[nodiscard]] const clang::Stmt* getClangStmt() const override;
 
+        [[nodiscard]] std::size_t getIndex() const override;
+
+        void setIndex(std::size_t index) override;
+
         /**
          * @brief Construct a statement of method by wrapping a clang statement
          * @param method the method containing this method
@@ -186,6 +210,8 @@ namespace analyzer::ir {
 
         std::string source; ///< the source code of this statement
 
+        std::size_t index; ///< the reverse postorder number of this statement
+
     };
 
     /**
@@ -0,0 +1,243 @@
+#ifndef STATIC_ANALYZER_TAC_H
+#define STATIC_ANALYZER_TAC_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/APSInt.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+
+#include "ir/IR.h"
+
+namespace clang {
+    class Expr;
+}
+
+namespace analyzer::ir::tac {
+
+    /**
+     * @brief opcodes of three-address instructions, the operand kinds are fixed by the opcode
+     */
+    enum class Opcode : std::uint8_t {
+        CONST, ///< temp dst = constant a of the constant pool
+        LOAD, ///< temp dst = variable a (its value before the statement)
+        UNKNOWN, ///< temp dst = an opaque value (non-integer or unsupported expression)
+        CAST, ///< temp dst = temp a converted to an integer of width bits, width 0 for unsupported types
+        NEG, ///< temp dst = -temp a
+        INC, ///< temp dst = temp a + 1
+        DEC, ///< temp dst = temp a - 1
+        BINARY, ///< temp dst = temp a binaryOp temp b
+        STORE ///< variable dst (its value after the statement) = temp a
+    };
+
+    /**
+     * @brief binary operators of BINARY instructions, compound assignments use the underlying operator
+     */
+    enum class BinaryOp : std::uint8_t {
+        ADD, SUB, MUL, DIV, REM, AND, OR, XOR, SHL, SHR,
+        OTHER ///< comparisons, logical and comma operators, whose value is not modeled
+    };
+
+    /**
+     * @struct Instruction
+     * @brief a 16-byte three-address instruction
+     */
+    struct Instruction {
+
+        Opcode opcode; ///< the opcode
+
+        BinaryOp binaryOp; ///< the operator of a BINARY instruction
+
+        bool isSigned; ///< the signedness of the target type of a CAST instruction
+
+        std::uint8_t width; ///< the bit width of the builtin target type of a CAST instruction, at most 128
+
+        std::uint32_t dst; ///< the destination temp, or the destination variable index of a STORE
+
+        std::uint32_t a; ///< the first operand: a temp, a variable index (LOAD) or a constant index (CONST)
+
+        std::uint32_t b; ///< the second operand temp of a BINARY instruction
+
+    };
+
+    static_assert(sizeof(Instruction) == 16, "a three-address instruction should take 16 bytes");
+
+    /**
+     * @struct ExprTemp
+     * @brief a clang expression of a statement together with the temp holding its value
+     */
+    struct ExprTemp {
+
+        const clang::Expr* expr; ///< the clang expression
+
+        std::uint32_t temp; ///< the temp holding the value of expr
+
+        std::uint32_t number; ///< the number of expr in the tac, in [0, TAC::getExprNum())
+
+    };
+
+    /**
+     * @class TAC
+     * @brief the three-address code of an ir
+     *
+     * Each statement is lowered into a flat sequence of instructions over integer temporaries,
+     * evaluated in the order clang evaluates the sub-expressions. Temporaries are numbered per
+     * statement from 0, so a client only needs getMaxTempNum() slots of scratch space. Uses of
+     * variables read the value before the statement and stores write the value after it.
+     * The instructions of all statements are stored in one array, indexed by cfg node index.
+     * The distinct clang expressions of all statements are numbered densely while lowering,
+     * so a client can keep per-expression data in a vector instead of a hash map.
+     */
+    class TAC final {
+    public:
+
+        /**
+         * @brief lower all statements of an ir
+         * @param ir the ir to lower
+         */
+        explicit TAC(const IR& ir);
+
+        /**
+         * @param stmt a statement of the ir
+         * @return the instructions of stmt, empty for nop statements
+         */
+        [[nodiscard]] llvm::ArrayRef<Instruction> getInstructionsOf(const std::shared_ptr<Stmt>& stmt) const;
+
+        /**
+         * @param stmt a statement of the ir
+         * @return the clang expressions of stmt together with the temps holding their values
+         * and their numbers, in evaluation order
+         */
+        [[nodiscard]] llvm::ArrayRef<ExprTemp> getExprTempsOf(const std::shared_ptr<Stmt>& stmt) const;
+
+        /**
+         * @return the number of distinct clang expressions of all statements
+         */
+        [[nodiscard]] std::size_t getExprNum() const;
+
+        /**
+         * @param expr a clang expression
+         * @return the number of expr, getExprNum() if expr is no expression of a statement
+         */
+        [[nodiscard]] std::size_t getExprNumber(const clang::Expr* expr) const;
+
+        /**
+         * @param index the index of a constant
+         * @return the constant in the constant pool
+         */
+        [[nodiscard]] const llvm::APSInt& getConstant(std::uint32_t index) const;
+
+        /**
+         * @param index the index of a variable
+         * @return the variable, as numbered by Var::getIndex
+         */
+        [[nodiscard]] const std::shared_ptr<Var>& getVar(std::uint32_t index) const;
+
+        /**
+         * @return the maximum number of temps used by a statement
+         */
+        [[nodiscard]] std::size_t getMaxTempNum() const;
+
+        /**
+         * @return the number of instructions of all statements
+         */
+        [[nodiscard]] std::size_t getInstructionNum() const;
+
+        /**
+         * @param instruction an instruction of this tac
+         * @return the string representation of the instruction
+         */
+        [[nodiscard]] std::string str(const Instruction& instruction) const;
+
+    private:
+
+        std::shared_ptr<graph::CFG> cfg; ///< the cfg of the ir
+
+        std::vector<std::shared_ptr<Var>> vars; ///< the variables of the ir, indexed by Var::getIndex
+
+        std::vector<llvm::APSInt> constants; ///< the constant pool
+
+        std::vector<std::size_t> instructionOffsets; ///< row offsets of instructions per node
+
+        std::vector<Instruction> instructions; ///< instructions grouped by node
+
+        std::vector<std::size_t> exprOffsets; ///< row offsets of expression temps per node
+
+        std::vector<ExprTemp> exprTemps; ///< expression temps grouped by node
+
+        llvm::DenseMap<const clang::Expr*, std::uint32_t> exprNumbers; ///< clang expression -> its number
+
+        std::size_t maxTempNum; ///< the maximum number of temps used by a statement
+
+        friend class TACBuilder;
+
+    };
+
+    /**
+     * @class TACBuilder
+     * @brief lowers the clang statement of one ir statement into three-address instructions
+     */
+    class TACBuilder {
+    public:
+
+        // the methods below should not be called from user
+
+        /**
+         * @brief construct a builder appending to tac
+         * @param tac the tac under construction
+         */
+        explicit TACBuilder(TAC& tac);
+
+        /**
+         * @brief lower a statement and append its instructions
+         * @param stmt a statement of the ir
+         */
+        void lower(const std::shared_ptr<Stmt>& stmt);
+
+    private:
+
+        TAC& tac; ///< the tac under construction
+
+        std::unordered_map<const clang::VarDecl*, std::uint32_t> varIndices; ///< integer variables -> index
+
+        std::uint32_t tempNum; ///< the number of temps used by the current statement
+
+        /**
+         * @brief append an instruction defining a new temp
+         * @param opcode the opcode
+         * @param a the first operand
+         * @param b the second operand
+         * @return the new temp
+         */
+        std::uint32_t emit(Opcode opcode, std::uint32_t a = 0, std::uint32_t b = 0);
+
+        /**
+         * @brief append a store of a temp to a variable, if it is an integer variable of the ir
+         * @param varDecl the clang declaration of the variable
+         * @param temp the temp to store
+         */
+        void emitStore(const clang::VarDecl* varDecl, std::uint32_t temp);
+
+        /**
+         * @param expr a clang expression
+         * @return the variable declaration directly referenced by expr, nullptr if there is none
+         */
+        [[nodiscard]] static const clang::VarDecl* referencedVarOf(const clang::Expr* expr);
+
+        /**
+         * @brief lower an expression recursively
+         * @param expr a clang expression
+         * @return the temp holding the value of expr
+         */
+        std::uint32_t lowerExpr(const clang::Expr* expr);
+
+    };
+
+} // tac
+
+#endif //STATIC_ANALYZER_TAC_H
@@ -40,6 +40,20 @@ namespace analyzer::ir {
          */
         [[nodiscard]] virtual const clang::VarDecl* getClangVarDecl() const = 0;
 
+        /**
+         * @return the position of this variable in the variables of its ir,
+         * parameters come first in declaration order
+         */
+        [[nodiscard]] virtual std::size_t getIndex() const = 0;
+
+        // the method below should not be called from user
+
+        /**
+         * @brief set the position of this variable in the variables of its ir
+         * @param index the dense index of this variable
+         */
+        virtual void setIndex(std::size_t index) = 0;
+
         virtual ~Var() = default;
 
     };
@@ -79,6 +93,10 @@ namespace analyzer::ir {
 
         [[nodiscard]] const clang::VarDecl* getClangVarDecl() const override;
 
+        [[nodiscard]] std::size_t getIndex() const override;
+
+        void setIndex(std::size_t index) override;
+
         /**
          * Construct a clang wrapper
          * @param method the method that defines this variable
@@ -96,6 +114,8 @@ namespace analyzer::ir {
 
         std::shared_ptr<lang::Type> type; ///< the type of this variable
 
+        std::size_t index; ///< the dense index of this variable in its ir
+
     };
 
     /**
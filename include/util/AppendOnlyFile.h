@@ -0,0 +1,110 @@
+#ifndef STATIC_ANALYZER_APPENDONLYFILE_H
+#define STATIC_ANALYZER_APPENDONLYFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace analyzer::util {
+
+    /**
+     * @class AppendOnlyFile
+     * @brief a scratch file of records that are appended once and read back through a memory map
+     *
+     * The whole file is mapped into memory, so a record is read back by the page cache faulting in
+     * the pages it lies on, and the pages of records not read recently may be evicted by the
+     * operating system instead of being kept on the heap. The mapping grows geometrically.
+     *
+     * Appending is safe from several threads: a writer reserves the room of its record under a
+     * short lock, and copies the record into the mapping concurrently with other writers and
+     * readers. Only growing the mapping excludes them. The file is removed when this object is
+     * destroyed.
+     */
+    class AppendOnlyFile final {
+    public:
+
+        static constexpr std::size_t INITIAL_CAPACITY = 1 << 20; ///< the default initial size of the mapping in bytes
+
+        /**
+         * @brief Creates and maps an empty file, replacing the file at path if there is one.
+         * @param path the path of the file
+         * @param initialCapacity the initial size of the file and its mapping in bytes, at least 1
+         * @throw std::runtime_error if the file cannot be created or mapped
+         */
+        explicit AppendOnlyFile(std::string path, std::size_t initialCapacity = INITIAL_CAPACITY);
+
+        AppendOnlyFile(const AppendOnlyFile&) = delete;
+
+        AppendOnlyFile& operator=(const AppendOnlyFile&) = delete;
+
+        ~AppendOnlyFile();
+
+        /**
+         * @brief Appends a record to the file.
+         * @param record the bytes of the record
+         * @return the offset of the record in the file
+         * @throw std::runtime_error if the file cannot grow
+         */
+        std::size_t append(const std::vector<uint8_t>& record);
+
+        /**
+         * @brief Reads a record back from the file.
+         * @param offset the offset of the record, as returned by append
+         * @param length the size of the record in bytes
+         * @return the bytes of the record
+         */
+        [[nodiscard]] std::vector<uint8_t> read(std::size_t offset, std::size_t length) const;
+
+        /**
+         * @return the path of the file
+         */
+        [[nodiscard]] const std::string& getPath() const;
+
+        /**
+         * @return the number of bytes appended so far
+         */
+        [[nodiscard]] std::size_t getSize() const;
+
+    private:
+
+        /**
+         * @brief Grows the file and its mapping to hold at least length bytes.
+         *
+         * The grown file is mapped before the old mapping is unmapped, so the file keeps its old
+         * mapping and capacity if it cannot grow.
+         *
+         * @param length the number of bytes to hold
+         * @throw std::runtime_error if the file cannot grow
+         */
+        void reserve(std::size_t length);
+
+        /**
+         * @brief Grows the file to length bytes and maps them.
+         * @param length the size of the file and its new mapping in bytes
+         * @return the new mapping
+         * @throw std::runtime_error if the file cannot grow or be mapped
+         */
+        [[nodiscard]] uint8_t* map(std::size_t length) const;
+
+        std::string path; ///< the path of the file
+
+        int fd; ///< the descriptor of the file
+
+        uint8_t* data; ///< the mapping of the file
+
+        std::size_t capacity; ///< the size of the file and its mapping in bytes
+
+        std::size_t size; ///< the number of bytes reserved by appended records
+
+        mutable std::mutex sizeMutex; ///< guards size
+
+        mutable std::shared_mutex mappingMutex; ///< guards data and capacity, exclusively held to grow
+
+    };
+
+} // util
+
+#endif //STATIC_ANALYZER_APPENDONLYFILE_H
@@ -1,6 +1,7 @@
 #ifndef STATIC_ANALYZER_LOGGER_H
 #define STATIC_ANALYZER_LOGGER_H
 
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
 
@@ -10,7 +11,8 @@ namespace analyzer::util {
 
     /**
      * @class Logger
-     * @brief Used to output different kinds of log information
+     * @brief Used to output different kinds of log information, lines are written atomically
+     * so that loggers can be shared by worker threads
      */
     class Logger final {
     public:
@@ -93,6 +95,8 @@ namespace analyzer::util {
 
         static std::unordered_map<Color, std::string_view> colors; ///< ANSI Color Control String
 
+        static std::mutex mutex; ///< serializes the output of all loggers
+
     private:
 
         llvm::raw_ostream* os; ///< an output stream
@@ -0,0 +1,535 @@
+#ifndef STATIC_ANALYZER_PERSISTENTHASHMAP_H
+#define STATIC_ANALYZER_PERSISTENTHASHMAP_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <llvm/Support/MathExtras.h>
+
+namespace analyzer::util {
+
+    /**
+     * @class PersistentHashMap
+     * @brief an immutable hash array mapped trie (hamt) with structural sharing
+     *
+     * Every update returns a new map that shares all untouched subtrees with the old one, so a copy
+     * is a pointer copy and an update allocates one node per trie level. The trie is kept in the
+     * canonical (CHAMP) form: inner nodes hold entries and sub-tries in two bitmaps, and a sub-trie
+     * never holds a single entry alone. Equal maps therefore have equal shapes, and equality stops
+     * descending at every subtree the two maps share. Hash values are 64-bit, 5 bits per level,
+     * keys with fully colliding hashes are kept in a list below the last level.
+     *
+     * @tparam K key type
+     * @tparam V value type
+     * @tparam Hash hash function of keys
+     * @tparam ValueEqual equality of values
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>, typename ValueEqual = std::equal_to<V>>
+    class PersistentHashMap final {
+    private:
+
+        struct Node;
+
+        using NodePtr = std::shared_ptr<const Node>;
+
+    public:
+
+        using Entry = std::pair<K, V>; ///< a key-value pair
+
+        /**
+         * @return the number of entries in this map
+         */
+        [[nodiscard]] std::size_t size() const
+        {
+            return root ? root->size : 0;
+        }
+
+        /**
+         * @return true if this map is empty, otherwise false
+         */
+        [[nodiscard]] bool empty() const
+        {
+            return !root;
+        }
+
+        /**
+         * @param key a key
+         * @return the value bound to key, nullptr if key is not in this map
+         */
+        [[nodiscard]] const V* find(const K& key) const
+        {
+            std::uint64_t hash = hashOf(key);
+            const Node* node = root.get();
+            for (unsigned shift = 0; node; shift += BITS) {
+                if (shift >= HASH_BITS) {
+                    for (const Entry& entry : node->entries) {
+                        if (entry.first == key) {
+                            return &entry.second;
+                        }
+                    }
+                    return nullptr;
+                }
+                std::uint32_t bit = bitOf(hash, shift);
+                if (node->dataMap & bit) {
+                    const Entry& entry = node->entries[indexOf(node->dataMap, bit)];
+                    return entry.first == key ? &entry.second : nullptr;
+                }
+                node = node->nodeMap & bit ? node->children[indexOf(node->nodeMap, bit)].get() : nullptr;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @param key a key
+         * @param value a value
+         * @return a map binding key to value, sharing everything else with this map
+         * (this map itself if key is already bound to an equal value)
+         */
+        [[nodiscard]] PersistentHashMap insert(const K& key, const V& value) const
+        {
+            if (!root) {
+                return PersistentHashMap(makeSingleton(Entry(key, value), hashOf(key), 0));
+            }
+            return PersistentHashMap(insert(root, Entry(key, value), hashOf(key), 0, true));
+        }
+
+        /**
+         * @param key a key
+         * @return a map without key, sharing everything else with this map
+         * (this map itself if key is not in it)
+         */
+        [[nodiscard]] PersistentHashMap erase(const K& key) const
+        {
+            if (!root) {
+                return *this;
+            }
+            NodePtr newRoot = erase(root, key, hashOf(key), 0);
+            return PersistentHashMap(newRoot && newRoot->size > 0 ? newRoot : nullptr);
+        }
+
+        /**
+         * @param other another map
+         * @return the union of the two maps, taking the values of this map for keys in both
+         * (this map itself if every key of other is in this map)
+         */
+        [[nodiscard]] PersistentHashMap unionWith(const PersistentHashMap& other) const
+        {
+            if (!root) {
+                return other;
+            }
+            if (!other.root) {
+                return *this;
+            }
+            return PersistentHashMap(merge(root, other.root, 0, false));
+        }
+
+        /**
+         * @param other another map
+         * @return the union of the two maps, taking the values of other for keys in both
+         * (this map itself if every entry of other is in this map)
+         */
+        [[nodiscard]] PersistentHashMap updateWith(const PersistentHashMap& other) const
+        {
+            if (!root) {
+                return other;
+            }
+            if (!other.root) {
+                return *this;
+            }
+            return PersistentHashMap(merge(root, other.root, 0, true));
+        }
+
+        /**
+         * @param other another map
+         * @return true if this map and other share their whole trie
+         */
+        [[nodiscard]] bool isSameAs(const PersistentHashMap& other) const
+        {
+            return root == other.root;
+        }
+
+        /**
+         * @brief call processor for each entry of this map
+         * @param processor a processor function taking a const Entry&
+         */
+        template <typename F>
+        void forEach(F&& processor) const
+        {
+            if (root) {
+                forEach(*root, processor);
+            }
+        }
+
+        /**
+         * @param other another map
+         * @return true if both maps have equal keys bound to equal values
+         */
+        bool operator==(const PersistentHashMap& other) const
+        {
+            return size() == other.size() && equals(root, other.root, 0);
+        }
+
+        bool operator!=(const PersistentHashMap& other) const
+        {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Construct an empty map
+         */
+        PersistentHashMap() = default;
+
+    private:
+
+        static constexpr unsigned BITS = 5; ///< hash bits consumed per level
+
+        static constexpr unsigned HASH_BITS = 64; ///< hash bits in total, deeper levels are collision lists
+
+        /**
+         * @struct Node
+         * @brief a trie node, or a collision list below the last level
+         */
+        struct Node {
+
+            std::uint32_t dataMap = 0; ///< the hash fragments holding an entry
+
+            std::uint32_t nodeMap = 0; ///< the hash fragments holding a sub-trie
+
+            std::size_t size = 0; ///< the number of entries in this sub-trie
+
+            std::vector<Entry> entries; ///< the entries, in fragment order
+
+            std::vector<NodePtr> children; ///< the sub-tries, in fragment order
+
+        };
+
+        explicit PersistentHashMap(NodePtr root)
+            :root(std::move(root))
+        {
+
+        }
+
+        static std::uint64_t hashOf(const K& key)
+        {
+            // splitmix64 finalizer, spreads the aligned bits of pointer hashes over all levels
+            auto hash = static_cast<std::uint64_t>(Hash{}(key));
+            hash = (hash ^ (hash >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+            hash = (hash ^ (hash >> 27U)) * 0x94d049bb133111ebULL;
+            return hash ^ (hash >> 31U);
+        }
+
+        static std::uint32_t bitOf(std::uint64_t hash, unsigned shift)
+        {
+            return 1U << ((hash >> shift) & ((1U << BITS) - 1));
+        }
+
+        static std::size_t indexOf(std::uint32_t map, std::uint32_t bit)
+        {
+            return llvm::countPopulation(map & (bit - 1));
+        }
+
+        /**
+         * @return a node holding a single entry
+         */
+        static NodePtr makeSingleton(Entry entry, std::uint64_t hash, unsigned shift)
+        {
+            auto node = std::make_shared<Node>();
+            if (shift < HASH_BITS) {
+                node->dataMap = bitOf(hash, shift);
+            }
+            node->size = 1;
+            node->entries.emplace_back(std::move(entry));
+            return node;
+        }
+
+        /**
+         * @return a sub-trie holding two entries with different keys
+         */
+        static NodePtr makePair(Entry e1, std::uint64_t h1, Entry e2, std::uint64_t h2, unsigned shift)
+        {
+            auto node = std::make_shared<Node>();
+            node->size = 2;
+            if (shift >= HASH_BITS) {
+                node->entries.emplace_back(std::move(e1));
+                node->entries.emplace_back(std::move(e2));
+                return node;
+            }
+            std::uint32_t b1 = bitOf(h1, shift);
+            std::uint32_t b2 = bitOf(h2, shift);
+            if (b1 == b2) {
+                node->nodeMap = b1;
+                node->children.emplace_back(makePair(std::move(e1), h1, std::move(e2), h2, shift + BITS));
+                return node;
+            }
+            node->dataMap = b1 | b2;
+            if (b1 < b2) {
+                node->entries.emplace_back(std::move(e1));
+                node->entries.emplace_back(std::move(e2));
+            } else {
+                node->entries.emplace_back(std::move(e2));
+                node->entries.emplace_back(std::move(e1));
+            }
+            return node;
+        }
+
+        /**
+         * @param overwrite whether an existing value of the key is replaced
+         * @return node with entry inserted, node itself if nothing changes
+         */
+        static NodePtr insert(const NodePtr& node, const Entry& entry, std::uint64_t hash, unsigned shift,
+                              bool overwrite)
+        {
+            if (shift >= HASH_BITS) {
+                for (std::size_t i = 0; i < node->entries.size(); i++) {
+                    if (node->entries[i].first == entry.first) {
+                        if (!overwrite || ValueEqual{}(node->entries[i].second, entry.second)) {
+                            return node;
+                        }
+                        auto newNode = std::make_shared<Node>(*node);
+                        newNode->entries[i].second = entry.second;
+                        return newNode;
+                    }
+                }
+                auto newNode = std::make_shared<Node>(*node);
+                newNode->entries.emplace_back(entry);
+                newNode->size++;
+                return newNode;
+            }
+            std::uint32_t bit = bitOf(hash, shift);
+            if (node->dataMap & bit) {
+                std::size_t i = indexOf(node->dataMap, bit);
+                const Entry& old = node->entries[i];
+                if (old.first == entry.first) {
+                    if (!overwrite || ValueEqual{}(old.second, entry.second)) {
+                        return node;
+                    }
+                    auto newNode = std::make_shared<Node>(*node);
+                    newNode->entries[i].second = entry.second;
+                    return newNode;
+                }
+                auto newNode = std::make_shared<Node>(*node);
+                NodePtr child = makePair(old, hashOf(old.first), entry, hash, shift + BITS);
+                newNode->entries.erase(newNode->entries.begin() + static_cast<std::ptrdiff_t>(i));
+                newNode->dataMap ^= bit;
+                newNode->nodeMap |= bit;
+                newNode->children.insert(newNode->children.begin()
+                    + static_cast<std::ptrdiff_t>(indexOf(newNode->nodeMap, bit)), std::move(child));
+                newNode->size++;
+                return newNode;
+            }
+            if (node->nodeMap & bit) {
+                std::size_t i = indexOf(node->nodeMap, bit);
+                NodePtr child = insert(node->children[i], entry, hash, shift + BITS, overwrite);
+                if (child == node->children[i]) {
+                    return node;
+                }
+                auto newNode = std::make_shared<Node>(*node);
+                newNode->size += child->size - node->children[i]->size;
+                newNode->children[i] = std::move(child);
+                return newNode;
+            }
+            auto newNode = std::make_shared<Node>(*node);
+            newNode->dataMap |= bit;
+            newNode->entries.insert(newNode->entries.begin()
+                + static_cast<std::ptrdiff_t>(indexOf(newNode->dataMap, bit)), entry);
+            newNode->size++;
+            return newNode;
+        }
+
+        /**
+         * @return node without key, node itself if key is not in it
+         */
+        static NodePtr erase(const NodePtr& node, const K& key, std::uint64_t hash, unsigned shift)
+        {
+            if (shift >= HASH_BITS) {
+                for (std::size_t i = 0; i < node->entries.size(); i++) {
+                    if (node->entries[i].first == key) {
+                        auto newNode = std::make_shared<Node>(*node);
+                        newNode->entries.erase(newNode->entries.begin() + static_cast<std::ptrdiff_t>(i));
+                        newNode->size--;
+                        return newNode;
+                    }
+                }
+                return node;
+            }
+            std::uint32_t bit = bitOf(hash, shift);
+            if (node->dataMap & bit) {
+                std::size_t i = indexOf(node->dataMap, bit);
+                if (!(node->entries[i].first == key)) {
+                    return node;
+                }
+                auto newNode = std::make_shared<Node>(*node);
+                newNode->entries.erase(newNode->entries.begin() + static_cast<std::ptrdiff_t>(i));
+                newNode->dataMap ^= bit;
+                newNode->size--;
+                return newNode;
+            }
+            if (node->nodeMap & bit) {
+                std::size_t i = indexOf(node->nodeMap, bit);
+                NodePtr child = erase(node->children[i], key, hash, shift + BITS);
+                if (child == node->children[i]) {
+                    return node;
+                }
+                auto newNode = std::make_shared<Node>(*node);
+                newNode->size--;
+                if (child->size == 1) {
+                    // keep the canonical form: a single entry moves up into this node
+                    Entry last = findOnly(*child);
+                    newNode->children.erase(newNode->children.begin() + static_cast<std::ptrdiff_t>(i));
+                    newNode->nodeMap ^= bit;
+                    newNode->dataMap |= bit;
+                    newNode->entries.insert(newNode->entries.begin()
+                        + static_cast<std::ptrdiff_t>(indexOf(newNode->dataMap, bit)), std::move(last));
+                } else {
+                    newNode->children[i] = std::move(child);
+                }
+                return newNode;
+            }
+            return node;
+        }
+
+        /**
+         * @return the only entry of a sub-trie with size 1
+         */
+        static const Entry& findOnly(const Node& node)
+        {
+            return node.entries.empty() ? findOnly(*node.children.front()) : node.entries.front();
+        }
+
+        /**
+         * @param overwrite whether the values of b are taken for keys in both
+         * @return the union of a and b, a itself if b adds or changes nothing
+         */
+        static NodePtr merge(const NodePtr& a, const NodePtr& b, unsigned shift, bool overwrite)
+        {
+            if (a == b) {
+                return a;
+            }
+            if (shift >= HASH_BITS) {
+                NodePtr result = a;
+                for (const Entry& entry : b->entries) {
+                    result = insert(result, entry, 0, shift, overwrite);
+                }
+                return result;
+            }
+            auto node = std::make_shared<Node>();
+            bool same = true;
+            std::uint32_t all = a->dataMap | a->nodeMap | b->dataMap | b->nodeMap;
+            while (all) {
+                std::uint32_t bit = all & (~all + 1);
+                all ^= bit;
+                if (a->dataMap & bit) {
+                    const Entry& ea = a->entries[indexOf(a->dataMap, bit)];
+                    if (b->dataMap & bit) {
+                        const Entry& eb = b->entries[indexOf(b->dataMap, bit)];
+                        if (ea.first == eb.first) {
+                            bool keep = !overwrite || ValueEqual{}(ea.second, eb.second);
+                            addEntry(*node, bit, keep ? ea : eb);
+                            same = same && keep;
+                        } else {
+                            addChild(*node, bit, makePair(ea, hashOf(ea.first), eb, hashOf(eb.first), shift + BITS));
+                            same = false;
+                        }
+                    } else if (b->nodeMap & bit) {
+                        const NodePtr& cb = b->children[indexOf(b->nodeMap, bit)];
+                        addChild(*node, bit, insert(cb, ea, hashOf(ea.first), shift + BITS, !overwrite));
+                        same = false;
+                    } else {
+                        addEntry(*node, bit, ea);
+                    }
+                } else if (a->nodeMap & bit) {
+                    const NodePtr& ca = a->children[indexOf(a->nodeMap, bit)];
+                    NodePtr child = ca;
+                    if (b->dataMap & bit) {
+                        const Entry& eb = b->entries[indexOf(b->dataMap, bit)];
+                        child = insert(ca, eb, hashOf(eb.first), shift + BITS, overwrite);
+                    } else if (b->nodeMap & bit) {
+                        child = merge(ca, b->children[indexOf(b->nodeMap, bit)], shift + BITS, overwrite);
+                    }
+                    same = same && child == ca;
+                    addChild(*node, bit, std::move(child));
+                } else if (b->dataMap & bit) {
+                    addEntry(*node, bit, b->entries[indexOf(b->dataMap, bit)]);
+                    same = false;
+                } else {
+                    addChild(*node, bit, b->children[indexOf(b->nodeMap, bit)]);
+                    same = false;
+                }
+            }
+            return same ? a : node;
+        }
+
+        static void addEntry(Node& node, std::uint32_t bit, const Entry& entry)
+        {
+            node.dataMap |= bit;
+            node.entries.emplace_back(entry);
+            node.size++;
+        }
+
+        static void addChild(Node& node, std::uint32_t bit, NodePtr child)
+        {
+            node.nodeMap |= bit;
+            node.size += child->size;
+            node.children.emplace_back(std::move(child));
+        }
+
+        static bool equals(const NodePtr& a, const NodePtr& b, unsigned shift)
+        {
+            if (a == b) {
+                return true;
+            }
+            if (!a || !b || a->size != b->size) {
+                return false;
+            }
+            if (shift >= HASH_BITS) {
+                for (const Entry& ea : a->entries) {
+                    bool found = false;
+                    for (const Entry& eb : b->entries) {
+                        if (ea.first == eb.first) {
+                            found = ValueEqual{}(ea.second, eb.second);
+                            break;
+                        }
+                    }
+                    if (!found) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            if (a->dataMap != b->dataMap || a->nodeMap != b->nodeMap) {
+                return false;
+            }
+            for (std::size_t i = 0; i < a->entries.size(); i++) {
+                if (!(a->entries[i].first == b->entries[i].first) || !ValueEqual{}(a->entries[i].second, b->entries[i].second)) {
+                    return false;
+                }
+            }
+            for (std::size_t i = 0; i < a->children.size(); i++) {
+                if (!equals(a->children[i], b->children[i], shift + BITS)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename F>
+        static void forEach(const Node& node, F& processor)
+        {
+            for (const Entry& entry : node.entries) {
+                processor(entry);
+            }
+            for (const NodePtr& child : node.children) {
+                forEach(*child, processor);
+            }
+        }
+
+        NodePtr root; ///< the root of the trie, nullptr for the empty map
+
+    };
+
+} // util
+
+#endif //STATIC_ANALYZER_PERSISTENTHASHMAP_H
@@ -57,6 +57,15 @@ namespace analyzer {
         logger = newLogger;
     }
 
+    void World::setIRBuilder(std::unique_ptr<ir::IRBuilder> newIRBuilder)
+    {
+        if (theWorld == nullptr) {
+            logger.Error("The world is not initialized!");
+            throw std::runtime_error("The world is not initialized!");
+        }
+        theWorld->irBuilder = std::move(newIRBuilder);
+    }
+
     World::World(std::unordered_map<std::string, std::string>&& sourceCode, std::vector<std::string>&& args)
         :sourceCode(std::move(sourceCode)), args(std::move(args))
     {
@@ -215,6 +224,14 @@ namespace analyzer {
         return nullptr;
     }
 
+    std::shared_ptr<analysis::graph::CallGraph> World::getCallGraph() const
+    {
+        if (!callGraph) {
+            callGraph = std::make_shared<analysis::graph::CallGraph>(allMethods);
+        }
+        return callGraph;
+    }
+
     const std::unique_ptr<ir::IRBuilder>& World::getIRBuilder() const
     {
         return irBuilder;
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "analysis/BottomUpScheduler.h"
+#include "World.h"
+
+namespace analyzer::analysis {
+
+    BottomUpScheduler::BottomUpScheduler(std::shared_ptr<graph::CallGraph> callGraph)
+        :callGraph(std::move(callGraph)), criticalPathLength(0), totalWork(0), criticalPathWork(0), wallTime(0)
+    {
+        std::size_t n = this->callGraph->getMethodNum();
+
+        // iterative tarjan, sccs are completed callees first, which is a bottom-up topological order
+        std::vector<std::size_t> indices(n, n), lowLinks(n, 0);
+        std::vector<bool> onStack(n, false);
+        std::vector<std::size_t> stack;
+        std::vector<std::pair<std::size_t, std::size_t>> dfs; // (method, next callee position)
+        std::size_t counter = 0;
+        sccOf.assign(n, n);
+        memberOffsets.assign(1, 0);
+        for (std::size_t root = 0; root < n; root++) {
+            if (indices[root] != n) {
+                continue;
+            }
+            indices[root] = lowLinks[root] = counter++;
+            stack.emplace_back(root);
+            onStack[root] = true;
+            dfs.emplace_back(root, 0);
+            while (!dfs.empty()) {
+                auto& [v, next] = dfs.back();
+                llvm::ArrayRef<std::size_t> callees = this->callGraph->getCalleeIdsOf(v);
+                if (next < callees.size()) {
+                    std::size_t w = callees[next++];
+                    if (indices[w] == n) {
+                        indices[w] = lowLinks[w] = counter++;
+                        stack.emplace_back(w);
+                        onStack[w] = true;
+                        dfs.emplace_back(w, 0);
+                    } else if (onStack[w]) {
+                        lowLinks[v] = std::min(lowLinks[v], indices[w]);
+                    }
+                    continue;
+                }
+                std::size_t finished = v;
+                dfs.pop_back();
+                if (!dfs.empty()) {
+                    std::size_t parent = dfs.back().first;
+                    lowLinks[parent] = std::min(lowLinks[parent], lowLinks[finished]);
+                }
+                if (lowLinks[finished] == indices[finished]) {
+                    std::size_t scc = memberOffsets.size() - 1;
+                    std::size_t begin = members.size();
+                    std::size_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        onStack[w] = false;
+                        sccOf[w] = scc;
+                        members.emplace_back(w);
+                    } while (w != finished);
+                    std::sort(members.begin() + static_cast<std::ptrdiff_t>(begin), members.end());
+                    memberOffsets.emplace_back(members.size());
+                    recursive.emplace_back(members.size() - begin > 1 || this->callGraph->hasEdge(finished, finished));
+                }
+            }
+        }
+
+        // edges of the condensation dag
+        std::size_t sccNum = getSCCNum();
+        std::vector<std::pair<std::size_t, std::size_t>> edges; // (caller scc, callee scc)
+        for (std::size_t caller = 0; caller < n; caller++) {
+            for (std::size_t callee : this->callGraph->getCalleeIdsOf(caller)) {
+                if (sccOf[caller] != sccOf[callee]) {
+                    edges.emplace_back(sccOf[caller], sccOf[callee]);
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        calleeOffsets.assign(sccNum + 1, 0);
+        callerOffsets.assign(sccNum + 1, 0);
+        for (const auto& [caller, callee] : edges) {
+            calleeOffsets[caller + 1]++;
+            callerOffsets[callee + 1]++;
+            calleeSCCs.emplace_back(callee);
+        }
+        for (std::size_t scc = 0; scc < sccNum; scc++) {
+            calleeOffsets[scc + 1] += calleeOffsets[scc];
+            callerOffsets[scc + 1] += callerOffsets[scc];
+        }
+        callerSCCs.resize(edges.size());
+        std::vector<std::size_t> cursor(callerOffsets.begin(), callerOffsets.end() - 1);
+        for (const auto& [caller, callee] : edges) {
+            callerSCCs[cursor[callee]++] = caller;
+        }
+
+        // callee sccs are numbered first, so one pass in scc order finds the longest chains
+        std::vector<std::size_t> depths(sccNum, 1);
+        for (std::size_t scc = 0; scc < sccNum; scc++) {
+            for (std::size_t callee : getCalleeSCCsOf(scc)) {
+                depths[scc] = std::max(depths[scc], depths[callee] + 1);
+            }
+            criticalPathLength = std::max(criticalPathLength, depths[scc]);
+        }
+    }
+
+    const std::shared_ptr<graph::CallGraph>& BottomUpScheduler::getCallGraph() const
+    {
+        return callGraph;
+    }
+
+    std::size_t BottomUpScheduler::getSCCNum() const
+    {
+        return memberOffsets.size() - 1;
+    }
+
+    std::size_t BottomUpScheduler::getSCCOf(std::size_t methodId) const
+    {
+        return sccOf[methodId];
+    }
+
+    llvm::ArrayRef<std::size_t> BottomUpScheduler::getMethodIdsOf(std::size_t scc) const
+    {
+        return llvm::ArrayRef<std::size_t>(members).slice(memberOffsets[scc], memberOffsets[scc + 1] - memberOffsets[scc]);
+    }
+
+    bool BottomUpScheduler::isRecursive(std::size_t scc) const
+    {
+        return recursive[scc];
+    }
+
+    llvm::ArrayRef<std::size_t> BottomUpScheduler::getCalleeSCCsOf(std::size_t scc) const
+    {
+        return llvm::ArrayRef<std::size_t>(calleeSCCs).slice(calleeOffsets[scc],
+            calleeOffsets[scc + 1] - calleeOffsets[scc]);
+    }
+
+    llvm::ArrayRef<std::size_t> BottomUpScheduler::getCallerSCCsOf(std::size_t scc) const
+    {
+        return llvm::ArrayRef<std::size_t>(callerSCCs).slice(callerOffsets[scc],
+            callerOffsets[scc + 1] - callerOffsets[scc]);
+    }
+
+    std::size_t BottomUpScheduler::getCriticalPathLength() const
+    {
+        return criticalPathLength;
+    }
+
+    void BottomUpScheduler::run(const std::function<void(std::size_t)>& task, std::size_t threadNum)
+    {
+        using Clock = std::chrono::steady_clock;
+        std::size_t sccNum = getSCCNum();
+        World::getLogger().Progress("Scheduling " + std::to_string(sccNum) + " sccs bottom-up ...");
+        if (threadNum == 0) {
+            threadNum = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadNum = std::max<std::size_t>(1, std::min(threadNum, sccNum));
+
+        std::vector<std::size_t> pending(sccNum);
+        std::vector<std::size_t> ready;
+        for (std::size_t scc = 0; scc < sccNum; scc++) {
+            pending[scc] = getCalleeSCCsOf(scc).size();
+            if (pending[scc] == 0) {
+                ready.emplace_back(scc);
+            }
+        }
+        std::vector<double> work(sccNum, 0);
+        std::size_t finished = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cv.wait(lock, [&]() -> bool { return !ready.empty() || finished == sccNum || error; });
+                if (finished == sccNum || error) {
+                    return;
+                }
+                std::size_t scc = ready.back();
+                ready.pop_back();
+                lock.unlock();
+                Clock::time_point start = Clock::now();
+                try {
+                    task(scc);
+                } catch (...) {
+                    lock.lock();
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    cv.notify_all();
+                    return;
+                }
+                double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                lock.lock();
+                work[scc] = seconds;
+                finished++;
+                for (std::size_t caller : getCallerSCCsOf(scc)) {
+                    if (--pending[caller] == 0) {
+                        ready.emplace_back(caller);
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+        Clock::time_point start = Clock::now();
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threadNum; t++) {
+            workers.emplace_back(worker);
+        }
+        for (std::thread& t : workers) {
+            t.join();
+        }
+        wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        std::vector<double> pathWork(sccNum, 0);
+        totalWork = 0;
+        criticalPathWork = 0;
+        for (std::size_t scc = 0; scc < sccNum; scc++) {
+            for (std::size_t callee : getCalleeSCCsOf(scc)) {
+                pathWork[scc] = std::max(pathWork[scc], pathWork[callee]);
+            }
+            pathWork[scc] += work[scc];
+            totalWork += work[scc];
+            criticalPathWork = std::max(criticalPathWork, pathWork[scc]);
+        }
+        World::getLogger().Success("Finished " + std::to_string(sccNum) + " sccs with "
+            + std::to_string(threadNum) + " threads: critical path of " + std::to_string(criticalPathLength)
+            + " sccs and " + std::to_string(criticalPathWork) + "s, total work "
+            + std::to_string(totalWork) + "s, wall time " + std::to_string(wallTime)
+            + "s, achieved parallelism " + std::to_string(getParallelism()));
+    }
+
+    double BottomUpScheduler::getTotalWork() const
+    {
+        return totalWork;
+    }
+
+    double BottomUpScheduler::getCriticalPathWork() const
+    {
+        return criticalPathWork;
+    }
+
+    double BottomUpScheduler::getWallTime() const
+    {
+        return wallTime;
+    }
+
+    double BottomUpScheduler::getParallelism() const
+    {
+        return wallTime > 0 ? totalWork / wallTime : 0;
+    }
+
+} // analysis
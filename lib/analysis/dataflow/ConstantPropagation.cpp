@@ -1,32 +1,56 @@
+#include <algorithm>
+
 #include "analysis/dataflow/ConstantPropagation.h"
+#include "ir/TAC.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MathExtras.h"
 
 namespace analyzer::analysis::dataflow {
 
-    //// ============== CPValue ============== ////
-
-    std::shared_ptr<CPValue> CPValue::Undef = std::make_shared<CPValue>(Kind::UNDEF);
-
-    std::shared_ptr<CPValue> CPValue::NAC = std::make_shared<CPValue>(Kind::NAC);
+    //// ============== WideConstantTable ============== ////
 
-    CPValue::CPValue(Kind kind, llvm::APSInt constantValue)
-        : kind(kind), constantValue(std::move(constantValue))
+    const llvm::APSInt* WideConstantTable::intern(const llvm::APSInt& constant)
     {
+        return &*constants.insert(constant).first;
+    }
 
+    std::size_t WideConstantTable::size() const
+    {
+        return constants.size();
     }
 
-    bool CPValue::isUndef() const
+    std::size_t WideConstantTable::Hash::operator()(const llvm::APSInt& constant) const
     {
-        return kind == Kind::UNDEF;
+        return llvm::hash_combine(llvm::hash_value(constant), constant.getBitWidth(), constant.isUnsigned());
     }
 
-    bool CPValue::isNAC() const
+    bool WideConstantTable::Equal::operator()(const llvm::APSInt& a, const llvm::APSInt& b) const
     {
-        return kind == Kind::NAC;
+        return a.getBitWidth() == b.getBitWidth() && a.isUnsigned() == b.isUnsigned() && a == b;
     }
 
-    bool CPValue::isConstant() const
+    //// ============== CPValue ============== ////
+
+    std::shared_ptr<CPValue> CPValue::Undef = std::make_shared<CPValue>(Kind::UNDEF);
+
+    std::shared_ptr<CPValue> CPValue::NAC = std::make_shared<CPValue>(Kind::NAC);
+
+    CPValue::CPValue(Kind kind, const llvm::APSInt& constantValue, WideConstantTable* wideConstants)
+        : kind(kind), unsignedValue(false), bitWidth(0), bits(0), wideValue(nullptr)
     {
-        return kind == Kind::CONSTANT;
+        if (kind == Kind::CONSTANT) {
+            unsignedValue = constantValue.isUnsigned();
+            bitWidth = constantValue.getBitWidth();
+            if (bitWidth <= 64) {
+                bits = constantValue.getZExtValue();
+            } else if (wideConstants != nullptr) {
+                wideValue = wideConstants->intern(constantValue);
+            } else {
+                World::getLogger().Error("A constant of " + std::to_string(bitWidth) + " bits needs a wide constant table");
+                throw std::runtime_error("A constant of " + std::to_string(bitWidth) + " bits needs a wide constant table");
+            }
+        }
     }
 
     std::shared_ptr<CPValue> CPValue::getUndef()
@@ -41,15 +65,69 @@ namespace analyzer::analysis::dataflow {
 
     std::shared_ptr<CPValue> CPValue::makeConstant(const llvm::APSInt &constantValue)
     {
-        return std::make_shared<CPValue>(Kind::CONSTANT, constantValue);
+        if (constantValue.getBitWidth() <= 64) {
+            return share(constant(constantValue));
+        }
+        // share copies the wide constant out of the table
+        WideConstantTable wideConstants;
+        return share(constant(constantValue, &wideConstants));
     }
 
-    const llvm::APSInt& CPValue::getConstantValue() const
+    std::shared_ptr<CPValue> CPValue::share(const CPValue& value)
+    {
+        if (value.isUndef()) {
+            return Undef;
+        }
+        if (value.isNAC()) {
+            return NAC;
+        }
+        if (!value.wideValue) {
+            return std::make_shared<CPValue>(value);
+        }
+        // the shared value owns its wide constant, so it outlives the table of value
+        struct Wide {
+            llvm::APSInt constant;
+            CPValue value;
+        };
+        auto wide = std::make_shared<Wide>(Wide{*value.wideValue, value});
+        wide->value.wideValue = &wide->constant;
+        return std::shared_ptr<CPValue>(wide, &wide->value);
+    }
+
+    CPValue CPValue::undef()
+    {
+        return CPValue(Kind::UNDEF);
+    }
+
+    CPValue CPValue::nac()
+    {
+        return CPValue(Kind::NAC);
+    }
+
+    CPValue CPValue::constant(const llvm::APSInt &constantValue, WideConstantTable* wideConstants)
+    {
+        return CPValue(Kind::CONSTANT, constantValue, wideConstants);
+    }
+
+    llvm::APSInt CPValue::getConstantValue() const
     {
         if (!isConstant()) {
             throw std::runtime_error("CPValue is not a constant");
         }
-        return constantValue;
+        if (wideValue) {
+            return *wideValue;
+        }
+        return llvm::APSInt(llvm::APInt(bitWidth, bits), unsignedValue);
+    }
+
+    CPValue CPValue::internedIn(WideConstantTable& wideConstants) const
+    {
+        if (!wideValue) {
+            return *this;
+        }
+        CPValue value = *this;
+        value.wideValue = wideConstants.intern(*wideValue);
+        return value;
     }
 
     std::string CPValue::str() const
@@ -60,45 +138,554 @@ namespace analyzer::analysis::dataflow {
         if (isUndef()) {
             return "Undefined";
         }
-        return constantValue.isSigned() ? std::to_string(constantValue.getSExtValue())
-            : std::to_string(constantValue.getZExtValue());
+        if (wideValue) {
+            return llvm::toString(*wideValue, 10);
+        }
+        return unsignedValue ? std::to_string(bits) : std::to_string(llvm::SignExtend64(bits, bitWidth));
+    }
+
+    std::size_t CPValue::hash() const
+    {
+        if (wideValue) {
+            return llvm::hash_value(*wideValue);
+        }
+        return llvm::hash_combine(kind, unsignedValue, bitWidth, bits);
     }
 
     //// ============== CPFact ============== ////
 
+    CPFact::CPFact(Kind kind)
+        : fact::MapFact<ir::Var, CPValue>(kind)
+    {
+
+    }
+
     std::shared_ptr<CPValue> CPFact::get(const std::shared_ptr<ir::Var>& key) const
     {
-        std::shared_ptr<CPValue> value = fact::MapFact<ir::Var, CPValue>::get(key);
-        if (value) {
-            return value;
-        }
-        return CPValue::getUndef();
+        return CPValue::share(getValue(key));
     }
 
     bool CPFact::update(const std::shared_ptr<ir::Var>& key, const std::shared_ptr<CPValue>& value)
     {
-        if (value->isUndef()) {
-            return remove(key) != nullptr;
+        return updateValue(key, *value);
+    }
+
+    CPValue CPFact::getValue(const std::shared_ptr<ir::Var>& key) const
+    {
+        return *get(key);
+    }
+
+    bool CPFact::updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value)
+    {
+        if (getValue(key) == value) {
+            return false;
+        }
+        return update(key, CPValue::share(value));
+    }
+
+    //// ============== HashCPFact ============== ////
+
+    HashCPFact::HashCPFact(std::shared_ptr<WideConstantTable> wideConstants)
+        : CPFact(KIND), wideConstants(std::move(wideConstants)), values(emptyValues())
+    {
+
+    }
+
+    CPValue HashCPFact::getValue(const std::shared_ptr<ir::Var>& key) const
+    {
+        auto it = values->find(key);
+        return it == values->end() ? CPValue::undef() : it->second;
+    }
+
+    bool HashCPFact::updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value)
+    {
+        auto it = values->find(key);
+        if (value.isUndef()) {
+            if (it == values->end()) {
+                return false;
+            }
+            mutableValues().erase(key);
+            return true;
+        }
+        if (it != values->end() && it->second == value) {
+            return false;
+        }
+        if (value.wideValue && !wideConstants) {
+            wideConstants = std::make_shared<WideConstantTable>();
+        }
+        // a wide constant interned in the table of this fact lives as long as the fact
+        mutableValues().insert_or_assign(key, value.wideValue ? value.internedIn(*wideConstants) : value);
+        return true;
+    }
+
+    std::shared_ptr<CPValue> HashCPFact::remove(const std::shared_ptr<ir::Var>& key)
+    {
+        auto it = values->find(key);
+        if (it == values->end()) {
+            return nullptr;
+        }
+        std::shared_ptr<CPValue> result = CPValue::share(it->second);
+        mutableValues().erase(key);
+        return result;
+    }
+
+    bool HashCPFact::copyFrom(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>> fact)
+    {
+        if (!classof(fact.get())) {
+            return CPFact::copyFrom(fact);
+        }
+        const auto* o = static_cast<const HashCPFact*>(fact.get());
+        if (o->values == values) {
+            return false;
+        }
+        if (values->empty()) {
+            // the values of o refer to its wide constant table only
+            wideConstants = o->wideConstants;
+            values = o->values;
+            return !values->empty();
+        }
+        bool changed = false;
+        for (const auto& [key, value] : *o->values) {
+            changed = updateValue(key, value) || changed;
+        }
+        return changed;
+    }
+
+    std::shared_ptr<fact::MapFact<ir::Var, CPValue>> HashCPFact::copy() const
+    {
+        return std::make_shared<HashCPFact>(*this);
+    }
+
+    void HashCPFact::clear()
+    {
+        values = emptyValues();
+    }
+
+    std::unordered_set<std::shared_ptr<ir::Var>> HashCPFact::keySet() const
+    {
+        std::unordered_set<std::shared_ptr<ir::Var>> result;
+        for (const auto& [key, _] : *values) {
+            result.emplace(key);
+        }
+        return result;
+    }
+
+    std::unordered_set<std::shared_ptr<CPValue>> HashCPFact::valueSet() const
+    {
+        std::unordered_set<std::shared_ptr<CPValue>> result;
+        for (const auto& [_, value] : *values) {
+            result.emplace(CPValue::share(value));
+        }
+        return result;
+    }
+
+    bool HashCPFact::isEmpty() const
+    {
+        return values->empty();
+    }
+
+    std::size_t HashCPFact::size() const
+    {
+        return values->size();
+    }
+
+    bool HashCPFact::equalsTo(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const
+    {
+        if (!classof(other.get())) {
+            return CPFact::equalsTo(other);
+        }
+        const auto* o = static_cast<const HashCPFact*>(other.get());
+        return values == o->values || *values == *o->values;
+    }
+
+    void HashCPFact::forEach(std::function<void(std::shared_ptr<ir::Var>, std::shared_ptr<CPValue>)> processor)
+    {
+        forEachValue([&](const std::shared_ptr<ir::Var>& key, const CPValue& value) {
+            processor(key, CPValue::share(value));
+        });
+    }
+
+    const std::shared_ptr<HashCPFact::Values>& HashCPFact::emptyValues()
+    {
+        static const std::shared_ptr<Values> empty = std::make_shared<Values>();
+        return empty;
+    }
+
+    HashCPFact::Values& HashCPFact::mutableValues()
+    {
+        if (values.use_count() > 1) {
+            values = std::make_shared<Values>(*values);
+        }
+        return *values;
+    }
+
+    //// ============== DenseCPFact ============== ////
+
+    DenseCPFact::DenseCPFact(std::shared_ptr<const Universe> universe, std::shared_ptr<WideConstantTable> wideConstants)
+        : CPFact(Kind::DENSE), universe(std::move(universe)), wideConstants(std::move(wideConstants)),
+        tags(this->universe->size(), UNDEF_TAG), constants(this->universe->size(), 0),
+        formats(this->universe->size(), 0)
+    {
+
+    }
+
+    CPValue DenseCPFact::getValue(const std::shared_ptr<ir::Var>& key) const
+    {
+        std::size_t index = key->getIndex();
+        if (index < tags.size() && (*universe)[index] == key) {
+            return valueAt(index);
+        }
+        return CPValue::undef();
+    }
+
+    bool DenseCPFact::updateValue(const std::shared_ptr<ir::Var>& key, const CPValue& value)
+    {
+        return setValueAt(indexOf(key), value);
+    }
+
+    std::shared_ptr<CPValue> DenseCPFact::remove(const std::shared_ptr<ir::Var>& key)
+    {
+        std::size_t index = key->getIndex();
+        if (index >= tags.size() || (*universe)[index] != key || tags[index] == UNDEF_TAG) {
+            return nullptr;
+        }
+        std::shared_ptr<CPValue> result = CPValue::share(valueAt(index));
+        setValueAt(index, CPValue::undef());
+        return result;
+    }
+
+    bool DenseCPFact::copyFrom(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>> fact)
+    {
+        const DenseCPFact* o = sameUniverse(fact);
+        if (o == nullptr) {
+            return CPFact::copyFrom(fact);
+        }
+        if (o == this) {
+            return false;
+        }
+        bool changed = false;
+        for (std::size_t i = 0; i < tags.size(); i++) {
+            bool defined = o->tags[i] != UNDEF_TAG;
+            uint8_t tag = defined ? o->tags[i] : tags[i];
+            uint64_t constant = defined ? o->constants[i] : constants[i];
+            uint32_t format = defined ? o->formats[i] : formats[i];
+            changed |= (tag != tags[i]) | (constant != constants[i]) | (format != formats[i]);
+            tags[i] = tag;
+            constants[i] = constant;
+            formats[i] = format;
+        }
+        return changed;
+    }
+
+    bool DenseCPFact::meetWith(const DenseCPFact& other)
+    {
+        if (&other == this) {
+            return false;
+        }
+        bool changed = false;
+        for (std::size_t i = 0; i < tags.size(); i++) {
+            uint8_t otherTag = other.tags[i];
+            // an Undef value takes the other value, and two different constants meet at NAC
+            bool undef = tags[i] == UNDEF_TAG;
+            bool conflict = (tags[i] == CONSTANT_TAG) & (otherTag == CONSTANT_TAG)
+                & ((constants[i] != other.constants[i]) | (formats[i] != other.formats[i]));
+            uint8_t tag = conflict ? NAC_TAG : static_cast<uint8_t>(tags[i] | otherTag);
+            bool nac = tag == NAC_TAG;
+            uint64_t constant = nac ? 0 : (undef ? other.constants[i] : constants[i]);
+            uint32_t format = nac ? 0 : (undef ? other.formats[i] : formats[i]);
+            changed |= (tag != tags[i]) | (constant != constants[i]) | (format != formats[i]);
+            tags[i] = tag;
+            constants[i] = constant;
+            formats[i] = format;
+        }
+        return changed;
+    }
+
+    std::shared_ptr<fact::MapFact<ir::Var, CPValue>> DenseCPFact::copy() const
+    {
+        return std::make_shared<DenseCPFact>(*this);
+    }
+
+    void DenseCPFact::clear()
+    {
+        std::fill(tags.begin(), tags.end(), UNDEF_TAG);
+        std::fill(constants.begin(), constants.end(), 0);
+        std::fill(formats.begin(), formats.end(), 0);
+    }
+
+    std::unordered_set<std::shared_ptr<ir::Var>> DenseCPFact::keySet() const
+    {
+        std::unordered_set<std::shared_ptr<ir::Var>> result;
+        for (std::size_t i = 0; i < tags.size(); i++) {
+            if (tags[i] != UNDEF_TAG) {
+                result.emplace((*universe)[i]);
+            }
+        }
+        return result;
+    }
+
+    std::unordered_set<std::shared_ptr<CPValue>> DenseCPFact::valueSet() const
+    {
+        std::unordered_set<std::shared_ptr<CPValue>> result;
+        for (std::size_t i = 0; i < tags.size(); i++) {
+            if (tags[i] != UNDEF_TAG) {
+                result.emplace(CPValue::share(valueAt(i)));
+            }
+        }
+        return result;
+    }
+
+    bool DenseCPFact::isEmpty() const
+    {
+        return std::all_of(tags.begin(), tags.end(), [](uint8_t tag) {
+            return tag == UNDEF_TAG;
+        });
+    }
+
+    std::size_t DenseCPFact::size() const
+    {
+        return tags.size() - std::count(tags.begin(), tags.end(), UNDEF_TAG);
+    }
+
+    bool DenseCPFact::equalsTo(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const
+    {
+        if (const DenseCPFact* o = sameUniverse(other)) {
+            return tags == o->tags && constants == o->constants && formats == o->formats;
+        }
+        return CPFact::equalsTo(other);
+    }
+
+    void DenseCPFact::forEach(std::function<void(std::shared_ptr<ir::Var>, std::shared_ptr<CPValue>)> processor)
+    {
+        forEachValue([&](const std::shared_ptr<ir::Var>& key, const CPValue& value) {
+            processor(key, CPValue::share(value));
+        });
+    }
+
+    CPValue DenseCPFact::valueAt(std::size_t i) const
+    {
+        if (tags[i] == UNDEF_TAG) {
+            return CPValue::undef();
+        }
+        if (tags[i] == NAC_TAG) {
+            return CPValue::nac();
+        }
+        unsigned bitWidth = formats[i] >> 1;
+        CPValue value(CPValue::Kind::CONSTANT);
+        value.unsignedValue = formats[i] & 1;
+        value.bitWidth = bitWidth;
+        if (bitWidth > 64) {
+            value.wideValue = reinterpret_cast<const llvm::APSInt*>(static_cast<uintptr_t>(constants[i]));
         } else {
-            return fact::MapFact<ir::Var, CPValue>::update(key, value);
+            value.bits = constants[i];
+        }
+        return value;
+    }
+
+    bool DenseCPFact::setValueAt(std::size_t i, const CPValue& value)
+    {
+        uint8_t tag = UNDEF_TAG;
+        uint64_t constant = 0;
+        uint32_t format = 0;
+        if (value.isNAC()) {
+            tag = NAC_TAG;
+        } else if (value.isConstant()) {
+            tag = CONSTANT_TAG;
+            // a wide constant interned in the table of this fact lives as long as the fact
+            constant = value.wideValue ? reinterpret_cast<uintptr_t>(wideConstants->intern(*value.wideValue)) : value.bits;
+            format = value.bitWidth << 1 | static_cast<uint32_t>(value.unsignedValue);
         }
+        bool changed = tag != tags[i] || constant != constants[i] || format != formats[i];
+        tags[i] = tag;
+        constants[i] = constant;
+        formats[i] = format;
+        return changed;
+    }
+
+    std::size_t DenseCPFact::indexOf(const std::shared_ptr<ir::Var>& key) const
+    {
+        std::size_t index = key->getIndex();
+        if (index >= tags.size() || (*universe)[index] != key) {
+            World::getLogger().Error("Variable " + key->getName() + " is not in the universe of the dense fact");
+            throw std::runtime_error("Variable " + key->getName() + " is not in the universe of the dense fact");
+        }
+        return index;
+    }
+
+    const DenseCPFact* DenseCPFact::sameUniverse(const std::shared_ptr<fact::MapFact<ir::Var, CPValue>>& other) const
+    {
+        if (!classof(other.get())) {
+            return nullptr;
+        }
+        const auto* o = static_cast<const DenseCPFact*>(other.get());
+        return o->universe == universe && o->wideConstants == wideConstants ? o : nullptr;
+    }
+
+    //// ============== CPValue codec ============== ////
+
+    void fact::FactValueCodec<CPValue>::encode(const CPValue& value, fact::ByteWriter& writer)
+    {
+        // 0 and 1 for Undef and NAC, otherwise 2 plus the bit width and signedness of the constant
+        if (!value.isConstant()) {
+            writer.writeVarint(value.isUndef() ? 0 : 1);
+            return;
+        }
+        llvm::APSInt constant = value.getConstantValue();
+        unsigned bitWidth = constant.getBitWidth();
+        writer.writeVarint(((static_cast<uint64_t>(bitWidth) << 1) | constant.isUnsigned()) + 2);
+        if (bitWidth <= 64) {
+            if (constant.isUnsigned()) {
+                writer.writeVarint(constant.getZExtValue());
+            } else {
+                writer.writeSignedVarint(constant.getSExtValue());
+            }
+            return;
+        }
+        for (unsigned i = 0; i < constant.getNumWords(); i++) {
+            writer.writeVarint(constant.getRawData()[i]);
+        }
+    }
+
+    std::shared_ptr<CPValue> fact::FactValueCodec<CPValue>::decode(fact::ByteReader& reader)
+    {
+        uint64_t header = reader.readVarint();
+        if (header < 2) {
+            return header == 0 ? CPValue::getUndef() : CPValue::getNAC();
+        }
+        uint64_t bitWidth = (header - 2) >> 1;
+        bool isUnsigned = (header - 2) & 1;
+        if (bitWidth == 0 || bitWidth > llvm::IntegerType::MAX_INT_BITS) {
+            World::getLogger().Error("Invalid constant bit width " + std::to_string(bitWidth));
+            throw std::runtime_error("Invalid constant bit width " + std::to_string(bitWidth));
+        }
+        if (bitWidth <= 64) {
+            uint64_t bits = isUnsigned ? reader.readVarint() : static_cast<uint64_t>(reader.readSignedVarint());
+            return CPValue::makeConstant(llvm::APSInt(
+                llvm::APInt(static_cast<unsigned>(bitWidth), bits, !isUnsigned), isUnsigned));
+        }
+        std::vector<uint64_t> words((bitWidth + 63) / 64);
+        for (uint64_t& word : words) {
+            word = reader.readVarint();
+        }
+        return CPValue::makeConstant(llvm::APSInt(
+            llvm::APInt(static_cast<unsigned>(bitWidth), words), isUnsigned));
     }
 
     //// ============== CPResult ============== ////
 
-    CPResult::CPResult() = default;
+    CPResult::CPResult(std::shared_ptr<const ir::tac::TAC> myTAC)
+        :tac(std::move(myTAC)), exprIndices(), exprValues(), recorded(), recordedNum(0), wideConstants()
+    {
+        if (tac != nullptr) {
+            exprValues.resize(tac->getExprNum(), CPValue::undef());
+            recorded.resize(tac->getExprNum(), false);
+        }
+    }
+
+    void CPResult::updateExprValue(const clang::Expr* expr, const CPValue& value)
+    {
+        if (tac == nullptr) {
+            auto [it, inserted] = exprIndices.try_emplace(expr, exprValues.size());
+            if (inserted) {
+                exprValues.emplace_back(CPValue::undef());
+                recorded.emplace_back(false);
+            }
+            updateExprValueAt(it->second, value);
+            return;
+        }
+        std::size_t number = tac->getExprNumber(expr);
+        if (number == tac->getExprNum()) {
+            World::getLogger().Error("Expression is not in the three-address code of the result");
+            throw std::runtime_error("Expression is not in the three-address code of the result");
+        }
+        updateExprValueAt(number, value);
+    }
+
+    void CPResult::updateExprValueAt(std::size_t number, const CPValue& value)
+    {
+        if (!recorded[number]) {
+            recorded[number] = true;
+            recordedNum++;
+        }
+        exprValues[number] = value.internedIn(wideConstants);
+    }
 
     void CPResult::updateExprValue(const clang::Expr* expr, const std::shared_ptr<CPValue>& value)
     {
-        exprValues.insert_or_assign(expr, value);
+        updateExprValue(expr, *value);
     }
 
     std::shared_ptr<CPValue> CPResult::getExprValue(const clang::Expr* expr) const
     {
-        if (exprValues.find(expr) != exprValues.end()) {
-            return exprValues.at(expr);
+        const CPValue* value = findExprValue(expr);
+        return value != nullptr ? CPValue::share(*value) : nullptr;
+    }
+
+    const CPValue* CPResult::findExprValue(const clang::Expr* expr) const
+    {
+        std::size_t slot = slotOf(expr);
+        return slot < exprValues.size() && recorded[slot] ? &exprValues[slot] : nullptr;
+    }
+
+    std::size_t CPResult::getExprValueNum() const
+    {
+        return recordedNum;
+    }
+
+    std::size_t CPResult::slotOf(const clang::Expr* expr) const
+    {
+        if (tac != nullptr) {
+            return tac->getExprNumber(expr);
+        }
+        auto it = exprIndices.find(expr);
+        return it != exprIndices.end() ? it->second : exprValues.size();
+    }
+
+    //// ============== BoundaryCPResult ============== ////
+
+    BoundaryCPResult::BoundaryCPResult(std::shared_ptr<BoundaryDataflowResult<CPFact>> boundaryResult)
+        :CPResult(), boundaryResult(std::move(boundaryResult)), innerResult(nullptr)
+    {
+        innerResult = std::dynamic_pointer_cast<CPResult>(this->boundaryResult->getInnerResult());
+        if (innerResult == nullptr) {
+            World::getLogger().Error("The boundary result does not wrap a constant propagation result");
+            throw std::runtime_error("The boundary result does not wrap a constant propagation result");
         }
-        return nullptr;
+    }
+
+    std::shared_ptr<CPFact> BoundaryCPResult::getInFact(std::shared_ptr<ir::Stmt> node) const
+    {
+        return boundaryResult->getInFact(std::move(node));
+    }
+
+    std::shared_ptr<CPFact> BoundaryCPResult::getOutFact(std::shared_ptr<ir::Stmt> node) const
+    {
+        return boundaryResult->getOutFact(std::move(node));
+    }
+
+    void BoundaryCPResult::updateExprValue(const clang::Expr* expr, const CPValue& value)
+    {
+        innerResult->updateExprValue(expr, value);
+    }
+
+    void BoundaryCPResult::updateExprValueAt(std::size_t number, const CPValue& value)
+    {
+        innerResult->updateExprValueAt(number, value);
+    }
+
+    const CPValue* BoundaryCPResult::findExprValue(const clang::Expr* expr) const
+    {
+        return innerResult->findExprValue(expr);
+    }
+
+    std::size_t BoundaryCPResult::getExprValueNum() const
+    {
+        return innerResult->getExprValueNum();
+    }
+
+    const std::shared_ptr<BoundaryDataflowResult<CPFact>>& BoundaryCPResult::getBoundaryResult() const
+    {
+        return boundaryResult;
     }
 
     //// ============== ConstantPropagation ============== ////
@@ -122,7 +709,7 @@ namespace analyzer::analysis::dataflow {
 
             [[nodiscard]] std::shared_ptr<CPFact> newBoundaryFact() const override
             {
-                std::shared_ptr<CPFact> fact = std::make_shared<CPFact>();
+                std::shared_ptr<CPFact> fact = newInitialFact();
                 for (const std::shared_ptr<ir::Var>& param : cfg->getIR()->getParams()) {
                     if (checkVarType(param)) {
                         fact->update(param, CPValue::getNAC());
@@ -133,29 +720,87 @@ namespace analyzer::analysis::dataflow {
 
             [[nodiscard]] std::shared_ptr<CPFact> newInitialFact() const override
             {
-                return std::make_shared<CPFact>();
+                switch (factKind) {
+                    case PersistentCPFact::KIND:
+                        return std::make_shared<PersistentCPFact>();
+                    case FlatCPFact::KIND:
+                        return std::make_shared<FlatCPFact>();
+                    case CPFact::Kind::DENSE:
+                        return std::make_shared<DenseCPFact>(varUniverse, wideConstants);
+                    default:
+                        return std::make_shared<HashCPFact>(wideConstants);
+                }
             }
 
             void meetInto(std::shared_ptr<CPFact> fact,
                           std::shared_ptr<CPFact> target) const override
             {
-                fact->forEach([&](const std::shared_ptr<ir::Var>& var,
-                        const std::shared_ptr<CPValue>& value)
-                {
-                    std::shared_ptr<CPValue> targetValue = target->get(var);
-                    if (value->isConstant()) {
-                        if (targetValue->isUndef()) {
-                            target->update(var, value);
-                        } else if (targetValue->isConstant()
-                                && targetValue->getConstantValue() != value->getConstantValue()) {
-                            target->update(var, CPValue::getNAC());
-                        }
-                    } else if (value->isNAC() && !targetValue->isNAC()) {
-                        target->update(var, CPValue::getNAC());
-                    }
+                auto* denseFact = llvm::dyn_cast<DenseCPFact>(fact.get());
+                auto* denseTarget = llvm::dyn_cast<DenseCPFact>(target.get());
+                if (denseFact != nullptr && denseTarget != nullptr
+                        && denseFact->getUniverse() == denseTarget->getUniverse()
+                        && denseFact->getWideConstants() == denseTarget->getWideConstants()) {
+                    denseTarget->meetWith(*denseFact);
+                    return;
+                }
+                auto* flatFact = llvm::dyn_cast<FlatCPFact>(fact.get());
+                auto* flatTarget = llvm::dyn_cast<FlatCPFact>(target.get());
+                if (flatFact != nullptr && flatTarget != nullptr) {
+                    flatTarget->joinWith(*flatFact, [](const std::shared_ptr<CPValue>& targetValue,
+                            const std::shared_ptr<CPValue>& value) {
+                        return meetValue(value, targetValue);
+                    });
+                    return;
+                }
+                // one switch on the kind of each fact, then direct calls per mapping
+                target->visit([&](auto& concreteTarget) {
+                    fact->forEachValue([&](const std::shared_ptr<ir::Var>& var, const CPValue& value) {
+                        concreteTarget.updateValue(var, meetValue(value, concreteTarget.getValue(var)));
+                    });
                 });
             }
 
+            /**
+             * @param value a value flowing into a control flow merge
+             * @param targetValue the value already at the merge
+             * @return the meet of value and targetValue
+             */
+            static std::shared_ptr<CPValue> meetValue(const std::shared_ptr<CPValue>& value,
+                                                      const std::shared_ptr<CPValue>& targetValue)
+            {
+                if (value->isConstant()) {
+                    if (targetValue->isUndef()) {
+                        return value;
+                    }
+                    if (targetValue->isConstant() && *targetValue != *value) {
+                        return CPValue::getNAC();
+                    }
+                } else if (value->isNAC() && !targetValue->isNAC()) {
+                    return CPValue::getNAC();
+                }
+                return targetValue;
+            }
+
+            /**
+             * @param value a value flowing into a control flow merge
+             * @param targetValue the value already at the merge
+             * @return the meet of value and targetValue
+             */
+            static CPValue meetValue(const CPValue& value, const CPValue& targetValue)
+            {
+                if (value.isConstant()) {
+                    if (targetValue.isUndef()) {
+                        return value;
+                    }
+                    if (targetValue.isConstant() && targetValue != value) {
+                        return CPValue::nac();
+                    }
+                } else if (value.isNAC() && !targetValue.isNAC()) {
+                    return CPValue::nac();
+                }
+                return targetValue;
+            }
+
             [[nodiscard]] bool transferNode(
                     std::shared_ptr<ir::Stmt> stmt,
                     std::shared_ptr<CPFact> in,
@@ -163,6 +808,10 @@ namespace analyzer::analysis::dataflow {
             {
                 std::shared_ptr<fact::MapFact<ir::Var, CPValue>> oldOut = out->copy();
                 out->copyFrom(in);
+                if (tac) {
+                    executeTAC(stmt, in, out);
+                    return !out->equalsTo(oldOut);
+                }
                 const clang::Stmt* clangStmt = stmt->getClangStmt();
                 if (clangStmt != nullptr) {
                     if (auto* DeclStmt = llvm::dyn_cast<clang::DeclStmt>(clangStmt))
@@ -170,7 +819,7 @@ namespace analyzer::analysis::dataflow {
                             if (auto *varDecl = llvm::dyn_cast<clang::VarDecl>(decl))
                                 if (checkClangVarDeclType(varDecl)) {
                                     if (varDecl->hasInit()) {
-                                        out->update(mapVars.at(varDecl), calculateAndUpdateExprCPValue(varDecl->getInit(), in, out));
+                                        out->updateValue(mapVars.at(varDecl), calculateAndUpdateExprCPValue(varDecl->getInit(), in, out));
                                     }
                                 }
                     } else if (auto* expr = llvm::dyn_cast<clang::Expr>(clangStmt)) {
@@ -180,9 +829,54 @@ namespace analyzer::analysis::dataflow {
                 return !out->equalsTo(oldOut);
             }
 
-            explicit Analysis(const std::shared_ptr<graph::CFG>& myCFG)
-                : AbstractDataflowAnalysis<CPFact>(myCFG), result(std::make_shared<CPResult>())
+            void onSolved(const std::shared_ptr<fact::DataflowResult<CPFact>>& solved) override
+            {
+                if (!recordFinalExprValues) {
+                    return;
+                }
+                // every statement was last transferred from its final in fact, evaluate it once more from there,
+                // into an out fact cleared of the keys of the previous statements as the solver would start it
+                recordingExprValues = true;
+                std::shared_ptr<CPFact> scratch = newInitialFact();
+                for (const std::shared_ptr<ir::Stmt>& stmt : cfg->getNodes()) {
+                    scratch->clear();
+                    (void) transferNode(stmt, solved->getInFact(stmt), scratch);
+                }
+                recordingExprValues = false;
+            }
+
+            Analysis(const std::shared_ptr<graph::CFG>& myCFG, bool useTAC, const std::string& mapFactOption,
+                     const std::string& exprValuesOption)
+                : AbstractDataflowAnalysis<CPFact>(myCFG), result(std::make_shared<CPResult>()),
+                wideConstants(std::make_shared<WideConstantTable>()),
+                factKind(HashCPFact::KIND), varUniverse(nullptr),
+                recordingExprValues(true), recordFinalExprValues(false)
             {
+                if (mapFactOption == "persistent") {
+                    factKind = PersistentCPFact::KIND;
+                } else if (mapFactOption == "flat") {
+                    factKind = FlatCPFact::KIND;
+                } else if (mapFactOption == "dense") {
+                    factKind = CPFact::Kind::DENSE;
+                    varUniverse = std::make_shared<const DenseCPFact::Universe>(myCFG->getIR()->getVarsByIndex());
+                } else if (!mapFactOption.empty() && mapFactOption != "hash-map") {
+                    World::getLogger().Error("Unknown map fact representation: " + mapFactOption);
+                    throw std::runtime_error("Unknown map fact representation: " + mapFactOption);
+                }
+                if (exprValuesOption == "final") {
+                    recordingExprValues = false;
+                    recordFinalExprValues = true;
+                } else if (exprValuesOption == "off") {
+                    recordingExprValues = false;
+                } else if (!exprValuesOption.empty() && exprValuesOption != "full") {
+                    World::getLogger().Error("Unknown expression value recording: " + exprValuesOption);
+                    throw std::runtime_error("Unknown expression value recording: " + exprValuesOption);
+                }
+                if (useTAC) {
+                    tac = myCFG->getIR()->getTAC();
+                    temps.resize(tac->getMaxTempNum(), CPValue::undef());
+                    result = std::make_shared<CPResult>(tac);
+                }
                 for (const std::shared_ptr<ir::Var>& var : myCFG->getIR()->getVars()) {
                     const clang::VarDecl* varDecl = var->getClangVarDecl();
                     if (varDecl != nullptr && checkClangVarDeclType(varDecl)) {
@@ -197,6 +891,29 @@ namespace analyzer::analysis::dataflow {
 
             std::unordered_map<const clang::VarDecl *, std::shared_ptr<ir::Var>> mapVars;
 
+            std::shared_ptr<ir::tac::TAC> tac; ///< the three-address code to evaluate, nullptr to walk the ast
+
+            std::shared_ptr<WideConstantTable> wideConstants; ///< the constants of more than 64 bits of this analysis
+
+            mutable std::vector<CPValue> temps; ///< values of the temps of the current statement
+
+            CPFact::Kind factKind; ///< the representation of the facts
+
+            std::shared_ptr<const DenseCPFact::Universe> varUniverse; ///< the variables of dense facts, nullptr otherwise
+
+            bool recordingExprValues; ///< whether evaluations record the values of expressions in the result
+
+            bool recordFinalExprValues; ///< whether to record the values of expressions once at the fixed point
+
+            /**
+             * @param constantValue a constant
+             * @return the constant value, interned in the table of this analysis if wider than 64 bits
+             */
+            CPValue constant(const llvm::APSInt& constantValue) const
+            {
+                return CPValue::constant(constantValue, wideConstants.get());
+            }
+
             static bool checkClangVarDeclType(const clang::VarDecl *varDecl)
             {
                 return varDecl->getType()->isIntegerType();
@@ -239,20 +956,20 @@ namespace analyzer::analysis::dataflow {
                 }
             }
 
-            std::shared_ptr<CPValue> calculateAndUpdateExprCPValue(
+            CPValue calculateAndUpdateExprCPValue(
                     const clang::Expr *expr,
                     const std::shared_ptr<CPFact>& inFact,
                     const std::shared_ptr<CPFact>& outFact) const 
             {
-                std::shared_ptr<CPValue> val = nullptr;
+                CPValue val = CPValue::nac();
                 
                 if (auto* intLiteral = llvm::dyn_cast<clang::IntegerLiteral>(expr)) {
                     bool isUnsigned = !expr->getType()->isSignedIntegerType();
-                    val = CPValue::makeConstant(llvm::APSInt(intLiteral->getValue(), isUnsigned));
+                    val = constant(llvm::APSInt(intLiteral->getValue(), isUnsigned));
                 } else if (auto* characterLiteral = llvm::dyn_cast<clang::CharacterLiteral>(expr)) {
-                    val = CPValue::makeConstant(llvm::APSInt(llvm::APInt(32, characterLiteral->getValue()), false));
+                    val = constant(llvm::APSInt(llvm::APInt(32, characterLiteral->getValue()), false));
                 } else if (auto* castExpr = llvm::dyn_cast<clang::CastExpr>(expr)) {
-                    std::shared_ptr<CPValue> subExprValue =
+                    CPValue subExprValue =
                             calculateAndUpdateExprCPValue(castExpr->getSubExpr(), inFact, outFact);
                     switch (castExpr->getCastKind()) {
                         case clang::CastKind::CK_LValueToRValue:
@@ -261,7 +978,7 @@ namespace analyzer::analysis::dataflow {
                         case clang::CastKind::CK_IntegralCast: 
                         case clang::CastKind::CK_NoOp:
                         {
-                            if (subExprValue->isConstant()) {
+                            if (subExprValue.isConstant()) {
                                 if (auto* builtinTypeExpr = expr->getType()->getAs<clang::BuiltinType>()) {
                                     unsigned numBits = -1;
                                     bool isSigned = expr->getType()->isSignedIntegerType();
@@ -292,17 +1009,17 @@ namespace analyzer::analysis::dataflow {
                                             numBits = 64;
                                             break;
                                         default:
-                                            val = CPValue::getNAC();
+                                            break;
                                     }
-                                    if (val == nullptr) {
-                                        auto constantValue = subExprValue->getConstantValue();
+                                    if (numBits != static_cast<unsigned>(-1)) {
+                                        auto constantValue = subExprValue.getConstantValue();
                                         uint64_t extValue = isSigned ? constantValue.getSExtValue() 
                                                             : constantValue.getZExtValue();
-                                        val = CPValue::makeConstant(
+                                        val = constant(
                                                 llvm::APSInt(llvm::APInt(numBits, extValue, isSigned), !isSigned));
                                     }
                                 } else {
-                                    val = CPValue::getNAC();
+                                    val = CPValue::nac();
                                 }
                             } else  {
                                 val = subExprValue;
@@ -310,17 +1027,14 @@ namespace analyzer::analysis::dataflow {
                             break;
                         }
                         default:
-                            val = CPValue::getNAC();
+                            val = CPValue::nac();
                     }
                 } else if (auto* declRef = llvm::dyn_cast<clang::DeclRefExpr>(expr)) {
                     if (auto* varDecl = llvm::dyn_cast<clang::VarDecl>(declRef->getDecl())) {
                         if (checkClangVarDeclType(varDecl)) {
-                            val = inFact->get(mapVars.at(varDecl));
+                            val = inFact->getValue(mapVars.at(varDecl));
                         }
                     }
-                    if (val == nullptr) {
-                        val = CPValue::getNAC();
-                    }
                 } else if (auto* parenExpr = llvm::dyn_cast<clang::ParenExpr>(expr)) {
                     val = calculateAndUpdateExprCPValue(parenExpr->getSubExpr(), inFact, outFact);
                 } else if (auto* unaryOp = llvm::dyn_cast<clang::UnaryOperator>(expr)) {
@@ -330,10 +1044,10 @@ namespace analyzer::analysis::dataflow {
                             val = calculateAndUpdateExprCPValue(subExpr, inFact, outFact);
                             break;
                         case clang::UnaryOperatorKind::UO_Minus: {
-                            std::shared_ptr<CPValue> subExprValue =
+                            CPValue subExprValue =
                                     calculateAndUpdateExprCPValue(subExpr, inFact, outFact);
-                            if (subExprValue->isConstant()) {
-                                val = CPValue::makeConstant(-subExprValue->getConstantValue());
+                            if (subExprValue.isConstant()) {
+                                val = constant(-subExprValue.getConstantValue());
                             } else {
                                 val = subExprValue;
                             }
@@ -341,22 +1055,19 @@ namespace analyzer::analysis::dataflow {
                         }
                         default:
                             if (unaryOp->isIncrementDecrementOp()) {
-                                std::shared_ptr<CPValue> subExprValue =
+                                CPValue subExprValue =
                                         calculateAndUpdateExprCPValue(subExpr, inFact, outFact);
-                                std::shared_ptr<CPValue> exprDecOrIncValue;
-                                if (subExprValue->isConstant()) {
-                                    auto constantValue = subExprValue->getConstantValue();
-                                    auto newValue = llvm::APSInt(constantValue);
+                                CPValue exprDecOrIncValue = subExprValue;
+                                if (subExprValue.isConstant()) {
+                                    llvm::APSInt newValue = subExprValue.getConstantValue();
                                     if (unaryOp->isIncrementOp()) {
-                                        exprDecOrIncValue = CPValue::makeConstant(++newValue);
+                                        exprDecOrIncValue = constant(++newValue);
                                     } else {
-                                        exprDecOrIncValue = CPValue::makeConstant(--newValue);
+                                        exprDecOrIncValue = constant(--newValue);
                                     }
-                                } else {
-                                    exprDecOrIncValue = subExprValue;
                                 }
                                 if (auto var = getVarFromExpr(subExpr)) {
-                                    outFact->update(var, exprDecOrIncValue);
+                                    outFact->updateValue(var, exprDecOrIncValue);
                                 }
                                 if(unaryOp->isPostfix()) {
                                     val = subExprValue;
@@ -364,88 +1075,88 @@ namespace analyzer::analysis::dataflow {
                                     val = exprDecOrIncValue;
                                 }
                             } else {
-                                val = CPValue::getNAC();
+                                val = CPValue::nac();
                             }
                     }
                 } else if (auto* binaryOperator = llvm::dyn_cast<clang::BinaryOperator>(expr)) {
                     clang::Expr* lhs = binaryOperator->getLHS();
                     clang::Expr* rhs = binaryOperator->getRHS();
-                    std::shared_ptr<CPValue> lhsValue =
+                    CPValue lhsValue =
                             calculateAndUpdateExprCPValue(lhs, inFact, outFact);
-                    std::shared_ptr<CPValue> rhsValue =
+                    CPValue rhsValue =
                             calculateAndUpdateExprCPValue(rhs, inFact, outFact);
                     if (binaryOperator->getOpcode() == clang::BinaryOperatorKind::BO_Assign) {
                         if (auto var = getVarFromExpr(lhs)) {
-                            outFact->update(var, rhsValue);
+                            outFact->updateValue(var, rhsValue);
                         }
                         val = rhsValue;
                     } else {
-                        if (lhsValue->isNAC() || rhsValue->isNAC()) {
+                        if (lhsValue.isNAC() || rhsValue.isNAC()) {
                             switch (binaryOperator->getOpcode()) {
                                 case clang::BinaryOperatorKind::BO_Div:
                                 case clang::BinaryOperatorKind::BO_DivAssign:
                                 case clang::BinaryOperatorKind::BO_Rem:
                                 case clang::BinaryOperatorKind::BO_RemAssign:
-                                    if(rhsValue->isConstant() && rhsValue->getConstantValue().isZero()) {
-                                        val = CPValue::getUndef();
+                                    if(rhsValue.isConstant() && rhsValue.getConstantValue().isZero()) {
+                                        val = CPValue::undef();
                                     } else {
-                                        val = CPValue::getNAC();
+                                        val = CPValue::nac();
                                     }
                                     break;
                                 default:
-                                    val = CPValue::getNAC();
+                                    val = CPValue::nac();
                             }
-                        } else if (lhsValue->isConstant() && rhsValue->isConstant()) {
-                            llvm::APSInt lhsConstant = lhsValue->getConstantValue();
-                            llvm::APSInt rhsConstant = rhsValue->getConstantValue();
+                        } else if (lhsValue.isConstant() && rhsValue.isConstant()) {
+                            llvm::APSInt lhsConstant = lhsValue.getConstantValue();
+                            llvm::APSInt rhsConstant = rhsValue.getConstantValue();
                             switch (binaryOperator->getOpcode()) {
                                 case clang::BinaryOperatorKind::BO_Add:
                                 case clang::BinaryOperatorKind::BO_AddAssign:
-                                    val = CPValue::makeConstant(lhsConstant + rhsConstant);
+                                    val = constant(lhsConstant + rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Sub:
                                 case clang::BinaryOperatorKind::BO_SubAssign:
-                                    val = CPValue::makeConstant(lhsConstant - rhsConstant);
+                                    val = constant(lhsConstant - rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Mul:
                                 case clang::BinaryOperatorKind::BO_MulAssign:
-                                    val = CPValue::makeConstant(lhsConstant * rhsConstant);
+                                    val = constant(lhsConstant * rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Div:
                                 case clang::BinaryOperatorKind::BO_DivAssign:
                                     if (rhsConstant.isZero()) {
-                                        val = CPValue::getUndef();
+                                        val = CPValue::undef();
                                     } else {
-                                        val = CPValue::makeConstant(lhsConstant / rhsConstant);
+                                        val = constant(lhsConstant / rhsConstant);
                                     }
                                     break;
                                 case clang::BinaryOperatorKind::BO_Rem:
                                 case clang::BinaryOperatorKind::BO_RemAssign:
                                     if (rhsConstant.isZero()) {
-                                        val = CPValue::getUndef();
+                                        val = CPValue::undef();
                                     } else {
-                                        val = CPValue::makeConstant(lhsConstant % rhsConstant);
+                                        val = constant(lhsConstant % rhsConstant);
                                     }
                                     break;
                                 case clang::BinaryOperatorKind::BO_And:
                                 case clang::BinaryOperatorKind::BO_AndAssign:
-                                    val = CPValue::makeConstant(lhsConstant & rhsConstant);
+                                    val = constant(lhsConstant & rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Or:
                                 case clang::BinaryOperatorKind::BO_OrAssign:
-                                    val = CPValue::makeConstant(lhsConstant | rhsConstant);
+                                    val = constant(lhsConstant | rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Xor:
                                 case clang::BinaryOperatorKind::BO_XorAssign:
-                                    val = CPValue::makeConstant(lhsConstant ^ rhsConstant);
+                                    val = constant(lhsConstant ^ rhsConstant);
                                     break;
                                 case clang::BinaryOperatorKind::BO_Shl:
                                 case clang::BinaryOperatorKind::BO_ShlAssign: {
                                     unsigned int shiftAmount = rhsConstant.getLimitedValue();
                                     if (shiftAmount >= lhsConstant.getBitWidth()) {
-                                        val = CPValue::getNAC();
+                                        val = CPValue::nac();
                                     } else {
-                                        val = CPValue::makeConstant(lhsConstant << shiftAmount);
+                                        val = constant(lhsConstant << shiftAmount);
                                     }
                                     break;
                                 }
@@ -453,48 +1164,187 @@ namespace analyzer::analysis::dataflow {
                                 case clang::BinaryOperatorKind::BO_ShrAssign: {
                                     unsigned int shiftAmount = rhsConstant.getLimitedValue();
                                     if (shiftAmount >= lhsConstant.getBitWidth()) {
-                                        val = CPValue::getNAC();
+                                        val = CPValue::nac();
                                     } else {
-                                        val = CPValue::makeConstant(lhsConstant >> shiftAmount);
+                                        val = constant(lhsConstant >> shiftAmount);
                                     }
                                     break;
                                 }
                                 default:
-                                    val = CPValue::getNAC();
+                                    val = CPValue::nac();
                                     break;
                             }
                         } else {
-                            val = CPValue::getUndef();
+                            val = CPValue::undef();
                         }
                         if (OpcodeIsAssign(binaryOperator->getOpcode())) {
                             if (auto var = getVarFromExpr(lhs)) {
-                                outFact->update(var, val);
+                                outFact->updateValue(var, val);
                             }
                         }
                     }
                 } else if (auto *arraySubscriptExpr = llvm::dyn_cast<clang::ArraySubscriptExpr>(expr)) {
                     calculateAndUpdateExprCPValue(arraySubscriptExpr->getBase(), inFact, outFact);
                     calculateAndUpdateExprCPValue(arraySubscriptExpr->getIdx(), inFact, outFact);
-                    val = CPValue::getNAC();
+                    val = CPValue::nac();
                 } else if (auto* conditionalOperator = llvm::dyn_cast<clang::ConditionalOperator>(expr)) {
                     calculateAndUpdateExprCPValue(conditionalOperator->getCond(), inFact, outFact);
                     calculateAndUpdateExprCPValue(conditionalOperator->getTrueExpr(), inFact, outFact);
                     calculateAndUpdateExprCPValue(conditionalOperator->getFalseExpr(), inFact, outFact);
-                    val = CPValue::getNAC();
+                    val = CPValue::nac();
                 } else if(auto* callExpr = llvm::dyn_cast<clang::CallExpr>(expr)) {
                     calculateAndUpdateExprCPValue(callExpr->getCallee(), inFact, outFact);
                     for(const clang::Expr* arg : callExpr->arguments()) {
                         calculateAndUpdateExprCPValue(arg, inFact, outFact);
                     }
-                    val = CPValue::getNAC();
+                    val = CPValue::nac();
                 } else {
-                    val = CPValue::getNAC();
+                    val = CPValue::nac();
                 }
 
-                result->updateExprValue(expr, val);
+                if (recordingExprValues) {
+                    result->updateExprValue(expr, val);
+                }
                 return val;
             }
 
+            /**
+             * @brief evaluate the three-address code of stmt, the same way as calculateAndUpdateExprCPValue
+             * @param stmt the statement to evaluate
+             * @param in the fact before stmt, which variables are loaded from
+             * @param out the fact after stmt, which variables are stored to
+             */
+            void executeTAC(const std::shared_ptr<ir::Stmt>& stmt,
+                            const std::shared_ptr<CPFact>& in,
+                            const std::shared_ptr<CPFact>& out) const
+            {
+                using ir::tac::Opcode;
+                // the instructions over facts of known representations, whose methods are called directly
+                auto execute = [&](const auto& inFact, auto& outFact) {
+                    for (const ir::tac::Instruction& instruction : tac->getInstructionsOf(stmt)) {
+                        switch (instruction.opcode) {
+                            case Opcode::CONST:
+                                temps[instruction.dst] = constant(tac->getConstant(instruction.a));
+                                break;
+                            case Opcode::LOAD:
+                                temps[instruction.dst] = inFact.getValue(tac->getVar(instruction.a));
+                                break;
+                            case Opcode::UNKNOWN:
+                                temps[instruction.dst] = CPValue::nac();
+                                break;
+                            case Opcode::CAST: {
+                                const CPValue& subValue = temps[instruction.a];
+                                if (!subValue.isConstant()) {
+                                    temps[instruction.dst] = subValue;
+                                } else if (instruction.width == 0) {
+                                    temps[instruction.dst] = CPValue::nac();
+                                } else {
+                                    llvm::APSInt constantValue = subValue.getConstantValue();
+                                    uint64_t extValue = instruction.isSigned ? constantValue.getSExtValue()
+                                                        : constantValue.getZExtValue();
+                                    temps[instruction.dst] = constant(llvm::APSInt(
+                                            llvm::APInt(instruction.width, extValue, instruction.isSigned),
+                                            !instruction.isSigned));
+                                }
+                                break;
+                            }
+                            case Opcode::NEG: {
+                                const CPValue& subValue = temps[instruction.a];
+                                temps[instruction.dst] = subValue.isConstant() ?
+                                        constant(-subValue.getConstantValue()) : subValue;
+                                break;
+                            }
+                            case Opcode::INC:
+                            case Opcode::DEC: {
+                                const CPValue& subValue = temps[instruction.a];
+                                if (subValue.isConstant()) {
+                                    llvm::APSInt newValue(subValue.getConstantValue());
+                                    temps[instruction.dst] = constant(
+                                            instruction.opcode == Opcode::INC ? ++newValue : --newValue);
+                                } else {
+                                    temps[instruction.dst] = subValue;
+                                }
+                                break;
+                            }
+                            case Opcode::BINARY:
+                                temps[instruction.dst] = evaluateBinary(instruction.binaryOp,
+                                    temps[instruction.a], temps[instruction.b]);
+                                break;
+                            case Opcode::STORE:
+                                outFact.updateValue(tac->getVar(instruction.dst), temps[instruction.a]);
+                                break;
+                        }
+                    }
+                };
+                out->visit([&](auto& outFact) {
+                    using Fact = std::decay_t<decltype(outFact)>;
+                    if (in->getKind() == Fact::KIND) {
+                        execute(static_cast<const Fact&>(*in), outFact);
+                    } else {
+                        execute(static_cast<const CPFact&>(*in), outFact);
+                    }
+                });
+                if (recordingExprValues) {
+                    for (const ir::tac::ExprTemp& exprTemp : tac->getExprTempsOf(stmt)) {
+                        result->updateExprValueAt(exprTemp.number, temps[exprTemp.temp]);
+                    }
+                }
+            }
+
+            /**
+             * @param op the binary operator
+             * @param lhsValue the value of the left operand
+             * @param rhsValue the value of the right operand
+             * @return the value of the binary operation
+             */
+            CPValue evaluateBinary(ir::tac::BinaryOp op, const CPValue& lhsValue, const CPValue& rhsValue) const
+            {
+                using ir::tac::BinaryOp;
+                if (lhsValue.isNAC() || rhsValue.isNAC()) {
+                    if ((op == BinaryOp::DIV || op == BinaryOp::REM)
+                            && rhsValue.isConstant() && rhsValue.getConstantValue().isZero()) {
+                        return CPValue::undef();
+                    }
+                    return CPValue::nac();
+                }
+                if (!lhsValue.isConstant() || !rhsValue.isConstant()) {
+                    return CPValue::undef();
+                }
+                llvm::APSInt lhsConstant = lhsValue.getConstantValue();
+                llvm::APSInt rhsConstant = rhsValue.getConstantValue();
+                switch (op) {
+                    case BinaryOp::ADD:
+                        return constant(lhsConstant + rhsConstant);
+                    case BinaryOp::SUB:
+                        return constant(lhsConstant - rhsConstant);
+                    case BinaryOp::MUL:
+                        return constant(lhsConstant * rhsConstant);
+                    case BinaryOp::DIV:
+                        return rhsConstant.isZero() ? CPValue::undef()
+                            : constant(lhsConstant / rhsConstant);
+                    case BinaryOp::REM:
+                        return rhsConstant.isZero() ? CPValue::undef()
+                            : constant(lhsConstant % rhsConstant);
+                    case BinaryOp::AND:
+                        return constant(lhsConstant & rhsConstant);
+                    case BinaryOp::OR:
+                        return constant(lhsConstant | rhsConstant);
+                    case BinaryOp::XOR:
+                        return constant(lhsConstant ^ rhsConstant);
+                    case BinaryOp::SHL:
+                    case BinaryOp::SHR: {
+                        unsigned int shiftAmount = rhsConstant.getLimitedValue();
+                        if (shiftAmount >= lhsConstant.getBitWidth()) {
+                            return CPValue::nac();
+                        }
+                        return constant(op == BinaryOp::SHL ?
+                            lhsConstant << shiftAmount : lhsConstant >> shiftAmount);
+                    }
+                    default:
+                        return CPValue::nac();
+                }
+            }
+
             [[nodiscard]] std::shared_ptr<fact::DataflowResult<CPFact>>
                 getResult() const override
             {
@@ -503,7 +1353,14 @@ namespace analyzer::analysis::dataflow {
 
         };
 
-        return std::make_unique<Analysis>(cfg);
+        return std::make_unique<Analysis>(cfg, analysisConfig->getBoolOption("use-tac"),
+            analysisConfig->getOption("map-fact"), analysisConfig->getOption("expr-values"));
+    }
+
+    std::shared_ptr<fact::DataflowResult<CPFact>>
+        ConstantPropagation::wrapBoundaryResult(const std::shared_ptr<BoundaryDataflowResult<CPFact>>& boundaryResult) const
+    {
+        return std::make_shared<BoundaryCPResult>(boundaryResult);
     }
 
 }
@@ -26,7 +26,7 @@ namespace analyzer::analysis::dataflow {
 
             [[nodiscard]] std::shared_ptr<fact::SetFact<ir::Var>> newInitialFact() const override
             {
-                return std::make_shared<fact::SetFact<ir::Var>>();
+                return factBuilder.newSetFact();
             }
 
             void meetInto(std::shared_ptr<fact::SetFact<ir::Var>> fact,
@@ -51,14 +51,36 @@ namespace analyzer::analysis::dataflow {
                 return !in->equalsTo(oldIn);
             }
 
+            [[nodiscard]] bool supportsDeltaTransfer() const override
+            {
+                return true;
+            }
+
+            [[nodiscard]] std::shared_ptr<fact::SetFact<ir::Var>> transferNodeDelta(
+                    std::shared_ptr<ir::Stmt> stmt,
+                    std::shared_ptr<fact::SetFact<ir::Var>> delta,
+                    std::shared_ptr<fact::SetFact<ir::Var>> in,
+                    std::shared_ptr<fact::SetFact<ir::Var>> out) const override
+            {
+                std::shared_ptr<fact::SetFact<ir::Var>> added = delta->copy();
+                for (const std::shared_ptr<ir::Var>& def : stmt->getDefs()) {
+                    added->remove(def);
+                }
+                added->removeAll(in);
+                in->unionN(added);
+                return added;
+            }
+
             [[nodiscard]] std::shared_ptr<fact::DataflowResult<fact::SetFact<ir::Var>>>
                 getResult() const override
             {
                 return result;
             }
 
-            explicit Analysis(const std::shared_ptr<graph::CFG>& myCFG)
-                    : AbstractDataflowAnalysis<fact::SetFact<ir::Var>>(myCFG)
+            Analysis(const std::shared_ptr<graph::CFG>& myCFG, const std::string& setFactOption)
+                    : AbstractDataflowAnalysis<fact::SetFact<ir::Var>>(myCFG),
+                    factBuilder(setFactOption, std::make_shared<const fact::SetFactBuilder<ir::Var>::Universe>(
+                        myCFG->getIR()->getVarsByIndex()))
             {
                 result = std::make_shared<fact::DataflowResult<fact::SetFact<ir::Var>>>();
             }
@@ -67,9 +89,11 @@ namespace analyzer::analysis::dataflow {
 
             std::shared_ptr<fact::DataflowResult<fact::SetFact<ir::Var>>> result;
 
+            fact::SetFactBuilder<ir::Var> factBuilder;
+
         };
 
-        return std::make_unique<Analysis>(cfg);
+        return std::make_unique<Analysis>(cfg, analysisConfig->getOption("set-fact"));
     }
 
 }
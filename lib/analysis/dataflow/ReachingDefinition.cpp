@@ -1,4 +1,5 @@
 #include "analysis/dataflow/ReachingDefinition.h"
+#include "ir/DefUseIndex.h"
 
 namespace analyzer::analysis::dataflow {
 
@@ -27,7 +28,7 @@ namespace analyzer::analysis::dataflow {
 
             [[nodiscard]] std::shared_ptr<fact::SetFact<ir::Stmt>> newInitialFact() const override
             {
-                return std::make_shared<fact::SetFact<ir::Stmt>>();
+                return factBuilder.newSetFact();
             }
 
             void meetInto(std::shared_ptr<fact::SetFact<ir::Stmt>> fact,
@@ -44,7 +45,9 @@ namespace analyzer::analysis::dataflow {
                 std::shared_ptr<fact::SetFact<ir::Stmt>> oldOut = out->copy();
                 out->setSetFact(in);
                 for (const std::shared_ptr<ir::Var>& def : stmt->getDefs()) {
-                    out->removeAll(defs.at(def));
+                    for (const std::shared_ptr<ir::Stmt>& s : defUseIndex->getDefiningStmtsOf(def)) {
+                        out->remove(s);
+                    }
                 }
                 if (!stmt->getDefs().empty()) {
                     out->add(stmt);
@@ -52,16 +55,41 @@ namespace analyzer::analysis::dataflow {
                 return !out->equalsTo(oldOut);
             }
 
+            [[nodiscard]] bool supportsDeltaTransfer() const override
+            {
+                return true;
+            }
+
+            [[nodiscard]] std::shared_ptr<fact::SetFact<ir::Stmt>> transferNodeDelta(
+                    std::shared_ptr<ir::Stmt> stmt,
+                    std::shared_ptr<fact::SetFact<ir::Stmt>> delta,
+                    std::shared_ptr<fact::SetFact<ir::Stmt>> in,
+                    std::shared_ptr<fact::SetFact<ir::Stmt>> out) const override
+            {
+                std::shared_ptr<fact::SetFact<ir::Stmt>> added = delta->copy();
+                for (const std::shared_ptr<ir::Var>& def : stmt->getDefs()) {
+                    for (const std::shared_ptr<ir::Stmt>& s : defUseIndex->getDefiningStmtsOf(def)) {
+                        added->remove(s);
+                    }
+                }
+                added->removeAll(out);
+                out->unionN(added);
+                return added;
+            }
+
             [[nodiscard]] std::shared_ptr<fact::DataflowResult<fact::SetFact<ir::Stmt>>>
                     getResult() const override
             {
                 return result;
             }
 
-            explicit Analysis(const std::shared_ptr<graph::CFG>& myCFG)
-                : AbstractDataflowAnalysis<fact::SetFact<ir::Stmt>>(myCFG)
+            Analysis(const std::shared_ptr<graph::CFG>& myCFG, const std::string& setFactOption)
+                : AbstractDataflowAnalysis<fact::SetFact<ir::Stmt>>(myCFG),
+                // the nodes of the cfg are indexed by Stmt::getIndex(), share them with the cfg
+                factBuilder(setFactOption, std::shared_ptr<const fact::SetFactBuilder<ir::Stmt>::Universe>(
+                    myCFG, &myCFG->getNodes()))
             {
-                computeDefs(cfg->getIR());
+                defUseIndex = cfg->getIR()->getDefUseIndex();
                 result = std::make_shared<fact::DataflowResult<fact::SetFact<ir::Stmt>>>();
             }
 
@@ -69,23 +97,13 @@ namespace analyzer::analysis::dataflow {
 
             std::shared_ptr<fact::DataflowResult<fact::SetFact<ir::Stmt>>> result;
 
-            void computeDefs(const std::shared_ptr<ir::IR>& myIR)
-            {
-                for (const std::shared_ptr<ir::Var>& var : myIR->getVars()) {
-                    defs.emplace(var, std::make_shared<fact::SetFact<ir::Stmt>>());
-                }
-                for (const std::shared_ptr<ir::Stmt>& stmt : myIR->getStmts()) {
-                    for (const std::shared_ptr<ir::Var>& var : stmt->getDefs()) {
-                        defs.at(var)->add(stmt);
-                    }
-                }
-            }
+            std::shared_ptr<ir::DefUseIndex> defUseIndex;
 
-            std::unordered_map<std::shared_ptr<ir::Var>, std::shared_ptr<fact::SetFact<ir::Stmt>>> defs;
+            fact::SetFactBuilder<ir::Stmt> factBuilder;
 
         };
 
-        return std::make_unique<Analysis>(cfg);
+        return std::make_unique<Analysis>(cfg, analysisConfig->getOption("set-fact"));
     }
 
 }
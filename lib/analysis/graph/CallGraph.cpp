@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <unordered_set>
+
+#include <clang/AST/RecursiveASTVisitor.h>
+
+#include "analysis/graph/CallGraph.h"
+#include "World.h"
+
+namespace analyzer::analysis::graph {
+
+    namespace {
+
+        /**
+         * @brief collect the qualified names of a class and all its base classes
+         * @param recordDecl a class declaration
+         * @param[out] classNames the collected class names
+         */
+        void collectClassNames(const clang::CXXRecordDecl* recordDecl, std::unordered_set<std::string>& classNames)
+        {
+            if (!classNames.emplace(recordDecl->getQualifiedNameAsString()).second || !recordDecl->hasDefinition()) {
+                return;
+            }
+            for (const clang::CXXBaseSpecifier& base : recordDecl->bases()) {
+                if (const clang::CXXRecordDecl* baseDecl = base.getType()->getAsCXXRecordDecl()) {
+                    collectClassNames(baseDecl, classNames);
+                }
+            }
+        }
+
+        /**
+         * @brief collect the signatures of a method and all methods it overrides, transitively
+         * @param methodDecl a method declaration
+         * @param[out] signatures the collected signatures
+         */
+        void collectOverriddenSignatures(const clang::CXXMethodDecl* methodDecl,
+                                         std::unordered_set<std::string>& signatures)
+        {
+            if (!signatures.emplace(lang::generateFunctionSignature(methodDecl)).second) {
+                return;
+            }
+            for (const clang::CXXMethodDecl* overridden : methodDecl->overridden_methods()) {
+                collectOverriddenSignatures(overridden, signatures);
+            }
+        }
+
+        /**
+         * @class CallExprCollector
+         * @brief collects all call and constructor call expressions in a function body, in source order
+         */
+        class CallExprCollector: public clang::RecursiveASTVisitor<CallExprCollector> {
+        public:
+
+            std::vector<const clang::Expr*> callExprs; ///< the collected call expressions
+
+            bool VisitCallExpr(clang::CallExpr* callExpr)
+            {
+                callExprs.emplace_back(callExpr);
+                return true;
+            }
+
+            bool VisitCXXConstructExpr(clang::CXXConstructExpr* constructExpr)
+            {
+                callExprs.emplace_back(constructExpr);
+                return true;
+            }
+
+        };
+
+    }
+
+    CallGraph::CallGraph(const std::unordered_map<std::string, std::shared_ptr<lang::CPPMethod>>& allMethods,
+                         bool resolveVirtualCalls, std::size_t threadNum)
+    {
+        World::getLogger().Progress("Building call graph of " + std::to_string(allMethods.size()) + " methods ...");
+
+        // number the methods by signature
+        std::vector<std::string> signatures;
+        signatures.reserve(allMethods.size());
+        for (const auto& [signature, _] : allMethods) {
+            signatures.emplace_back(signature);
+        }
+        std::sort(signatures.begin(), signatures.end());
+        std::unordered_map<std::string, std::size_t> signatureIds;
+        for (const std::string& signature : signatures) {
+            signatureIds.emplace(signature, methods.size());
+            methodIds.emplace(allMethods.at(signature).get(), methods.size());
+            methods.emplace_back(allMethods.at(signature));
+        }
+        std::size_t n = methods.size();
+
+        // class hierarchy: the overriders of each virtual method, and the classes each overrider is a subclass of
+        std::unordered_map<std::string, std::vector<std::size_t>> overridersOf;
+        std::vector<std::unordered_set<std::string>> subclassOf(n);
+        if (resolveVirtualCalls) {
+            for (std::size_t id = 0; id < n; id++) {
+                const auto* methodDecl = llvm::dyn_cast<clang::CXXMethodDecl>(methods[id]->getFunctionDecl());
+                if (!methodDecl || !methodDecl->isVirtual()) {
+                    continue;
+                }
+                std::unordered_set<std::string> overridden;
+                collectOverriddenSignatures(methodDecl, overridden);
+                for (const std::string& signature : overridden) {
+                    overridersOf[signature].emplace_back(id);
+                }
+                collectClassNames(methodDecl->getParent(), subclassOf[id]);
+            }
+        }
+
+        // resolve the call sites of each method in parallel, every worker writes to its own methods only
+        std::vector<std::vector<CallSite>> sitesOf(n);
+        auto resolve = [&](std::size_t id) {
+            CallExprCollector collector;
+            collector.TraverseStmt(methods[id]->getFunctionDecl()->getBody());
+            std::vector<std::size_t> targets;
+            for (const clang::Expr* callExpr : collector.callExprs) {
+                const clang::FunctionDecl* calleeDecl = nullptr;
+                if (const auto* constructExpr = llvm::dyn_cast<clang::CXXConstructExpr>(callExpr)) {
+                    calleeDecl = constructExpr->getConstructor();
+                } else {
+                    calleeDecl = llvm::cast<clang::CallExpr>(callExpr)->getDirectCallee();
+                }
+                if (!calleeDecl) {
+                    continue;
+                }
+                std::string signature = lang::generateFunctionSignature(calleeDecl);
+                targets.clear();
+                const auto* memberCall = llvm::dyn_cast<clang::CXXMemberCallExpr>(callExpr);
+                const auto* methodDecl = llvm::dyn_cast<clang::CXXMethodDecl>(calleeDecl);
+                const auto* memberExpr = memberCall ?
+                    llvm::dyn_cast<clang::MemberExpr>(memberCall->getCallee()->IgnoreParens()) : nullptr;
+                if (resolveVirtualCalls && methodDecl && methodDecl->isVirtual()
+                        && memberExpr && !memberExpr->hasQualifier() && memberCall->getRecordDecl()) {
+                    // an overrider may be called if its class and the static receiver class are related
+                    const clang::CXXRecordDecl* receiverDecl = memberCall->getRecordDecl();
+                    std::string receiver = receiverDecl->getQualifiedNameAsString();
+                    std::unordered_set<std::string> receiverBases;
+                    collectClassNames(receiverDecl, receiverBases);
+                    auto it = overridersOf.find(signature);
+                    if (it != overridersOf.end()) {
+                        for (std::size_t overrider : it->second) {
+                            const clang::CXXRecordDecl* overriderClass = llvm::cast<clang::CXXMethodDecl>(
+                                methods[overrider]->getFunctionDecl())->getParent();
+                            if (subclassOf[overrider].count(receiver)
+                                    || receiverBases.count(overriderClass->getQualifiedNameAsString())) {
+                                targets.emplace_back(overrider);
+                            }
+                        }
+                    }
+                } else if (auto it = signatureIds.find(signature); it != signatureIds.end()) {
+                    targets.emplace_back(it->second);
+                }
+                std::sort(targets.begin(), targets.end());
+                targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+                for (std::size_t target : targets) {
+                    sitesOf[id].push_back(CallSite{callExpr, target});
+                }
+            }
+        };
+        if (threadNum == 0) {
+            threadNum = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadNum = std::max<std::size_t>(1, std::min(threadNum, n));
+        std::atomic<std::size_t> next(0);
+        std::vector<std::exception_ptr> errors(threadNum);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threadNum; t++) {
+            workers.emplace_back([&, t]() {
+                try {
+                    for (std::size_t id = next++; id < n; id = next++) {
+                        resolve(id);
+                    }
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                    next = n;
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // freeze into compressed sparse rows
+        std::vector<std::pair<std::size_t, std::size_t>> edges; // (caller, callee)
+        callSiteOffsets.assign(n + 1, 0);
+        for (std::size_t id = 0; id < n; id++) {
+            callSites.insert(callSites.end(), sitesOf[id].begin(), sitesOf[id].end());
+            callSiteOffsets[id + 1] = callSites.size();
+            for (const CallSite& site : sitesOf[id]) {
+                edges.emplace_back(id, site.callee);
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        calleeOffsets.assign(n + 1, 0);
+        callerOffsets.assign(n + 1, 0);
+        callees.reserve(edges.size());
+        for (const auto& [caller, callee] : edges) {
+            calleeOffsets[caller + 1]++;
+            callerOffsets[callee + 1]++;
+            callees.emplace_back(callee);
+        }
+        for (std::size_t id = 0; id < n; id++) {
+            calleeOffsets[id + 1] += calleeOffsets[id];
+            callerOffsets[id + 1] += callerOffsets[id];
+        }
+        // edges are sorted by caller, so the callers of each callee are filled in sorted order
+        callers.resize(edges.size());
+        std::vector<std::size_t> cursor(callerOffsets.begin(), callerOffsets.end() - 1);
+        for (const auto& [caller, callee] : edges) {
+            callers[cursor[callee]++] = caller;
+        }
+
+        World::getLogger().Success("Call graph built: " + std::to_string(n) + " methods, "
+            + std::to_string(getEdgeNum()) + " edges, " + std::to_string(callSites.size()) + " call sites");
+    }
+
+    std::size_t CallGraph::getMethodNum() const
+    {
+        return methods.size();
+    }
+
+    std::size_t CallGraph::getEdgeNum() const
+    {
+        return callees.size();
+    }
+
+    const std::shared_ptr<lang::CPPMethod>& CallGraph::getMethod(std::size_t id) const
+    {
+        return methods[id];
+    }
+
+    std::size_t CallGraph::getMethodId(const lang::CPPMethod& method) const
+    {
+        auto it = methodIds.find(&method);
+        return it == methodIds.end() ? methods.size() : it->second;
+    }
+
+    llvm::ArrayRef<std::size_t> CallGraph::getCalleeIdsOf(std::size_t id) const
+    {
+        return llvm::ArrayRef<std::size_t>(callees).slice(calleeOffsets[id], calleeOffsets[id + 1] - calleeOffsets[id]);
+    }
+
+    llvm::ArrayRef<std::size_t> CallGraph::getCallerIdsOf(std::size_t id) const
+    {
+        return llvm::ArrayRef<std::size_t>(callers).slice(callerOffsets[id], callerOffsets[id + 1] - callerOffsets[id]);
+    }
+
+    llvm::ArrayRef<CallSite> CallGraph::getCallSitesOf(std::size_t id) const
+    {
+        return llvm::ArrayRef<CallSite>(callSites).slice(callSiteOffsets[id],
+            callSiteOffsets[id + 1] - callSiteOffsets[id]);
+    }
+
+    bool CallGraph::hasEdge(std::size_t caller, std::size_t callee) const
+    {
+        llvm::ArrayRef<std::size_t> calleeIds = getCalleeIdsOf(caller);
+        return std::binary_search(calleeIds.begin(), calleeIds.end(), callee);
+    }
+
+} // graph
@@ -1,9 +1,62 @@
 #include <utility>
+#include <algorithm>
+#include <set>
 
 #include "analysis/graph/CFG.h"
+#include "analysis/graph/Dominators.h"
+#include "analysis/graph/WeakTopologicalOrder.h"
+#include "ir/Stmt.h"
 
 namespace analyzer::analysis::graph {
 
+    namespace {
+
+        /**
+         * @brief group edges by one of their endpoints into compressed sparse rows
+         * @param n the number of nodes
+         * @param edges all edges
+         * @param keys the index of the grouping endpoint of each edge
+         * @param values the index of the other endpoint of each edge
+         * @param[out] edgeOffsets row offsets of the grouped edges
+         * @param[out] groupedEdges edges grouped by keys
+         * @param[out] adjOffsets row offsets of the adjacent nodes
+         * @param[out] adj sorted and duplicate-free adjacent node indices of each row
+         */
+        void buildRows(std::size_t n, const std::vector<std::shared_ptr<CFGEdge>>& edges,
+                       const std::vector<std::size_t>& keys, const std::vector<std::size_t>& values,
+                       std::vector<std::size_t>& edgeOffsets, std::vector<std::shared_ptr<CFGEdge>>& groupedEdges,
+                       std::vector<std::size_t>& adjOffsets, std::vector<std::size_t>& adj)
+        {
+            edgeOffsets.assign(n + 1, 0);
+            for (std::size_t key : keys) {
+                edgeOffsets[key + 1]++;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                edgeOffsets[i + 1] += edgeOffsets[i];
+            }
+            std::vector<std::size_t> cursor(edgeOffsets.begin(), edgeOffsets.end() - 1);
+            std::vector<std::size_t> groupedValues(edges.size());
+            groupedEdges.assign(edges.size(), nullptr);
+            for (std::size_t i = 0; i < edges.size(); i++) {
+                std::size_t pos = cursor[keys[i]]++;
+                groupedEdges[pos] = edges[i];
+                groupedValues[pos] = values[i];
+            }
+            adjOffsets.assign(n + 1, 0);
+            adj.clear();
+            adj.reserve(edges.size());
+            for (std::size_t i = 0; i < n; i++) {
+                std::size_t begin = adj.size();
+                adj.insert(adj.end(), groupedValues.begin() + static_cast<std::ptrdiff_t>(edgeOffsets[i]),
+                           groupedValues.begin() + static_cast<std::ptrdiff_t>(edgeOffsets[i + 1]));
+                std::sort(adj.begin() + static_cast<std::ptrdiff_t>(begin), adj.end());
+                adj.erase(std::unique(adj.begin() + static_cast<std::ptrdiff_t>(begin), adj.end()), adj.end());
+                adjOffsets[i + 1] = adj.size();
+            }
+        }
+
+    }
+
     DefaultCFGEdge::DefaultCFGEdge(std::shared_ptr<ir::Stmt> source, std::shared_ptr<ir::Stmt> target, Kind kind)
         :source(std::move(source)), target(std::move(target)), kind(kind)
     {
@@ -43,15 +96,26 @@ namespace analyzer::analysis::graph {
 
     bool DefaultCFG::hasEdge(std::shared_ptr<ir::Stmt> source, std::shared_ptr<ir::Stmt> target) const
     {
-        std::unordered_set<std::shared_ptr<ir::Stmt>>&& succs = getSuccsOf(source);
-        return succs.find(target) != succs.end();
+        std::size_t s = getNodeIndex(source);
+        std::size_t t = getNodeIndex(target);
+        if (s == nodes.size() || t == nodes.size()) {
+            return false;
+        }
+        llvm::ArrayRef<std::size_t> succIndices = getSuccIndicesOf(s);
+        return std::binary_search(succIndices.begin(), succIndices.end(), t);
     }
 
     std::unordered_set<std::shared_ptr<ir::Stmt>> DefaultCFG::getPredsOf(std::shared_ptr<ir::Stmt> stmt) const
     {
         std::unordered_set<std::shared_ptr<ir::Stmt>> result;
-        for (const std::shared_ptr<CFGEdge>& inEdge : getInEdgesOf(stmt)) {
-            result.emplace(inEdge->getSource());
+        std::size_t index = getNodeIndex(stmt);
+        if (index == nodes.size()) {
+            return result;
+        }
+        llvm::ArrayRef<std::size_t> predIndices = getPredIndicesOf(index);
+        result.reserve(predIndices.size());
+        for (std::size_t pred : predIndices) {
+            result.emplace(nodes[pred]);
         }
         return result;
     }
@@ -59,8 +123,14 @@ namespace analyzer::analysis::graph {
     std::unordered_set<std::shared_ptr<ir::Stmt>> DefaultCFG::getSuccsOf(std::shared_ptr<ir::Stmt> stmt) const
     {
         std::unordered_set<std::shared_ptr<ir::Stmt>> result;
-        for (const std::shared_ptr<CFGEdge>& outEdge : getOutEdgesOf(stmt)) {
-            result.emplace(outEdge->getTarget());
+        std::size_t index = getNodeIndex(stmt);
+        if (index == nodes.size()) {
+            return result;
+        }
+        llvm::ArrayRef<std::size_t> succIndices = getSuccIndicesOf(index);
+        result.reserve(succIndices.size());
+        for (std::size_t succ : succIndices) {
+            result.emplace(nodes[succ]);
         }
         return result;
     }
@@ -68,10 +138,13 @@ namespace analyzer::analysis::graph {
     std::unordered_set<std::shared_ptr<CFGEdge>> DefaultCFG::getInEdgesOf(std::shared_ptr<ir::Stmt> stmt) const
     {
         std::unordered_set<std::shared_ptr<CFGEdge>> result;
-        result.reserve(inEdges.count(stmt));
-        auto range = inEdges.equal_range(stmt);
-        for (auto&& it = range.first; it != range.second; it++) {
-            result.emplace(it->second);
+        std::size_t index = getNodeIndex(stmt);
+        if (index == nodes.size()) {
+            return result;
+        }
+        result.reserve(inEdgeOffsets[index + 1] - inEdgeOffsets[index]);
+        for (std::size_t i = inEdgeOffsets[index]; i < inEdgeOffsets[index + 1]; i++) {
+            result.emplace(inEdges[i]);
         }
         return result;
     }
@@ -79,18 +152,20 @@ namespace analyzer::analysis::graph {
     std::unordered_set<std::shared_ptr<CFGEdge>> DefaultCFG::getOutEdgesOf(std::shared_ptr<ir::Stmt> stmt) const
     {
         std::unordered_set<std::shared_ptr<CFGEdge>> result;
-        result.reserve(outEdges.count(stmt));
-        auto range = outEdges.equal_range(stmt);
-        for (auto&& it = range.first; it != range.second; it++) {
-            result.emplace(it->second);
+        std::size_t index = getNodeIndex(stmt);
+        if (index == nodes.size()) {
+            return result;
+        }
+        result.reserve(outEdgeOffsets[index + 1] - outEdgeOffsets[index]);
+        for (std::size_t i = outEdgeOffsets[index]; i < outEdgeOffsets[index + 1]; i++) {
+            result.emplace(outEdges[i]);
         }
         return result;
     }
 
     void DefaultCFG::addEdge(const std::shared_ptr<CFGEdge>& edge)
     {
-        inEdges.emplace(edge->getTarget(), edge);
-        outEdges.emplace(edge->getSource(), edge);
+        edges.emplace_back(edge);
         edgeNum++;
     }
 
@@ -99,6 +174,166 @@ namespace analyzer::analysis::graph {
         return edgeNum;
     }
 
+    std::size_t DefaultCFG::getNodeNum() const
+    {
+        return nodes.size();
+    }
+
+    const std::vector<std::shared_ptr<ir::Stmt>>& DefaultCFG::getNodes() const
+    {
+        return nodes;
+    }
+
+    const std::shared_ptr<ir::Stmt>& DefaultCFG::getNode(std::size_t index) const
+    {
+        return nodes[index];
+    }
+
+    std::size_t DefaultCFG::getNodeIndex(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        if (!stmt) {
+            return nodes.size();
+        }
+        std::size_t index = stmt->getIndex();
+        if (index < nodes.size() && nodes[index] == stmt) {
+            return index;
+        }
+        return nodes.size();
+    }
+
+    llvm::ArrayRef<std::size_t> DefaultCFG::getPredIndicesOf(std::size_t index) const
+    {
+        return {preds.data() + predOffsets[index], preds.data() + predOffsets[index + 1]};
+    }
+
+    llvm::ArrayRef<std::size_t> DefaultCFG::getSuccIndicesOf(std::size_t index) const
+    {
+        return {succs.data() + succOffsets[index], succs.data() + succOffsets[index + 1]};
+    }
+
+    void DefaultCFG::freeze(const std::vector<std::shared_ptr<ir::Stmt>>& stmts)
+    {
+        domTree = nullptr;
+        postDomTree = nullptr;
+        wto = nullptr;
+        reverseWTO = nullptr;
+
+        // number the nodes in the order of appearance first
+        std::vector<std::shared_ptr<ir::Stmt>> order;
+        std::unordered_map<const ir::Stmt*, std::size_t> firstIndices;
+        auto addNode = [&](const std::shared_ptr<ir::Stmt>& stmt) {
+            if (stmt && firstIndices.emplace(stmt.get(), order.size()).second) {
+                order.emplace_back(stmt);
+            }
+        };
+        addNode(entry);
+        for (const std::shared_ptr<ir::Stmt>& stmt : stmts) {
+            addNode(stmt);
+        }
+        addNode(exit);
+        for (const std::shared_ptr<CFGEdge>& edge : edges) {
+            addNode(edge->getSource());
+            addNode(edge->getTarget());
+        }
+
+        std::size_t n = order.size();
+        std::vector<std::size_t> sources, targets;
+        sources.reserve(edges.size());
+        targets.reserve(edges.size());
+        for (const std::shared_ptr<CFGEdge>& edge : edges) {
+            sources.emplace_back(firstIndices.at(edge->getSource().get()));
+            targets.emplace_back(firstIndices.at(edge->getTarget().get()));
+        }
+        buildRows(n, edges, sources, targets, outEdgeOffsets, outEdges, succOffsets, succs);
+
+        // renumber the nodes in reverse postorder of an iterative dfs from entry,
+        // unreachable nodes follow the reachable ones and exit always comes last
+        std::size_t exitIndex = exit ? firstIndices.at(exit.get()) : n;
+        std::vector<std::size_t> postOrder;
+        postOrder.reserve(n);
+        std::vector<bool> visited(n, false);
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        if (entry) {
+            visited[0] = true;
+            stack.emplace_back(0, succOffsets[0]);
+        }
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            if (next == succOffsets[node + 1]) {
+                postOrder.emplace_back(node);
+                stack.pop_back();
+                continue;
+            }
+            std::size_t succ = succs[next++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.emplace_back(succ, succOffsets[succ]);
+            }
+        }
+        std::vector<std::size_t> newIndices(n, n);
+        nodes.clear();
+        nodes.reserve(n);
+        auto placeNode = [&](std::size_t i) {
+            newIndices[i] = nodes.size();
+            nodes.emplace_back(order[i]);
+        };
+        for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it) {
+            if (*it != exitIndex) {
+                placeNode(*it);
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if (newIndices[i] == n && i != exitIndex) {
+                placeNode(i);
+            }
+        }
+        if (exitIndex != n) {
+            placeNode(exitIndex);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            nodes[i]->setIndex(i);
+        }
+
+        for (std::size_t i = 0; i < edges.size(); i++) {
+            sources[i] = newIndices[sources[i]];
+            targets[i] = newIndices[targets[i]];
+        }
+        buildRows(n, edges, sources, targets, outEdgeOffsets, outEdges, succOffsets, succs);
+        buildRows(n, edges, targets, sources, inEdgeOffsets, inEdges, predOffsets, preds);
+    }
+
+    std::shared_ptr<DominatorTree> DefaultCFG::getDominatorTree() const
+    {
+        if (!domTree) {
+            domTree = std::make_shared<DominatorTree>(*this, false);
+        }
+        return domTree;
+    }
+
+    std::shared_ptr<DominatorTree> DefaultCFG::getPostDominatorTree() const
+    {
+        if (!postDomTree) {
+            postDomTree = std::make_shared<DominatorTree>(*this, true);
+        }
+        return postDomTree;
+    }
+
+    std::shared_ptr<WeakTopologicalOrder> DefaultCFG::getWeakTopologicalOrder() const
+    {
+        if (!wto) {
+            wto = std::make_shared<WeakTopologicalOrder>(*this, false);
+        }
+        return wto;
+    }
+
+    std::shared_ptr<WeakTopologicalOrder> DefaultCFG::getReverseWeakTopologicalOrder() const
+    {
+        if (!reverseWTO) {
+            reverseWTO = std::make_shared<WeakTopologicalOrder>(*this, true);
+        }
+        return reverseWTO;
+    }
+
     void DefaultCFG::setEntry(const std::shared_ptr<ir::Stmt>& entry)
     {
         this->entry = entry;
@@ -109,6 +344,96 @@ namespace analyzer::analysis::graph {
         this->exit = exit;
     }
 
+    std::size_t DefaultCFG::contractEmptyNodes(std::vector<std::shared_ptr<ir::Stmt>>& stmts)
+    {
+        std::unordered_map<const ir::Stmt*, std::vector<std::size_t>> inEdgesOf, outEdgesOf;
+        std::set<std::pair<const ir::Stmt*, const ir::Stmt*>> edgeSet;
+        std::vector<bool> alive;
+        auto link = [&](const std::shared_ptr<CFGEdge>& edge) {
+            outEdgesOf[edge->getSource().get()].emplace_back(edges.size());
+            inEdgesOf[edge->getTarget().get()].emplace_back(edges.size());
+            edgeSet.emplace(edge->getSource().get(), edge->getTarget().get());
+            edges.emplace_back(edge);
+            alive.emplace_back(true);
+        };
+        std::vector<std::shared_ptr<CFGEdge>> initialEdges;
+        initialEdges.swap(edges);
+        for (const std::shared_ptr<CFGEdge>& edge : initialEdges) {
+            link(edge);
+        }
+        auto aliveEdgesOf = [&](std::vector<std::size_t>& edgeIndices) -> std::vector<std::size_t>& {
+            edgeIndices.erase(std::remove_if(edgeIndices.begin(), edgeIndices.end(),
+                [&](std::size_t e) -> bool { return !alive[e]; }), edgeIndices.end());
+            return edgeIndices;
+        };
+
+        std::size_t contracted = 0;
+        std::vector<std::shared_ptr<ir::Stmt>> kept;
+        for (const std::shared_ptr<ir::Stmt>& stmt : stmts) {
+            if (stmt->getClangStmt() != nullptr || stmt == entry || stmt == exit) {
+                kept.emplace_back(stmt);
+                continue;
+            }
+            std::vector<std::size_t>& ins = aliveEdgesOf(inEdgesOf[stmt.get()]);
+            std::vector<std::size_t>& outs = aliveEdgesOf(outEdgesOf[stmt.get()]);
+            // bypass stmt by joining each predecessor to the single successor, or the single predecessor
+            // to each successor, unless a self loop or a parallel edge would appear
+            bool singleSucc = outs.size() == 1 && edges[outs[0]]->getTarget() != stmt;
+            bool singlePred = ins.size() == 1 && edges[ins[0]]->getSource() != stmt;
+            std::vector<std::pair<std::shared_ptr<ir::Stmt>, std::shared_ptr<ir::Stmt>>> bypasses;
+            std::vector<CFGEdge::Kind> kinds;
+            if (singleSucc) {
+                for (std::size_t e : ins) {
+                    bypasses.emplace_back(edges[e]->getSource(), edges[outs[0]]->getTarget());
+                    kinds.emplace_back(edges[e]->getKind());
+                }
+            } else if (singlePred) {
+                for (std::size_t e : outs) {
+                    bypasses.emplace_back(edges[ins[0]]->getSource(), edges[e]->getTarget());
+                    kinds.emplace_back(edges[e]->getKind());
+                }
+            }
+            bool contractible = singleSucc || singlePred;
+            std::set<std::pair<const ir::Stmt*, const ir::Stmt*>> bypassSet;
+            for (const auto& [source, target] : bypasses) {
+                if (source == target || edgeSet.count({source.get(), target.get()})
+                        || !bypassSet.emplace(source.get(), target.get()).second) {
+                    contractible = false;
+                }
+            }
+            if (!contractible) {
+                kept.emplace_back(stmt);
+                continue;
+            }
+            for (std::size_t e : ins) {
+                alive[e] = false;
+                edgeSet.erase({edges[e]->getSource().get(), stmt.get()});
+            }
+            for (std::size_t e : outs) {
+                alive[e] = false;
+                edgeSet.erase({stmt.get(), edges[e]->getTarget().get()});
+            }
+            for (std::size_t i = 0; i < bypasses.size(); i++) {
+                const auto& [source, target] = bypasses[i];
+                CFGEdge::Kind kind = source == entry ? CFGEdge::Kind::ENTRY_EDGE
+                    : target == exit ? CFGEdge::Kind::EXIT_EDGE : kinds[i];
+                link(std::make_shared<DefaultCFGEdge>(source, target, kind));
+            }
+            contracted++;
+        }
+
+        std::vector<std::shared_ptr<CFGEdge>> remaining;
+        for (std::size_t e = 0; e < edges.size(); e++) {
+            if (alive[e]) {
+                remaining.emplace_back(edges[e]);
+            }
+        }
+        edges.swap(remaining);
+        edgeNum = edges.size();
+        stmts.swap(kept);
+        return contracted;
+    }
+
     std::shared_ptr<ir::IR> DefaultCFG::getIR() const
     {
         return myIR.lock();
@@ -0,0 +1,273 @@
+#include <algorithm>
+
+#include "analysis/graph/Dominators.h"
+
+namespace analyzer::analysis::graph {
+
+    DominatorTree::DominatorTree(const CFG& cfg, bool isPostDom)
+        :cfg(cfg), isPostDom(isPostDom)
+    {
+        root = cfg.getNodeIndex(isPostDom ? cfg.getExit() : cfg.getEntry());
+        computeIDoms();
+        computeIntervals();
+        computeFrontiers();
+    }
+
+    bool DominatorTree::isPostDominatorTree() const
+    {
+        return isPostDom;
+    }
+
+    std::shared_ptr<ir::Stmt> DominatorTree::getRoot() const
+    {
+        return root == getNodeNum() ? nullptr : cfg.getNode(root);
+    }
+
+    bool DominatorTree::isReachable(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        std::size_t index = cfg.getNodeIndex(stmt);
+        return index != getNodeNum() && (index == root || idoms[index] != getNodeNum());
+    }
+
+    std::shared_ptr<ir::Stmt> DominatorTree::getIDom(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        std::size_t index = cfg.getNodeIndex(stmt);
+        if (index == getNodeNum() || idoms[index] == getNodeNum()) {
+            return nullptr;
+        }
+        return cfg.getNode(idoms[index]);
+    }
+
+    std::unordered_set<std::shared_ptr<ir::Stmt>>
+        DominatorTree::getChildrenOf(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        std::unordered_set<std::shared_ptr<ir::Stmt>> result;
+        std::size_t index = cfg.getNodeIndex(stmt);
+        if (index == getNodeNum()) {
+            return result;
+        }
+        for (std::size_t child : getChildIndicesOf(index)) {
+            result.emplace(cfg.getNode(child));
+        }
+        return result;
+    }
+
+    bool DominatorTree::dominates(const std::shared_ptr<ir::Stmt>& a, const std::shared_ptr<ir::Stmt>& b) const
+    {
+        return dominates(cfg.getNodeIndex(a), cfg.getNodeIndex(b));
+    }
+
+    bool DominatorTree::strictlyDominates(const std::shared_ptr<ir::Stmt>& a,
+                                          const std::shared_ptr<ir::Stmt>& b) const
+    {
+        std::size_t i = cfg.getNodeIndex(a);
+        std::size_t j = cfg.getNodeIndex(b);
+        return i != j && dominates(i, j);
+    }
+
+    std::unordered_set<std::shared_ptr<ir::Stmt>>
+        DominatorTree::getDominanceFrontierOf(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        std::unordered_set<std::shared_ptr<ir::Stmt>> result;
+        std::size_t index = cfg.getNodeIndex(stmt);
+        if (index == getNodeNum()) {
+            return result;
+        }
+        for (std::size_t f : getFrontierIndicesOf(index)) {
+            result.emplace(cfg.getNode(f));
+        }
+        return result;
+    }
+
+    std::size_t DominatorTree::getNodeNum() const
+    {
+        return idoms.size();
+    }
+
+    std::size_t DominatorTree::getIDomIndex(std::size_t index) const
+    {
+        return idoms[index];
+    }
+
+    llvm::ArrayRef<std::size_t> DominatorTree::getChildIndicesOf(std::size_t index) const
+    {
+        return llvm::ArrayRef<std::size_t>(children).slice(childOffsets[index],
+            childOffsets[index + 1] - childOffsets[index]);
+    }
+
+    llvm::ArrayRef<std::size_t> DominatorTree::getFrontierIndicesOf(std::size_t index) const
+    {
+        return llvm::ArrayRef<std::size_t>(frontiers).slice(frontierOffsets[index],
+            frontierOffsets[index + 1] - frontierOffsets[index]);
+    }
+
+    bool DominatorTree::dominates(std::size_t a, std::size_t b) const
+    {
+        std::size_t n = getNodeNum();
+        if (a >= n || b >= n || dfsIn[a] == n || dfsIn[b] == n) {
+            return false;
+        }
+        return dfsIn[a] <= dfsIn[b] && dfsOut[b] <= dfsOut[a];
+    }
+
+    llvm::ArrayRef<std::size_t> DominatorTree::getReversePostOrder() const
+    {
+        return rpo;
+    }
+
+    llvm::ArrayRef<std::size_t> DominatorTree::predsOf(std::size_t index) const
+    {
+        return isPostDom ? cfg.getSuccIndicesOf(index) : cfg.getPredIndicesOf(index);
+    }
+
+    llvm::ArrayRef<std::size_t> DominatorTree::succsOf(std::size_t index) const
+    {
+        return isPostDom ? cfg.getPredIndicesOf(index) : cfg.getSuccIndicesOf(index);
+    }
+
+    void DominatorTree::computeIDoms()
+    {
+        std::size_t n = cfg.getNodeNum();
+        idoms.assign(n, n);
+        rpo.clear();
+        if (root == n) {
+            return;
+        }
+
+        // postorder numbers of an iterative dfs from the root
+        std::vector<std::size_t> postNumbers(n, n);
+        std::vector<bool> visited(n, false);
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        visited[root] = true;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            llvm::ArrayRef<std::size_t> succs = succsOf(node);
+            if (next == succs.size()) {
+                postNumbers[node] = rpo.size();
+                rpo.emplace_back(node);
+                stack.pop_back();
+                continue;
+            }
+            std::size_t succ = succs[next++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.emplace_back(succ, 0);
+            }
+        }
+        std::reverse(rpo.begin(), rpo.end());
+
+        // Cooper, Harvey and Kennedy: "A Simple, Fast Dominance Algorithm"
+        auto intersect = [&](std::size_t b1, std::size_t b2) -> std::size_t {
+            while (b1 != b2) {
+                while (postNumbers[b1] < postNumbers[b2]) {
+                    b1 = idoms[b1];
+                }
+                while (postNumbers[b2] < postNumbers[b1]) {
+                    b2 = idoms[b2];
+                }
+            }
+            return b1;
+        };
+        idoms[root] = root;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (std::size_t i = 1; i < rpo.size(); i++) {
+                std::size_t b = rpo[i];
+                std::size_t newIDom = n;
+                for (std::size_t p : predsOf(b)) {
+                    if (idoms[p] == n) {
+                        continue;
+                    }
+                    newIDom = newIDom == n ? p : intersect(p, newIDom);
+                }
+                if (newIDom != idoms[b]) {
+                    idoms[b] = newIDom;
+                    changed = true;
+                }
+            }
+        }
+        idoms[root] = n;
+    }
+
+    void DominatorTree::computeIntervals()
+    {
+        std::size_t n = getNodeNum();
+        childOffsets.assign(n + 1, 0);
+        for (std::size_t b : rpo) {
+            if (idoms[b] != n) {
+                childOffsets[idoms[b] + 1]++;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            childOffsets[i + 1] += childOffsets[i];
+        }
+        children.assign(childOffsets[n], n);
+        std::vector<std::size_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+        for (std::size_t b : rpo) {
+            if (idoms[b] != n) {
+                children[cursor[idoms[b]]++] = b;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            std::sort(children.begin() + static_cast<std::ptrdiff_t>(childOffsets[i]),
+                      children.begin() + static_cast<std::ptrdiff_t>(childOffsets[i + 1]));
+        }
+
+        dfsIn.assign(n, n);
+        dfsOut.assign(n, n);
+        if (root == n) {
+            return;
+        }
+        std::size_t inCounter = 0;
+        std::size_t outCounter = 0;
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        dfsIn[root] = inCounter++;
+        stack.emplace_back(root, childOffsets[root]);
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            if (next == childOffsets[node + 1]) {
+                dfsOut[node] = outCounter++;
+                stack.pop_back();
+                continue;
+            }
+            std::size_t child = children[next++];
+            dfsIn[child] = inCounter++;
+            stack.emplace_back(child, childOffsets[child]);
+        }
+    }
+
+    void DominatorTree::computeFrontiers()
+    {
+        std::size_t n = getNodeNum();
+        std::vector<std::vector<std::size_t>> df(n);
+        for (std::size_t b : rpo) {
+            llvm::ArrayRef<std::size_t> preds = predsOf(b);
+            if (preds.size() < 2) {
+                continue;
+            }
+            for (std::size_t p : preds) {
+                if (!dominates(root, p)) {
+                    continue;
+                }
+                std::size_t runner = p;
+                while (runner != idoms[b] && runner != n) {
+                    if (df[runner].empty() || df[runner].back() != b) {
+                        df[runner].emplace_back(b);
+                    }
+                    runner = idoms[runner];
+                }
+            }
+        }
+        frontierOffsets.assign(n + 1, 0);
+        frontiers.clear();
+        for (std::size_t i = 0; i < n; i++) {
+            std::sort(df[i].begin(), df[i].end());
+            df[i].erase(std::unique(df[i].begin(), df[i].end()), df[i].end());
+            frontiers.insert(frontiers.end(), df[i].begin(), df[i].end());
+            frontierOffsets[i + 1] = frontiers.size();
+        }
+    }
+
+} // graph
@@ -0,0 +1,235 @@
+#include <limits>
+
+#include "analysis/graph/WeakTopologicalOrder.h"
+
+namespace analyzer::analysis::graph {
+
+    WeakTopologicalOrder::WeakTopologicalOrder(const CFG& cfg, bool isReversed)
+        :cfg(cfg), reversed(isReversed), order(), componentEnds(), heads(), positions(), depths(), headNum(0)
+    {
+        computeOrder();
+        computeDepths();
+    }
+
+    bool WeakTopologicalOrder::isReversed() const
+    {
+        return reversed;
+    }
+
+    std::size_t WeakTopologicalOrder::getNodeNum() const
+    {
+        return order.size();
+    }
+
+    llvm::ArrayRef<std::size_t> WeakTopologicalOrder::getOrder() const
+    {
+        return order;
+    }
+
+    std::size_t WeakTopologicalOrder::getComponentEnd(std::size_t position) const
+    {
+        return componentEnds[position];
+    }
+
+    std::size_t WeakTopologicalOrder::getPositionOf(std::size_t index) const
+    {
+        return positions[index];
+    }
+
+    bool WeakTopologicalOrder::isHead(std::size_t index) const
+    {
+        return heads[index];
+    }
+
+    bool WeakTopologicalOrder::isHead(const std::shared_ptr<ir::Stmt>& stmt) const
+    {
+        std::size_t index = cfg.getNodeIndex(stmt);
+        return index != getNodeNum() && isHead(index);
+    }
+
+    std::size_t WeakTopologicalOrder::getDepthOf(std::size_t index) const
+    {
+        return depths[index];
+    }
+
+    std::size_t WeakTopologicalOrder::getHeadNum() const
+    {
+        return headNum;
+    }
+
+    std::string WeakTopologicalOrder::str() const
+    {
+        std::string result;
+        std::vector<std::size_t> openEnds;
+        for (std::size_t position = 0; position < order.size(); position++) {
+            if (!result.empty()) {
+                result += " ";
+            }
+            bool head = isHead(order[position]);
+            if (head) {
+                result += "(";
+                openEnds.emplace_back(componentEnds[position]);
+            }
+            result += std::to_string(order[position]);
+            while (!openEnds.empty() && openEnds.back() == position + 1) {
+                result += ")";
+                openEnds.pop_back();
+            }
+        }
+        return result;
+    }
+
+    llvm::ArrayRef<std::size_t> WeakTopologicalOrder::succsOf(std::size_t index) const
+    {
+        return reversed ? cfg.getPredIndicesOf(index) : cfg.getSuccIndicesOf(index);
+    }
+
+    void WeakTopologicalOrder::computeOrder()
+    {
+        std::size_t n = cfg.getNodeNum();
+        constexpr std::size_t infinity = std::numeric_limits<std::size_t>::max();
+
+        /*
+         * Bourdoncle prepends every finished element to the current partition, so the elements
+         * are appended here in the reverse order, a head right after the body of its component,
+         * and the whole sequence is reversed at the end.
+         */
+        std::vector<std::size_t> finished;
+        // for each finished element, where the body of its component begins, infinity if it is no head
+        std::vector<std::size_t> bodyBegins;
+        std::vector<std::size_t> dfn(n, 0);
+        std::vector<std::size_t> nodeStack;
+        std::size_t counter = 0;
+
+        /*
+         * A frame is a call of visit(node) of the recursive algorithm, turned into a call
+         * of component(node) once the node is found to be a head.
+         */
+        struct Frame {
+            std::size_t node; ///< the visited node
+            std::size_t next; ///< the position of the next successor to visit
+            std::size_t head; ///< the smallest dfn reached from the node so far
+            bool loop; ///< whether the node is on a cycle
+            bool component; ///< whether the body of the component of the node is being visited
+            std::size_t bodyBegin; ///< the number of finished elements when the body began
+        };
+        std::vector<Frame> frames;
+        auto enter = [&](std::size_t node) {
+            nodeStack.emplace_back(node);
+            dfn[node] = ++counter;
+            frames.push_back({node, 0, dfn[node], false, false, 0});
+        };
+
+        std::vector<std::size_t> roots;
+        roots.reserve(n + 1);
+        std::shared_ptr<ir::Stmt> start = reversed ? cfg.getExit() : cfg.getEntry();
+        if (start != nullptr && cfg.getNodeIndex(start) != n) {
+            roots.emplace_back(cfg.getNodeIndex(start));
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            roots.emplace_back(reversed ? n - 1 - i : i);
+        }
+
+        for (std::size_t root : roots) {
+            if (dfn[root] != 0) {
+                continue;
+            }
+            enter(root);
+            // the value returned by the last finished visit to its caller, if any
+            bool returned = false;
+            std::size_t returnedHead = 0;
+            while (!frames.empty()) {
+                Frame& frame = frames.back();
+                llvm::ArrayRef<std::size_t> succs = succsOf(frame.node);
+                if (returned) {
+                    returned = false;
+                    if (!frame.component && returnedHead <= frame.head) {
+                        frame.head = returnedHead;
+                        frame.loop = true;
+                    }
+                    frame.next++;
+                    continue;
+                }
+                if (frame.next < succs.size()) {
+                    std::size_t succ = succs[frame.next];
+                    if (dfn[succ] == 0) {
+                        enter(succ);
+                        continue;
+                    }
+                    if (!frame.component && dfn[succ] <= frame.head) {
+                        frame.head = dfn[succ];
+                        frame.loop = true;
+                    }
+                    frame.next++;
+                    continue;
+                }
+                if (frame.component) {
+                    finished.emplace_back(frame.node);
+                    bodyBegins.emplace_back(frame.bodyBegin);
+                    returnedHead = frame.head;
+                    returned = true;
+                    frames.pop_back();
+                    continue;
+                }
+                if (frame.head == dfn[frame.node]) {
+                    dfn[frame.node] = infinity;
+                    std::size_t element = nodeStack.back();
+                    nodeStack.pop_back();
+                    if (frame.loop) {
+                        // the nodes of the cycle are visited again as the body of the component
+                        while (element != frame.node) {
+                            dfn[element] = 0;
+                            element = nodeStack.back();
+                            nodeStack.pop_back();
+                        }
+                        frame.component = true;
+                        frame.next = 0;
+                        frame.bodyBegin = finished.size();
+                        continue;
+                    }
+                    finished.emplace_back(frame.node);
+                    bodyBegins.emplace_back(infinity);
+                }
+                returnedHead = frame.head;
+                returned = true;
+                frames.pop_back();
+            }
+        }
+
+        order.assign(finished.rbegin(), finished.rend());
+        componentEnds.assign(n, 0);
+        heads.assign(n, false);
+        headNum = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            std::size_t position = n - 1 - i;
+            if (bodyBegins[i] == infinity) {
+                componentEnds[position] = position + 1;
+            } else {
+                // a node on a self loop only is a component with an empty body
+                componentEnds[position] = n - bodyBegins[i];
+                heads[finished[i]] = true;
+                headNum++;
+            }
+        }
+    }
+
+    void WeakTopologicalOrder::computeDepths()
+    {
+        std::size_t n = getNodeNum();
+        positions.assign(n, n);
+        depths.assign(n, 0);
+        std::vector<std::size_t> openEnds;
+        for (std::size_t position = 0; position < n; position++) {
+            while (!openEnds.empty() && openEnds.back() <= position) {
+                openEnds.pop_back();
+            }
+            std::size_t index = order[position];
+            positions[index] = position;
+            if (heads[index]) {
+                openEnds.emplace_back(componentEnds[position]);
+            }
+            depths[index] = openEnds.size();
+        }
+    }
+
+} // graph
@@ -4,8 +4,9 @@
 
 namespace analyzer::config {
 
-    DefaultAnalysisConfig::DefaultAnalysisConfig(std::string description)
-        :description(std::move(description))
+    DefaultAnalysisConfig::DefaultAnalysisConfig(std::string description,
+                                                 std::unordered_map<std::string, std::string> options)
+        :description(std::move(description)), options(std::move(options))
     {
 
     }
@@ -15,4 +16,18 @@ namespace analyzer::config {
         return description;
     }
 
+    std::string DefaultAnalysisConfig::getOption(const std::string& key, const std::string& defaultValue) const
+    {
+        auto it = options.find(key);
+        if (it == options.end()) {
+            return defaultValue;
+        }
+        return it->second;
+    }
+
+    void DefaultAnalysisConfig::setOption(const std::string& key, const std::string& value)
+    {
+        options.insert_or_assign(key, value);
+    }
+
 }
@@ -10,7 +10,7 @@ namespace analyzer::ir {
 
     ClangStmtWrapper::ClangStmtWrapper(const lang::CPPMethod& method,
         const clang::Stmt* clangStmt, std::unordered_map<const clang::VarDecl*, std::shared_ptr<Var>>& varPool)
-        : method(method), clangStmt(clangStmt)
+        : method(method), clangStmt(clangStmt), index(0)
     {
 
         class StmtProcessor: public clang::RecursiveASTVisitor<StmtProcessor> {
@@ -183,4 +183,14 @@ namespace analyzer::ir {
         return clangStmt;
     }
 
+    std::size_t ClangStmtWrapper::getIndex() const
+    {
+        return index;
+    }
+
+    void ClangStmtWrapper::setIndex(std::size_t index)
+    {
+        this->index = index;
+    }
+
 }
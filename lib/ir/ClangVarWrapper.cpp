@@ -6,7 +6,7 @@
 namespace analyzer::ir {
 
     ClangVarWrapper::ClangVarWrapper(const lang::CPPMethod& method, const clang::VarDecl* varDecl)
-        :method(method), varDecl(varDecl)
+        :method(method), varDecl(varDecl), index(0)
     {
         name = varDecl->getNameAsString();
         type = World::get().getTypeBuilder()->buildType(varDecl->getType());
@@ -32,4 +32,14 @@ namespace analyzer::ir {
         return varDecl;
     }
 
+    std::size_t ClangVarWrapper::getIndex() const
+    {
+        return index;
+    }
+
+    void ClangVarWrapper::setIndex(std::size_t index)
+    {
+        this->index = index;
+    }
+
 }
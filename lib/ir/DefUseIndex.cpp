@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <iterator>
+
+#include "ir/DefUseIndex.h"
+#include "ir/SSA.h"
+
+namespace analyzer::ir {
+
+    DefUseIndex::DefUseIndex(const IR& ir)
+        :ssa(ir.getSSA()), cfg(ir.getCFG())
+    {
+        std::vector<std::shared_ptr<Var>> irVars = ir.getVars();
+        vars.resize(irVars.size());
+        for (const std::shared_ptr<Var>& var : irVars) {
+            vars.at(var->getIndex()) = var;
+        }
+        std::size_t n = cfg->getNodeNum();
+        std::size_t defNum = ssa->getDefNum();
+
+        // resolve every ssa definition to the entry and statement definitions it stands for
+        std::vector<std::vector<std::size_t>> resolved(defNum);
+        std::vector<std::size_t> phiDefs;
+        for (std::size_t d = 0; d < defNum; d++) {
+            if (ssa->getDefKind(d) == SSA::DefKind::PHI) {
+                phiDefs.emplace_back(d);
+            } else {
+                resolved[d].emplace_back(d);
+            }
+        }
+        std::vector<std::size_t> merged;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (std::size_t phi : phiDefs) {
+                for (std::size_t operand : ssa->getPhiOperands(phi)) {
+                    if (operand == defNum || operand == phi) {
+                        continue;
+                    }
+                    merged.clear();
+                    std::set_union(resolved[phi].begin(), resolved[phi].end(),
+                                   resolved[operand].begin(), resolved[operand].end(),
+                                   std::back_inserter(merged));
+                    if (merged.size() != resolved[phi].size()) {
+                        resolved[phi].swap(merged);
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        // use-def chains, and the def-use edges to be grouped afterwards
+        std::vector<std::pair<std::size_t, std::size_t>> edges; // (statement definition, using node)
+        useOffsets.assign(n + 1, 0);
+        useDefOffsets.assign(1, 0);
+        for (std::size_t i = 0; i < n; i++) {
+            const std::shared_ptr<Stmt>& stmt = cfg->getNode(i);
+            llvm::ArrayRef<std::size_t> reachingDefs = ssa->getUseDefsOf(stmt);
+            for (std::size_t d : reachingDefs) {
+                if (d == defNum) {
+                    continue;
+                }
+                useVars.emplace_back(ssa->getDefVar(d)->getIndex());
+                bool reachedByEntry = false;
+                for (std::size_t r : resolved[d]) {
+                    if (ssa->getDefKind(r) == SSA::DefKind::ENTRY) {
+                        reachedByEntry = true;
+                    } else {
+                        useDefs.emplace_back(ssa->getDefStmt(r));
+                        edges.emplace_back(r, i);
+                    }
+                }
+                useReachedByEntry.emplace_back(reachedByEntry);
+                useDefOffsets.emplace_back(useDefs.size());
+            }
+            useOffsets[i + 1] = useVars.size();
+        }
+
+        // def-use chains, grouped by the ssa id of the statement definition
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        defUseOffsets.assign(defNum + 1, 0);
+        defUses.reserve(edges.size());
+        for (const auto& [def, use] : edges) {
+            defUseOffsets[def + 1]++;
+            defUses.emplace_back(cfg->getNode(use));
+        }
+        for (std::size_t d = 0; d < defNum; d++) {
+            defUseOffsets[d + 1] += defUseOffsets[d];
+        }
+
+        // defining statements of each variable, statement definitions are numbered in node order
+        varDefOffsets.assign(vars.size() + 1, 0);
+        for (std::size_t d = 0; d < defNum; d++) {
+            if (ssa->getDefKind(d) == SSA::DefKind::STMT) {
+                varDefOffsets[ssa->getDefVar(d)->getIndex() + 1]++;
+            }
+        }
+        for (std::size_t v = 0; v < vars.size(); v++) {
+            varDefOffsets[v + 1] += varDefOffsets[v];
+        }
+        varDefs.resize(varDefOffsets.back());
+        std::vector<std::size_t> cursor(varDefOffsets.begin(), varDefOffsets.end() - 1);
+        for (std::size_t d = 0; d < defNum; d++) {
+            if (ssa->getDefKind(d) == SSA::DefKind::STMT) {
+                varDefs[cursor[ssa->getDefVar(d)->getIndex()]++] = ssa->getDefStmt(d);
+            }
+        }
+    }
+
+    llvm::ArrayRef<std::shared_ptr<Stmt>> DefUseIndex::getDefiningStmtsOf(const std::shared_ptr<Var>& var) const
+    {
+        std::size_t v = varIndexOf(var);
+        if (v == vars.size()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::shared_ptr<Stmt>>(varDefs).slice(varDefOffsets[v],
+            varDefOffsets[v + 1] - varDefOffsets[v]);
+    }
+
+    llvm::ArrayRef<std::shared_ptr<Stmt>> DefUseIndex::getDefsOfUse(const std::shared_ptr<Stmt>& stmt,
+                                                                    const std::shared_ptr<Var>& var) const
+    {
+        std::size_t slot = useSlotOf(stmt, var);
+        if (slot == useVars.size()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::shared_ptr<Stmt>>(useDefs).slice(useDefOffsets[slot],
+            useDefOffsets[slot + 1] - useDefOffsets[slot]);
+    }
+
+    llvm::ArrayRef<std::shared_ptr<Stmt>> DefUseIndex::getUsesOfDef(const std::shared_ptr<Stmt>& stmt,
+                                                                    const std::shared_ptr<Var>& var) const
+    {
+        std::size_t def = ssa->getDefAt(stmt, var);
+        if (def == ssa->getDefNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::shared_ptr<Stmt>>(defUses).slice(defUseOffsets[def],
+            defUseOffsets[def + 1] - defUseOffsets[def]);
+    }
+
+    bool DefUseIndex::isReachedByEntry(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const
+    {
+        std::size_t slot = useSlotOf(stmt, var);
+        return slot != useVars.size() && useReachedByEntry[slot];
+    }
+
+    std::size_t DefUseIndex::getEdgeNum() const
+    {
+        return defUses.size();
+    }
+
+    std::size_t DefUseIndex::varIndexOf(const std::shared_ptr<Var>& var) const
+    {
+        if (!var) {
+            return vars.size();
+        }
+        std::size_t v = var->getIndex();
+        return v < vars.size() && vars[v] == var ? v : vars.size();
+    }
+
+    std::size_t DefUseIndex::useSlotOf(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        std::size_t v = varIndexOf(var);
+        if (node == cfg->getNodeNum() || v == vars.size()) {
+            return useVars.size();
+        }
+        auto begin = useVars.begin() + static_cast<std::ptrdiff_t>(useOffsets[node]);
+        auto end = useVars.begin() + static_cast<std::ptrdiff_t>(useOffsets[node + 1]);
+        auto it = std::lower_bound(begin, end, v);
+        if (it == end || *it != v) {
+            return useVars.size();
+        }
+        return static_cast<std::size_t>(it - useVars.begin());
+    }
+
+} // ir
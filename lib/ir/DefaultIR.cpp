@@ -1,11 +1,23 @@
 #include <utility>
-#include <algorithm>
 
 #include "ir/IR.h"
+#include "ir/SSA.h"
+#include "ir/DefUseIndex.h"
+#include "ir/TAC.h"
 #include "language/CPPMethod.h"
 
 namespace analyzer::ir {
 
+    std::vector<std::shared_ptr<Var>> IR::getVarsByIndex() const
+    {
+        std::vector<std::shared_ptr<Var>> vars = getVars();
+        std::vector<std::shared_ptr<Var>> indexedVars(vars.size());
+        for (const std::shared_ptr<Var>& var : vars) {
+            indexedVars.at(var->getIndex()) = var;
+        }
+        return indexedVars;
+    }
+
     DefaultIR::DefaultIR(const lang::CPPMethod& method,
                          std::vector<std::shared_ptr<Var>> params,
                          std::vector<std::shared_ptr<Var>> vars,
@@ -14,10 +26,7 @@ namespace analyzer::ir {
             :method(method), params(std::move(params)), vars(std::move(vars)),
                 stmts(std::move(stmts)), cfg(cfg)
     {
-        std::sort(this->stmts.begin(), this->stmts.end(),
-            [](const std::shared_ptr<Stmt>& s1, const std::shared_ptr<Stmt>& s2) -> bool {
-            return s1->getStartLine() < s2->getStartLine();
-        });
+
     }
 
     const lang::CPPMethod& DefaultIR::getMethod() const
@@ -45,4 +54,28 @@ namespace analyzer::ir {
         return stmts;
     }
 
-} // ir
\ No newline at end of file
+    std::shared_ptr<SSA> DefaultIR::getSSA() const
+    {
+        if (!ssa) {
+            ssa = std::make_shared<SSA>(*this);
+        }
+        return ssa;
+    }
+
+    std::shared_ptr<DefUseIndex> DefaultIR::getDefUseIndex() const
+    {
+        if (!defUseIndex) {
+            defUseIndex = std::make_shared<DefUseIndex>(*this);
+        }
+        return defUseIndex;
+    }
+
+    std::shared_ptr<tac::TAC> DefaultIR::getTAC() const
+    {
+        if (!tac) {
+            tac = std::make_shared<tac::TAC>(*this);
+        }
+        return tac;
+    }
+
+} // ir
@@ -1,4 +1,5 @@
 #include <queue>
+#include <algorithm>
 
 #include "ir/IR.h"
 #include "ir/Stmt.h"
@@ -10,13 +11,19 @@ namespace analyzer::ir {
     namespace lang = language;
     namespace graph = analysis::graph;
 
+    DefaultIRBuilder::DefaultIRBuilder(bool simplifyCFG)
+        :simplifyCFG(simplifyCFG)
+    {
+
+    }
+
     std::shared_ptr<IR> DefaultIRBuilder::buildIR(const lang::CPPMethod& method) const
     {
-        return DefaultIRBuilderHelper(method).build();
+        return DefaultIRBuilderHelper(method, simplifyCFG).build();
     }
 
-    DefaultIRBuilderHelper::DefaultIRBuilderHelper(const lang::CPPMethod& method)
-        :method(method)
+    DefaultIRBuilderHelper::DefaultIRBuilderHelper(const lang::CPPMethod& method, bool simplifyCFG)
+        :method(method), simplifyCFG(simplifyCFG)
     {
 
     }
@@ -32,14 +39,38 @@ namespace analyzer::ir {
         World::getLogger().Info("Building CFG for this method ...");
         std::shared_ptr<graph::DefaultCFG> cfg = std::make_shared<graph::DefaultCFG>();
         buildEdges(cfg);
+        if (simplifyCFG) {
+            std::size_t nodeNum = stmtVec.size() + 2;
+            std::size_t edgeNum = cfg->getEdgeNum();
+            std::size_t contracted = cfg->contractEmptyNodes(stmtVec);
+            World::getLogger().Info("Simplified CFG of " + method.getMethodSignatureAsString() + ": "
+                + std::to_string(nodeNum) + " -> " + std::to_string(nodeNum - contracted) + " nodes, "
+                + std::to_string(edgeNum) + " -> " + std::to_string(cfg->getEdgeNum()) + " edges");
+        }
         World::getLogger().Info("Encapsulating the above parts to form ir ...");
-        for (const auto& [_, s]: stmts) {
-            stmtVec.emplace_back(s);
+        cfg->freeze(stmtVec);
+        stmtVec.clear();
+        for (const std::shared_ptr<Stmt>& s : cfg->getNodes()) {
+            if (s != cfg->getEntry() && s != cfg->getExit()) {
+                stmtVec.emplace_back(s);
+            }
         }
-        std::vector<std::shared_ptr<Var>> vars;
+        std::vector<std::shared_ptr<Var>> vars(params.begin(), params.end());
         vars.reserve(varPool.size());
+        std::size_t paramNum = vars.size();
         for (auto& [_, var] : varPool) {
-            vars.emplace_back(var);
+            if (std::find(params.begin(), params.end(), var) == params.end()) {
+                vars.emplace_back(var);
+            }
+        }
+        // order the local variables by declaration to make the numbering deterministic
+        std::sort(vars.begin() + static_cast<std::ptrdiff_t>(paramNum), vars.end(),
+            [](const std::shared_ptr<Var>& v1, const std::shared_ptr<Var>& v2) -> bool {
+            return v1->getClangVarDecl()->getLocation().getRawEncoding()
+                < v2->getClangVarDecl()->getLocation().getRawEncoding();
+        });
+        for (std::size_t i = 0; i < vars.size(); i++) {
+            vars[i]->setIndex(i);
         }
         std::shared_ptr<DefaultIR> myIR = std::make_shared<DefaultIR>(
                 method, std::move(params), std::move(vars), std::move(stmtVec), cfg);
@@ -67,7 +98,10 @@ namespace analyzer::ir {
                 if (std::optional<clang::CFGStmt> cfgStmt = element.getAs<clang::CFGStmt>()) {
                     std::shared_ptr<Stmt> s = World::get().
                             getStmtBuilder()->buildStmt(method, cfgStmt->getStmt(), varPool);
-                    stmts.emplace(cfgStmt->getStmt(), s);
+                    // a clang statement in several cfg elements keeps its first wrapper only
+                    if (stmts.emplace(cfgStmt->getStmt(), s).second) {
+                        stmtVec.emplace_back(s);
+                    }
                 }
             }
         }
@@ -3,7 +3,7 @@
 namespace analyzer::ir {
 
     NopStmt::NopStmt(const lang::CPPMethod& method)
-        :method(method)
+        :method(method), index(0)
     {
 
     }
@@ -53,4 +53,14 @@ namespace analyzer::ir {
         return nullptr;
     }
 
+    std::size_t NopStmt::getIndex() const
+    {
+        return index;
+    }
+
+    void NopStmt::setIndex(std::size_t index)
+    {
+        this->index = index;
+    }
+
 }
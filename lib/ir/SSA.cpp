@@ -0,0 +1,294 @@
+#include <algorithm>
+
+#include "ir/SSA.h"
+#include "analysis/graph/Dominators.h"
+
+namespace analyzer::ir {
+
+    SSA::SSA(const IR& ir)
+        :cfg(ir.getCFG())
+    {
+        std::vector<std::shared_ptr<Var>> irVars = ir.getVars();
+        vars.resize(irVars.size());
+        for (const std::shared_ptr<Var>& var : irVars) {
+            vars.at(var->getIndex()) = var;
+        }
+        std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+        for (std::size_t v = 0; v < vars.size(); v++) {
+            defKinds.emplace_back(DefKind::ENTRY);
+            defVars.emplace_back(v);
+            defNodes.emplace_back(entry);
+        }
+        collectAccesses();
+        placePhis();
+        rename();
+    }
+
+    std::size_t SSA::getDefNum() const
+    {
+        return defKinds.size();
+    }
+
+    SSA::DefKind SSA::getDefKind(std::size_t def) const
+    {
+        return defKinds[def];
+    }
+
+    const std::shared_ptr<Var>& SSA::getDefVar(std::size_t def) const
+    {
+        return vars[defVars[def]];
+    }
+
+    const std::shared_ptr<Stmt>& SSA::getDefStmt(std::size_t def) const
+    {
+        return cfg->getNode(defNodes[def]);
+    }
+
+    llvm::ArrayRef<std::size_t> SSA::getPhiOperands(std::size_t def) const
+    {
+        return llvm::ArrayRef<std::size_t>(phiOperands).slice(phiOperandOffsets[def],
+            phiOperandOffsets[def + 1] - phiOperandOffsets[def]);
+    }
+
+    llvm::ArrayRef<std::size_t> SSA::getPhisAt(const std::shared_ptr<Stmt>& stmt) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        if (node == cfg->getNodeNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::size_t>(phis).slice(phiOffsets[node], phiOffsets[node + 1] - phiOffsets[node]);
+    }
+
+    std::size_t SSA::getReachingDef(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        std::size_t v = varIndexOf(var);
+        if (node == cfg->getNodeNum() || v == vars.size()) {
+            return getDefNum();
+        }
+        auto begin = useVars.begin() + static_cast<std::ptrdiff_t>(useOffsets[node]);
+        auto end = useVars.begin() + static_cast<std::ptrdiff_t>(useOffsets[node + 1]);
+        auto it = std::lower_bound(begin, end, v);
+        if (it == end || *it != v) {
+            return getDefNum();
+        }
+        return useDefs[static_cast<std::size_t>(it - useVars.begin())];
+    }
+
+    std::size_t SSA::getDefAt(const std::shared_ptr<Stmt>& stmt, const std::shared_ptr<Var>& var) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        std::size_t v = varIndexOf(var);
+        if (node == cfg->getNodeNum() || v == vars.size()) {
+            return getDefNum();
+        }
+        auto begin = stmtDefVars.begin() + static_cast<std::ptrdiff_t>(defOffsets[node]);
+        auto end = stmtDefVars.begin() + static_cast<std::ptrdiff_t>(defOffsets[node + 1]);
+        auto it = std::lower_bound(begin, end, v);
+        if (it == end || *it != v) {
+            return getDefNum();
+        }
+        return stmtDefs[static_cast<std::size_t>(it - stmtDefVars.begin())];
+    }
+
+    llvm::ArrayRef<std::size_t> SSA::getUseDefsOf(const std::shared_ptr<Stmt>& stmt) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        if (node == cfg->getNodeNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::size_t>(useDefs).slice(useOffsets[node], useOffsets[node + 1] - useOffsets[node]);
+    }
+
+    llvm::ArrayRef<std::size_t> SSA::getDefsOf(const std::shared_ptr<Stmt>& stmt) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        if (node == cfg->getNodeNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<std::size_t>(stmtDefs).slice(defOffsets[node], defOffsets[node + 1] - defOffsets[node]);
+    }
+
+    std::size_t SSA::getPhiNum() const
+    {
+        return phis.size();
+    }
+
+    std::size_t SSA::varIndexOf(const std::shared_ptr<Var>& var) const
+    {
+        if (!var) {
+            return vars.size();
+        }
+        std::size_t v = var->getIndex();
+        return v < vars.size() && vars[v] == var ? v : vars.size();
+    }
+
+    void SSA::collectAccesses()
+    {
+        std::size_t n = cfg->getNodeNum();
+        useOffsets.assign(n + 1, 0);
+        defOffsets.assign(n + 1, 0);
+        std::vector<std::size_t> row;
+        for (std::size_t i = 0; i < n; i++) {
+            const std::shared_ptr<Stmt>& stmt = cfg->getNode(i);
+
+            row.clear();
+            for (const std::shared_ptr<Var>& var : stmt->getUses()) {
+                if (std::size_t v = varIndexOf(var); v != vars.size()) {
+                    row.emplace_back(v);
+                }
+            }
+            std::sort(row.begin(), row.end());
+            useVars.insert(useVars.end(), row.begin(), row.end());
+            useOffsets[i + 1] = useVars.size();
+
+            row.clear();
+            for (const std::shared_ptr<Var>& var : stmt->getDefs()) {
+                if (std::size_t v = varIndexOf(var); v != vars.size()) {
+                    row.emplace_back(v);
+                }
+            }
+            std::sort(row.begin(), row.end());
+            for (std::size_t v : row) {
+                stmtDefVars.emplace_back(v);
+                stmtDefs.emplace_back(defKinds.size());
+                defKinds.emplace_back(DefKind::STMT);
+                defVars.emplace_back(v);
+                defNodes.emplace_back(i);
+            }
+            defOffsets[i + 1] = stmtDefVars.size();
+        }
+    }
+
+    void SSA::placePhis()
+    {
+        std::size_t n = cfg->getNodeNum();
+        std::size_t varNum = vars.size();
+        std::shared_ptr<analysis::graph::DominatorTree> dom = cfg->getDominatorTree();
+
+        // the definition sites of each variable, the entry defines every variable
+        std::vector<std::vector<std::size_t>> defSites(varNum);
+        std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+        for (std::size_t v = 0; v < varNum; v++) {
+            defSites[v].emplace_back(entry);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t k = defOffsets[i]; k < defOffsets[i + 1]; k++) {
+                if (defSites[stmtDefVars[k]].back() != i) {
+                    defSites[stmtDefVars[k]].emplace_back(i);
+                }
+            }
+        }
+
+        // iterated dominance frontiers, phiPlaced and enqueued remember the last variable handled
+        std::vector<std::pair<std::size_t, std::size_t>> placed; // (node, var)
+        std::vector<std::size_t> phiPlaced(n, varNum);
+        std::vector<std::size_t> enqueued(n, varNum);
+        std::vector<std::size_t> workList;
+        for (std::size_t v = 0; v < varNum; v++) {
+            workList = defSites[v];
+            for (std::size_t site : workList) {
+                enqueued[site] = v;
+            }
+            while (!workList.empty()) {
+                std::size_t x = workList.back();
+                workList.pop_back();
+                for (std::size_t y : dom->getFrontierIndicesOf(x)) {
+                    if (phiPlaced[y] == v) {
+                        continue;
+                    }
+                    phiPlaced[y] = v;
+                    placed.emplace_back(y, v);
+                    if (enqueued[y] != v) {
+                        enqueued[y] = v;
+                        workList.emplace_back(y);
+                    }
+                }
+            }
+        }
+        std::sort(placed.begin(), placed.end());
+
+        phiOffsets.assign(n + 1, 0);
+        phis.clear();
+        phis.reserve(placed.size());
+        for (const auto& [node, v] : placed) {
+            phiOffsets[node + 1]++;
+            phis.emplace_back(defKinds.size());
+            defKinds.emplace_back(DefKind::PHI);
+            defVars.emplace_back(v);
+            defNodes.emplace_back(node);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            phiOffsets[i + 1] += phiOffsets[i];
+        }
+
+        phiOperandOffsets.assign(getDefNum() + 1, 0);
+        for (std::size_t def = 0; def < getDefNum(); def++) {
+            std::size_t operandNum = defKinds[def] == DefKind::PHI ?
+                    cfg->getPredIndicesOf(defNodes[def]).size() : 0;
+            phiOperandOffsets[def + 1] = phiOperandOffsets[def] + operandNum;
+        }
+        phiOperands.assign(phiOperandOffsets.back(), getDefNum());
+    }
+
+    void SSA::rename()
+    {
+        std::size_t n = cfg->getNodeNum();
+        useDefs.assign(useVars.size(), getDefNum());
+        std::shared_ptr<analysis::graph::DominatorTree> dom = cfg->getDominatorTree();
+        std::size_t entry = cfg->getNodeIndex(cfg->getEntry());
+        if (entry == n) {
+            return;
+        }
+
+        std::vector<std::vector<std::size_t>> stacks(vars.size());
+        for (std::size_t v = 0; v < vars.size(); v++) {
+            stacks[v].emplace_back(v);
+        }
+
+        auto enter = [&](std::size_t b) {
+            for (std::size_t k = phiOffsets[b]; k < phiOffsets[b + 1]; k++) {
+                stacks[defVars[phis[k]]].emplace_back(phis[k]);
+            }
+            for (std::size_t k = useOffsets[b]; k < useOffsets[b + 1]; k++) {
+                useDefs[k] = stacks[useVars[k]].back();
+            }
+            for (std::size_t k = defOffsets[b]; k < defOffsets[b + 1]; k++) {
+                stacks[stmtDefVars[k]].emplace_back(stmtDefs[k]);
+            }
+            for (std::size_t s : cfg->getSuccIndicesOf(b)) {
+                llvm::ArrayRef<std::size_t> preds = cfg->getPredIndicesOf(s);
+                auto position = static_cast<std::size_t>(
+                        std::lower_bound(preds.begin(), preds.end(), b) - preds.begin());
+                for (std::size_t k = phiOffsets[s]; k < phiOffsets[s + 1]; k++) {
+                    phiOperands[phiOperandOffsets[phis[k]] + position] = stacks[defVars[phis[k]]].back();
+                }
+            }
+        };
+        auto leave = [&](std::size_t b) {
+            for (std::size_t k = phiOffsets[b]; k < phiOffsets[b + 1]; k++) {
+                stacks[defVars[phis[k]]].pop_back();
+            }
+            for (std::size_t k = defOffsets[b]; k < defOffsets[b + 1]; k++) {
+                stacks[stmtDefVars[k]].pop_back();
+            }
+        };
+
+        std::vector<std::pair<std::size_t, std::size_t>> stack; // (node, next child)
+        enter(entry);
+        stack.emplace_back(entry, 0);
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            llvm::ArrayRef<std::size_t> children = dom->getChildIndicesOf(node);
+            if (next == children.size()) {
+                leave(node);
+                stack.pop_back();
+                continue;
+            }
+            std::size_t child = children[next++];
+            enter(child);
+            stack.emplace_back(child, 0);
+        }
+    }
+
+} // ir
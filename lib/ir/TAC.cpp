@@ -0,0 +1,340 @@
+#include <clang/AST/Expr.h>
+#include <clang/AST/Stmt.h>
+
+#include "ir/TAC.h"
+
+namespace analyzer::ir::tac {
+
+    //// ============== TAC ============== ////
+
+    TAC::TAC(const IR& ir)
+        :cfg(ir.getCFG()), maxTempNum(0)
+    {
+        std::vector<std::shared_ptr<Var>> irVars = ir.getVars();
+        vars.resize(irVars.size());
+        for (const std::shared_ptr<Var>& var : irVars) {
+            vars.at(var->getIndex()) = var;
+        }
+        std::size_t n = cfg->getNodeNum();
+        instructionOffsets.assign(n + 1, 0);
+        exprOffsets.assign(n + 1, 0);
+        TACBuilder builder(*this);
+        for (std::size_t i = 0; i < n; i++) {
+            builder.lower(cfg->getNode(i));
+            instructionOffsets[i + 1] = instructions.size();
+            exprOffsets[i + 1] = exprTemps.size();
+        }
+    }
+
+    llvm::ArrayRef<Instruction> TAC::getInstructionsOf(const std::shared_ptr<Stmt>& stmt) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        if (node == cfg->getNodeNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<Instruction>(instructions).slice(instructionOffsets[node],
+            instructionOffsets[node + 1] - instructionOffsets[node]);
+    }
+
+    llvm::ArrayRef<ExprTemp> TAC::getExprTempsOf(const std::shared_ptr<Stmt>& stmt) const
+    {
+        std::size_t node = cfg->getNodeIndex(stmt);
+        if (node == cfg->getNodeNum()) {
+            return {};
+        }
+        return llvm::ArrayRef<ExprTemp>(exprTemps).slice(exprOffsets[node], exprOffsets[node + 1] - exprOffsets[node]);
+    }
+
+    std::size_t TAC::getExprNum() const
+    {
+        return exprNumbers.size();
+    }
+
+    std::size_t TAC::getExprNumber(const clang::Expr* expr) const
+    {
+        auto it = exprNumbers.find(expr);
+        return it == exprNumbers.end() ? getExprNum() : it->second;
+    }
+
+    const llvm::APSInt& TAC::getConstant(std::uint32_t index) const
+    {
+        return constants[index];
+    }
+
+    const std::shared_ptr<Var>& TAC::getVar(std::uint32_t index) const
+    {
+        return vars[index];
+    }
+
+    std::size_t TAC::getMaxTempNum() const
+    {
+        return maxTempNum;
+    }
+
+    std::size_t TAC::getInstructionNum() const
+    {
+        return instructions.size();
+    }
+
+    std::string TAC::str(const Instruction& instruction) const
+    {
+        static const char* binaryOps[] = {"+", "-", "*", "/", "%", "&", "|", "^", "<<", ">>", "?"};
+        std::string dst = "t" + std::to_string(instruction.dst);
+        std::string a = "t" + std::to_string(instruction.a);
+        std::string b = "t" + std::to_string(instruction.b);
+        switch (instruction.opcode) {
+            case Opcode::CONST: {
+                const llvm::APSInt& constant = constants[instruction.a];
+                return dst + " = " + (constant.isSigned() ? std::to_string(constant.getSExtValue())
+                    : std::to_string(constant.getZExtValue()));
+            }
+            case Opcode::LOAD:
+                return dst + " = " + vars[instruction.a]->getName();
+            case Opcode::UNKNOWN:
+                return dst + " = unknown";
+            case Opcode::CAST:
+                return dst + " = (" + (instruction.isSigned ? "i" : "u")
+                    + std::to_string(instruction.width) + ") " + a;
+            case Opcode::NEG:
+                return dst + " = -" + a;
+            case Opcode::INC:
+                return dst + " = " + a + " + 1";
+            case Opcode::DEC:
+                return dst + " = " + a + " - 1";
+            case Opcode::BINARY:
+                return dst + " = " + a + " " + binaryOps[static_cast<std::size_t>(instruction.binaryOp)] + " " + b;
+            case Opcode::STORE:
+                return vars[instruction.dst]->getName() + " = " + a;
+        }
+        return "";
+    }
+
+    //// ============== TACBuilder ============== ////
+
+    namespace {
+
+        /**
+         * @param opcode a clang binary operator
+         * @return the operator of the corresponding BINARY instruction
+         */
+        BinaryOp toBinaryOp(clang::BinaryOperatorKind opcode)
+        {
+            switch (opcode) {
+                case clang::BO_Add:
+                case clang::BO_AddAssign:
+                    return BinaryOp::ADD;
+                case clang::BO_Sub:
+                case clang::BO_SubAssign:
+                    return BinaryOp::SUB;
+                case clang::BO_Mul:
+                case clang::BO_MulAssign:
+                    return BinaryOp::MUL;
+                case clang::BO_Div:
+                case clang::BO_DivAssign:
+                    return BinaryOp::DIV;
+                case clang::BO_Rem:
+                case clang::BO_RemAssign:
+                    return BinaryOp::REM;
+                case clang::BO_And:
+                case clang::BO_AndAssign:
+                    return BinaryOp::AND;
+                case clang::BO_Or:
+                case clang::BO_OrAssign:
+                    return BinaryOp::OR;
+                case clang::BO_Xor:
+                case clang::BO_XorAssign:
+                    return BinaryOp::XOR;
+                case clang::BO_Shl:
+                case clang::BO_ShlAssign:
+                    return BinaryOp::SHL;
+                case clang::BO_Shr:
+                case clang::BO_ShrAssign:
+                    return BinaryOp::SHR;
+                default:
+                    return BinaryOp::OTHER;
+            }
+        }
+
+        /**
+         * @param type an integer type
+         * @return the bit width of a builtin integer type, 0 for other types
+         */
+        std::uint8_t widthOf(clang::QualType type)
+        {
+            const auto* builtinType = type->getAs<clang::BuiltinType>();
+            if (!builtinType) {
+                return 0;
+            }
+            switch (builtinType->getKind()) {
+                case clang::BuiltinType::Kind::Bool:
+                    return 1;
+                case clang::BuiltinType::Kind::Char_U:
+                case clang::BuiltinType::Kind::UChar:
+                case clang::BuiltinType::Kind::Char_S:
+                case clang::BuiltinType::Kind::SChar:
+                    return 8;
+                case clang::BuiltinType::Kind::Char16:
+                case clang::BuiltinType::Kind::UShort:
+                case clang::BuiltinType::Kind::Short:
+                    return 16;
+                case clang::BuiltinType::Kind::Char32:
+                case clang::BuiltinType::Kind::UInt:
+                case clang::BuiltinType::Kind::Int:
+                    return 32;
+                case clang::BuiltinType::Kind::ULong:
+                case clang::BuiltinType::Kind::Long:
+                case clang::BuiltinType::Kind::ULongLong:
+                case clang::BuiltinType::Kind::LongLong:
+                    return 64;
+                default:
+                    return 0;
+            }
+        }
+
+    }
+
+    TACBuilder::TACBuilder(TAC& tac)
+        :tac(tac), tempNum(0)
+    {
+        for (const std::shared_ptr<Var>& var : tac.vars) {
+            const clang::VarDecl* varDecl = var->getClangVarDecl();
+            if (varDecl != nullptr && varDecl->getType()->isIntegerType()) {
+                varIndices.emplace(varDecl, static_cast<std::uint32_t>(var->getIndex()));
+            }
+        }
+    }
+
+    void TACBuilder::lower(const std::shared_ptr<Stmt>& stmt)
+    {
+        tempNum = 0;
+        const clang::Stmt* clangStmt = stmt->getClangStmt();
+        if (clangStmt == nullptr) {
+            return;
+        }
+        if (const auto* declStmt = llvm::dyn_cast<clang::DeclStmt>(clangStmt)) {
+            for (const clang::Decl* decl : declStmt->decls()) {
+                if (const auto* varDecl = llvm::dyn_cast<clang::VarDecl>(decl)) {
+                    if (varIndices.find(varDecl) != varIndices.end() && varDecl->hasInit()) {
+                        emitStore(varDecl, lowerExpr(varDecl->getInit()));
+                    }
+                }
+            }
+        } else if (const auto* expr = llvm::dyn_cast<clang::Expr>(clangStmt)) {
+            lowerExpr(expr);
+        }
+        tac.maxTempNum = std::max<std::size_t>(tac.maxTempNum, tempNum);
+    }
+
+    std::uint32_t TACBuilder::emit(Opcode opcode, std::uint32_t a, std::uint32_t b)
+    {
+        std::uint32_t dst = tempNum++;
+        tac.instructions.push_back(Instruction{opcode, BinaryOp::OTHER, false, 0, dst, a, b});
+        return dst;
+    }
+
+    void TACBuilder::emitStore(const clang::VarDecl* varDecl, std::uint32_t temp)
+    {
+        auto it = varIndices.find(varDecl);
+        if (it != varIndices.end()) {
+            tac.instructions.push_back(Instruction{Opcode::STORE, BinaryOp::OTHER, false, 0, it->second, temp, 0});
+        }
+    }
+
+    const clang::VarDecl* TACBuilder::referencedVarOf(const clang::Expr* expr)
+    {
+        if (const auto* declRef = llvm::dyn_cast<clang::DeclRefExpr>(expr)) {
+            return llvm::dyn_cast<clang::VarDecl>(declRef->getDecl());
+        }
+        return nullptr;
+    }
+
+    std::uint32_t TACBuilder::lowerExpr(const clang::Expr* expr)
+    {
+        std::uint32_t temp;
+        if (const auto* intLiteral = llvm::dyn_cast<clang::IntegerLiteral>(expr)) {
+            bool isUnsigned = !expr->getType()->isSignedIntegerType();
+            tac.constants.emplace_back(intLiteral->getValue(), isUnsigned);
+            temp = emit(Opcode::CONST, static_cast<std::uint32_t>(tac.constants.size() - 1));
+        } else if (const auto* characterLiteral = llvm::dyn_cast<clang::CharacterLiteral>(expr)) {
+            tac.constants.emplace_back(llvm::APInt(32, characterLiteral->getValue()), false);
+            temp = emit(Opcode::CONST, static_cast<std::uint32_t>(tac.constants.size() - 1));
+        } else if (const auto* castExpr = llvm::dyn_cast<clang::CastExpr>(expr)) {
+            std::uint32_t sub = lowerExpr(castExpr->getSubExpr());
+            switch (castExpr->getCastKind()) {
+                case clang::CastKind::CK_LValueToRValue:
+                    temp = sub;
+                    break;
+                case clang::CastKind::CK_IntegralCast:
+                case clang::CastKind::CK_NoOp:
+                    temp = emit(Opcode::CAST, sub);
+                    tac.instructions.back().width = widthOf(expr->getType());
+                    tac.instructions.back().isSigned = expr->getType()->isSignedIntegerType();
+                    break;
+                default:
+                    temp = emit(Opcode::UNKNOWN);
+            }
+        } else if (const auto* declRef = llvm::dyn_cast<clang::DeclRefExpr>(expr)) {
+            const auto* varDecl = llvm::dyn_cast<clang::VarDecl>(declRef->getDecl());
+            auto it = varIndices.find(varDecl);
+            temp = it != varIndices.end() ? emit(Opcode::LOAD, it->second) : emit(Opcode::UNKNOWN);
+        } else if (const auto* parenExpr = llvm::dyn_cast<clang::ParenExpr>(expr)) {
+            temp = lowerExpr(parenExpr->getSubExpr());
+        } else if (const auto* unaryOp = llvm::dyn_cast<clang::UnaryOperator>(expr)) {
+            const clang::Expr* subExpr = unaryOp->getSubExpr();
+            if (unaryOp->getOpcode() == clang::UnaryOperatorKind::UO_Plus) {
+                temp = lowerExpr(subExpr);
+            } else if (unaryOp->getOpcode() == clang::UnaryOperatorKind::UO_Minus) {
+                temp = emit(Opcode::NEG, lowerExpr(subExpr));
+            } else if (unaryOp->isIncrementDecrementOp()) {
+                std::uint32_t sub = lowerExpr(subExpr);
+                std::uint32_t updated = emit(unaryOp->isIncrementOp() ? Opcode::INC : Opcode::DEC, sub);
+                if (const clang::VarDecl* varDecl = referencedVarOf(subExpr)) {
+                    emitStore(varDecl, updated);
+                }
+                temp = unaryOp->isPostfix() ? sub : updated;
+            } else {
+                temp = emit(Opcode::UNKNOWN);
+            }
+        } else if (const auto* binaryOperator = llvm::dyn_cast<clang::BinaryOperator>(expr)) {
+            const clang::Expr* lhs = binaryOperator->getLHS();
+            std::uint32_t lhsTemp = lowerExpr(lhs);
+            std::uint32_t rhsTemp = lowerExpr(binaryOperator->getRHS());
+            if (binaryOperator->getOpcode() == clang::BinaryOperatorKind::BO_Assign) {
+                temp = rhsTemp;
+                if (const clang::VarDecl* varDecl = referencedVarOf(lhs)) {
+                    emitStore(varDecl, temp);
+                }
+            } else {
+                temp = emit(Opcode::BINARY, lhsTemp, rhsTemp);
+                tac.instructions.back().binaryOp = toBinaryOp(binaryOperator->getOpcode());
+                if (binaryOperator->isAssignmentOp()) {
+                    if (const clang::VarDecl* varDecl = referencedVarOf(lhs)) {
+                        emitStore(varDecl, temp);
+                    }
+                }
+            }
+        } else if (const auto* arraySubscriptExpr = llvm::dyn_cast<clang::ArraySubscriptExpr>(expr)) {
+            lowerExpr(arraySubscriptExpr->getBase());
+            lowerExpr(arraySubscriptExpr->getIdx());
+            temp = emit(Opcode::UNKNOWN);
+        } else if (const auto* conditionalOperator = llvm::dyn_cast<clang::ConditionalOperator>(expr)) {
+            lowerExpr(conditionalOperator->getCond());
+            lowerExpr(conditionalOperator->getTrueExpr());
+            lowerExpr(conditionalOperator->getFalseExpr());
+            temp = emit(Opcode::UNKNOWN);
+        } else if (const auto* callExpr = llvm::dyn_cast<clang::CallExpr>(expr)) {
+            lowerExpr(callExpr->getCallee());
+            for (const clang::Expr* arg : callExpr->arguments()) {
+                lowerExpr(arg);
+            }
+            temp = emit(Opcode::UNKNOWN);
+        } else {
+            temp = emit(Opcode::UNKNOWN);
+        }
+        // an expression lowered again, e.g. by a later statement sharing it, keeps its first number
+        auto it = tac.exprNumbers.try_emplace(expr, static_cast<std::uint32_t>(tac.exprNumbers.size())).first;
+        tac.exprTemps.push_back({expr, temp, it->second});
+        return temp;
+    }
+
+} // tac
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "util/AppendOnlyFile.h"
+
+namespace analyzer::util {
+
+    AppendOnlyFile::AppendOnlyFile(std::string path, std::size_t initialCapacity)
+        :path(std::move(path)), fd(-1), data(nullptr), capacity(std::max<std::size_t>(initialCapacity, 1)), size(0),
+        sizeMutex(), mappingMutex()
+    {
+        fd = ::open(this->path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create " + this->path + ": " + std::strerror(errno));
+        }
+        try {
+            data = map(capacity);
+        } catch (...) {
+            ::close(fd);
+            ::unlink(this->path.c_str());
+            throw;
+        }
+    }
+
+    AppendOnlyFile::~AppendOnlyFile()
+    {
+        if (data != nullptr) {
+            ::munmap(data, capacity);
+        }
+        ::close(fd);
+        ::unlink(path.c_str());
+    }
+
+    std::size_t AppendOnlyFile::append(const std::vector<uint8_t>& record)
+    {
+        std::size_t offset;
+        {
+            std::lock_guard<std::mutex> lock(sizeMutex);
+            offset = size;
+            size += record.size();
+        }
+        reserve(offset + record.size());
+        std::shared_lock<std::shared_mutex> lock(mappingMutex);
+        std::copy(record.begin(), record.end(), data + offset);
+        return offset;
+    }
+
+    std::vector<uint8_t> AppendOnlyFile::read(std::size_t offset, std::size_t length) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mappingMutex);
+        return {data + offset, data + offset + length};
+    }
+
+    const std::string& AppendOnlyFile::getPath() const
+    {
+        return path;
+    }
+
+    std::size_t AppendOnlyFile::getSize() const
+    {
+        std::lock_guard<std::mutex> lock(sizeMutex);
+        return size;
+    }
+
+    void AppendOnlyFile::reserve(std::size_t length)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mappingMutex);
+            if (length <= capacity) {
+                return;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mappingMutex);
+        if (length <= capacity) {
+            return;
+        }
+        std::size_t newCapacity = std::max(length, capacity * 2);
+        uint8_t* newData = map(newCapacity);
+        ::munmap(data, capacity);
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    uint8_t* AppendOnlyFile::map(std::size_t length) const
+    {
+        if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            throw std::runtime_error("Cannot grow " + path + ": " + std::strerror(errno));
+        }
+        void* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Cannot map " + path + ": " + std::strerror(errno));
+        }
+        return static_cast<uint8_t*>(mapping);
+    }
+
+} // util
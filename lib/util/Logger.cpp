@@ -14,6 +14,8 @@ namespace analyzer::util {
             {Color::WHITE, "\033[37m"}
     };
 
+    std::mutex Logger::mutex;
+
     Logger::Logger(llvm::raw_ostream* os, bool enabled)
         :os(os), enabled(enabled)
     {
@@ -50,6 +52,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << colors.at(Color::CYAN) << "[ Progress ] " << str
             << colors.at(Color::RESET) << "\n";
     }
@@ -59,6 +62,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << colors.at(Color::YELLOW) << "[ Warning ] " << str
             << colors.at(Color::RESET) << "\n";
     }
@@ -68,6 +72,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << "[ Info ] " << str << "\n";
     }
 
@@ -76,6 +81,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << colors.at(Color::RED) << "[ Error ] " << str
             << colors.at(Color::RESET) << "\n";
     }
@@ -85,6 +91,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << colors.at(Color::BLUE) << "[ Debug ] " << str
             << colors.at(Color::RESET) << "\n";
     }
@@ -94,6 +101,7 @@ namespace analyzer::util {
         if (!enabled) {
             return;
         }
+        std::lock_guard<std::mutex> lock(mutex);
         *os << colors.at(Color::GREEN) << "[ Success ] " << str
             << colors.at(Color::RESET) << "\n";
     }
@@ -0,0 +1,38 @@
+/**
+ * @brief Test case for bottom-up scheduling over the call graph.
+ */
+
+int isOdd(int n);
+
+int isEven(int n) {
+    if (n == 0) {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
+
+int isOdd(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+int fact(int n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int leaf(int x) {
+    return x + 1;
+}
+
+int mid(int x) {
+    return leaf(x) + isEven(x);
+}
+
+int main() {
+    return mid(1) + fact(3) + leaf(2);
+}
@@ -0,0 +1,99 @@
+#ifndef STATIC_ANALYZER_DATAFLOWOPTIONTEST_H
+#define STATIC_ANALYZER_DATAFLOWOPTIONTEST_H
+
+#include "doctest.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "analysis/dataflow/BoundaryDataflowResult.h"
+#include "analysis/dataflow/fact/SetFact.h"
+#include "config/AnalysisConfig.h"
+
+/**
+ * @brief check that a set fact analysis reaches the fixed point of its default configuration under
+ * every combination of the values of the options "solver", "fact-storage" and "set-fact"
+ *
+ * The facts are queried backwards, so that most queries of facts kept at block boundaries replay a chain.
+ *
+ * @tparam Element the element type of the set facts
+ * @tparam Analysis the analysis driver, constructible from an analysis config
+ * @param name the name of the analysis, used in the descriptions of its configurations
+ * @param defaultAnalysis the analysis in its default configuration
+ * @param irs the irs to analyze
+ * @param boundaryDropsFacts whether keeping the facts at block boundaries stores fewer facts than
+ * keeping them all on every ir
+ */
+template <typename Element, typename Analysis>
+void checkOptionCombinations(const std::string& name, Analysis& defaultAnalysis,
+                             const std::vector<std::shared_ptr<analyzer::ir::IR>>& irs, bool boundaryDropsFacts)
+{
+    using Fact = analyzer::analysis::dataflow::fact::SetFact<Element>;
+    using Kind = typename Fact::Kind;
+
+    // the default solver visits the nodes in priority order, and no analysis of set facts widens,
+    // so every solver must reach the same fixed point
+    const std::vector<std::string> solvers{"priority", "worklist", "delta", "wto"};
+    // pairs of the fact storage and the boundary cache size
+    const std::vector<std::pair<std::string, std::string>> factStorages{
+        {"all", ""}, {"boundary", "0"}, {"boundary", "2"}, {"boundary", "4"}};
+    const std::vector<std::pair<std::string, Kind>> setFacts{
+        {"hash-set", Kind::HASH_SET},
+        {"bit-vector", Kind::BIT_VECTOR},
+        {"sparse-bit-vector", Kind::SPARSE_BIT_VECTOR},
+        {"persistent", Kind::PERSISTENT},
+        {"auto", Kind::BIT_VECTOR}};
+
+    std::vector<std::shared_ptr<analyzer::analysis::dataflow::fact::DataflowResult<Fact>>> expected;
+    for (const std::shared_ptr<analyzer::ir::IR>& ir : irs) {
+        expected.emplace_back(defaultAnalysis.analyze(ir));
+    }
+
+    for (const std::string& solver : solvers) {
+        for (const auto& [factStorage, cacheSize] : factStorages) {
+            for (const auto& [setFact, kind] : setFacts) {
+                std::unordered_map<std::string, std::string> options{
+                    {"solver", solver}, {"fact-storage", factStorage}, {"set-fact", setFact}};
+                std::string description = name + " with solver " + solver + ", fact storage " + factStorage;
+                if (!cacheSize.empty()) {
+                    options.emplace("boundary-cache-size", cacheSize);
+                    description += " caching " + cacheSize;
+                }
+                description += " and set fact " + setFact;
+                std::unique_ptr<analyzer::config::AnalysisConfig> analysisConfig
+                    = std::make_unique<analyzer::config::DefaultAnalysisConfig>(description, options);
+                Analysis analysis(analysisConfig);
+
+                for (std::size_t i = 0; i < irs.size(); i++) {
+                    std::shared_ptr<analyzer::analysis::dataflow::fact::DataflowResult<Fact>> actual
+                        = analysis.analyze(irs[i]);
+                    const std::vector<std::shared_ptr<analyzer::ir::Stmt>>& nodes = irs[i]->getCFG()->getNodes();
+                    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+                        std::shared_ptr<Fact> outFact = actual->getOutFact(*it);
+                        std::shared_ptr<Fact> inFact = actual->getInFact(*it);
+                        CHECK_EQ(outFact->getKind(), kind);
+                        CHECK_EQ(inFact->getKind(), kind);
+                        CHECK(outFact->equalsTo(expected[i]->getOutFact(*it)));
+                        CHECK(expected[i]->getOutFact(*it)->equalsTo(outFact));
+                        CHECK(inFact->equalsTo(expected[i]->getInFact(*it)));
+                    }
+                    auto boundaryResult = std::dynamic_pointer_cast<
+                        analyzer::analysis::dataflow::BoundaryDataflowResult<Fact>>(actual);
+                    REQUIRE_EQ(boundaryResult != nullptr, factStorage == "boundary");
+                    if (boundaryResult) {
+                        CHECK_LE(boundaryResult->getStoredFactNum(), boundaryResult->getFullFactNum());
+                        if (boundaryDropsFacts) {
+                            CHECK_LT(boundaryResult->getStoredFactNum(), boundaryResult->getFullFactNum());
+                        }
+                        CHECK_EQ(boundaryResult->getQueryNum(), 2 * nodes.size());
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif //STATIC_ANALYZER_DATAFLOWOPTIONTEST_H
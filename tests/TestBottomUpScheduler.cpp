@@ -0,0 +1,139 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <set>
+
+#include "World.h"
+#include "analysis/SummaryAnalysis.h"
+
+namespace al = analyzer;
+namespace air = al::ir;
+namespace cf = al::config;
+namespace lang = al::language;
+namespace graph = al::analysis::graph;
+namespace ana = al::analysis;
+
+/**
+ * @brief a toy summary analysis computing the methods transitively called by each method
+ */
+class ReachableMethods: public ana::SummaryAnalysis<std::set<std::size_t>> {
+public:
+
+    explicit ReachableMethods(std::unique_ptr<cf::AnalysisConfig>& analysisConfig)
+        :ana::SummaryAnalysis<std::set<std::size_t>>(analysisConfig)
+    {
+
+    }
+
+    [[nodiscard]] std::shared_ptr<std::set<std::size_t>> analyze(std::shared_ptr<air::IR> myIR) override
+    {
+        const std::shared_ptr<graph::CallGraph>& cg = getCallGraph();
+        std::size_t id = cg->getMethodId(myIR->getMethod());
+        std::shared_ptr<std::set<std::size_t>> summary = std::make_shared<std::set<std::size_t>>();
+        for (std::size_t callee : cg->getCalleeIdsOf(id)) {
+            summary->emplace(callee);
+            std::shared_ptr<std::set<std::size_t>> calleeSummary = getSummaryOf(callee);
+            if (calleeSummary) {
+                summary->insert(calleeSummary->begin(), calleeSummary->end());
+            } else {
+                missingCallees++;
+            }
+        }
+        return summary;
+    }
+
+    [[nodiscard]] std::shared_ptr<std::set<std::size_t>> newInitialSummary(const lang::CPPMethod& method) const override
+    {
+        return std::make_shared<std::set<std::size_t>>();
+    }
+
+    [[nodiscard]] bool isSameSummary(const std::shared_ptr<std::set<std::size_t>>& s1,
+                                     const std::shared_ptr<std::set<std::size_t>>& s2) const override
+    {
+        return *s1 == *s2;
+    }
+
+    std::atomic<std::size_t> missingCallees{0}; ///< callee summaries not available when needed
+
+};
+
+class BottomUpSchedulerTestFixture {
+protected:
+    std::shared_ptr<graph::CallGraph> cg;
+    std::size_t mainId, midId, leafId, factId, isEvenId, isOddId;
+public:
+    BottomUpSchedulerTestFixture() {
+        al::World::initialize("resources/callgraph");
+        const al::World& world = al::World::get();
+        cg = world.getCallGraph();
+        mainId = cg->getMethodId(*world.getMethodBySignature("int main()"));
+        midId = cg->getMethodId(*world.getMethodBySignature("int mid(int)"));
+        leafId = cg->getMethodId(*world.getMethodBySignature("int leaf(int)"));
+        factId = cg->getMethodId(*world.getMethodBySignature("int fact(int)"));
+        isEvenId = cg->getMethodId(*world.getMethodBySignature("int isEven(int)"));
+        isOddId = cg->getMethodId(*world.getMethodBySignature("int isOdd(int)"));
+    }
+};
+
+TEST_SUITE_BEGIN("testBottomUpScheduler");
+
+TEST_CASE_FIXTURE(BottomUpSchedulerTestFixture, "testSCCs"
+    * doctest::description("testing strongly connected components of the call graph")) {
+
+    al::World::getLogger().Progress("Testing strongly connected components of the call graph ...");
+
+    ana::BottomUpScheduler scheduler(cg);
+    CHECK_EQ(scheduler.getSCCNum(), 5);
+    CHECK_EQ(scheduler.getSCCOf(isEvenId), scheduler.getSCCOf(isOddId));
+    CHECK_EQ(scheduler.getMethodIdsOf(scheduler.getSCCOf(isEvenId)).size(), 2);
+    CHECK(scheduler.isRecursive(scheduler.getSCCOf(isEvenId)));
+    CHECK(scheduler.isRecursive(scheduler.getSCCOf(factId)));
+    CHECK_FALSE(scheduler.isRecursive(scheduler.getSCCOf(leafId)));
+    CHECK_FALSE(scheduler.isRecursive(scheduler.getSCCOf(mainId)));
+
+    // callee sccs are numbered before their callers
+    for (std::size_t scc = 0; scc < scheduler.getSCCNum(); scc++) {
+        for (std::size_t callee : scheduler.getCalleeSCCsOf(scc)) {
+            CHECK_LT(callee, scc);
+        }
+    }
+    CHECK_EQ(scheduler.getSCCOf(mainId), scheduler.getSCCNum() - 1);
+    CHECK_EQ(scheduler.getCalleeSCCsOf(scheduler.getSCCOf(mainId)).size(), 3);
+    CHECK_EQ(scheduler.getCallerSCCsOf(scheduler.getSCCOf(leafId)).size(), 2);
+    CHECK_EQ(scheduler.getCriticalPathLength(), 3);
+
+    al::World::getLogger().Success("Finish testing strongly connected components of the call graph ...");
+
+}
+
+TEST_CASE_FIXTURE(BottomUpSchedulerTestFixture, "testSummaries"
+    * doctest::description("testing bottom-up summary computation")) {
+
+    al::World::getLogger().Progress("Testing bottom-up summary computation ...");
+
+    std::unique_ptr<cf::AnalysisConfig> analysisConfig
+        = std::make_unique<cf::DefaultAnalysisConfig>("reachable methods");
+    ReachableMethods analysis(analysisConfig);
+    ana::BottomUpScheduler scheduler(cg);
+
+    for (std::size_t threadNum : {1, 4}) {
+        analysis.analyzeAll(scheduler, threadNum);
+        CHECK_EQ(analysis.missingCallees.load(), 0);
+
+        CHECK_EQ(*analysis.getSummaryOf(mainId), std::set<std::size_t>{midId, leafId, factId, isEvenId, isOddId});
+        CHECK_EQ(*analysis.getSummaryOf(midId), std::set<std::size_t>{leafId, isEvenId, isOddId});
+        CHECK_EQ(*analysis.getSummaryOf(isEvenId), std::set<std::size_t>{isEvenId, isOddId});
+        CHECK_EQ(*analysis.getSummaryOf(isOddId), std::set<std::size_t>{isEvenId, isOddId});
+        CHECK_EQ(*analysis.getSummaryOf(factId), std::set<std::size_t>{factId});
+        CHECK(analysis.getSummaryOf(leafId)->empty());
+
+        CHECK_GE(scheduler.getTotalWork(), 0);
+        CHECK_GE(scheduler.getTotalWork() + 1e-9, scheduler.getCriticalPathWork());
+        CHECK_GE(scheduler.getParallelism(), 0);
+    }
+
+    al::World::getLogger().Success("Finish testing bottom-up summary computation ...");
+
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,86 @@
+#include "doctest.h"
+
+#include "World.h"
+#include "analysis/graph/CallGraph.h"
+
+namespace al = analyzer;
+namespace lang = al::language;
+namespace graph = al::analysis::graph;
+
+class CallGraphTestFixture {
+protected:
+    std::shared_ptr<lang::CPPMethod> mainMethod, factorCtor, factor, factorGetNum, fibCtor, fib, fibGetNum;
+public:
+    CallGraphTestFixture() {
+        al::World::initialize("resources/example01/src",
+                              "resources/example01/include");
+        const al::World& world = al::World::get();
+        mainMethod = world.getMainMethod();
+        factorCtor = world.getMethodBySignature("void example01::Factor::Factor(int)");
+        factor = world.getMethodBySignature("int example01::Factor::factor(int)");
+        factorGetNum = world.getMethodBySignature("int example01::Factor::getNum()");
+        fibCtor = world.getMethodBySignature("void example01::Fib::Fib(int)");
+        fib = world.getMethodBySignature("int example01::Fib::fib(int)");
+        fibGetNum = world.getMethodBySignature("int example01::Fib::getNum()");
+    }
+};
+
+TEST_SUITE_BEGIN("testCallGraph");
+
+TEST_CASE_FIXTURE(CallGraphTestFixture, "testDirectCalls"
+    * doctest::description("testing call graph with direct calls")) {
+
+    al::World::getLogger().Progress("Testing call graph with direct calls ...");
+
+    std::shared_ptr<graph::CallGraph> cg = al::World::get().getCallGraph();
+    CHECK_EQ(cg, al::World::get().getCallGraph());
+    CHECK_EQ(cg->getMethodNum(), al::World::get().getAllMethods().size());
+
+    std::size_t m = cg->getMethodId(*mainMethod);
+    REQUIRE_LT(m, cg->getMethodNum());
+    CHECK_EQ(cg->getMethod(m), mainMethod);
+
+    // the virtual calls in main target abstract methods without a body
+    CHECK_EQ(cg->getCalleeIdsOf(m).size(), 2);
+    CHECK(cg->hasEdge(m, cg->getMethodId(*factorCtor)));
+    CHECK(cg->hasEdge(m, cg->getMethodId(*fibCtor)));
+    CHECK_FALSE(cg->hasEdge(m, cg->getMethodId(*factor)));
+    CHECK_EQ(cg->getCallSitesOf(m).size(), 2);
+    CHECK_EQ(cg->getEdgeNum(), 2);
+
+    llvm::ArrayRef<std::size_t> callers = cg->getCallerIdsOf(cg->getMethodId(*fibCtor));
+    REQUIRE_EQ(callers.size(), 1);
+    CHECK_EQ(callers[0], m);
+    CHECK(cg->getCallerIdsOf(m).empty());
+    CHECK(cg->getCalleeIdsOf(cg->getMethodId(*fib)).empty());
+
+    al::World::getLogger().Success("Finish testing call graph with direct calls ...");
+
+}
+
+TEST_CASE_FIXTURE(CallGraphTestFixture, "testVirtualCalls"
+    * doctest::description("testing call graph with class hierarchy analysis")) {
+
+    al::World::getLogger().Progress("Testing call graph with class hierarchy analysis ...");
+
+    graph::CallGraph cg(al::World::get().getAllMethods(), true, 2);
+
+    std::size_t m = cg.getMethodId(*mainMethod);
+    CHECK_EQ(cg.getCalleeIdsOf(m).size(), 6);
+    for (const std::shared_ptr<lang::CPPMethod>& callee : {factorCtor, factor, factorGetNum, fibCtor, fib, fibGetNum}) {
+        std::size_t c = cg.getMethodId(*callee);
+        CHECK(cg.hasEdge(m, c));
+        llvm::ArrayRef<std::size_t> callers = cg.getCallerIdsOf(c);
+        REQUIRE_EQ(callers.size(), 1);
+        CHECK_EQ(callers[0], m);
+    }
+    CHECK_EQ(cg.getCallSitesOf(m).size(), 6);
+    for (const graph::CallSite& site : cg.getCallSitesOf(m)) {
+        CHECK(site.callExpr);
+    }
+
+    al::World::getLogger().Success("Finish testing call graph with class hierarchy analysis ...");
+
+}
+
+TEST_SUITE_END();
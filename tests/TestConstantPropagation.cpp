@@ -2,9 +2,14 @@
 
 #include "World.h"
 #include "analysis/dataflow/ConstantPropagation.h"
+#include "analysis/dataflow/fact/ResultStore.h"
+#include "ir/TAC.h"
 
+#include <filesystem>
 #include <iostream>
 
+#include <unistd.h>
+
 namespace al = analyzer;
 namespace air = al::ir;
 namespace cf = al::config;
@@ -407,5 +412,357 @@ TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationCall"
 
 }
 
-TEST_SUITE_END();
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationTAC"
+    * doctest::description("testing constant propagation over three-address code")) {
+
+    al::World::getLogger().Progress("Testing constant propagation over three-address code ...");
+
+    std::unique_ptr<cf::AnalysisConfig> analysisConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+        "constant propagation analysis over tac", std::unordered_map<std::string, std::string>{{"use-tac", "true"}});
+    df::ConstantPropagation tacCP(analysisConfig);
+
+    auto sameValue = [](const std::shared_ptr<df::CPValue>& v1, const std::shared_ptr<df::CPValue>& v2) {
+        if (v1->isConstant() && v2->isConstant()) {
+            return v1->getConstantValue() == v2->getConstantValue();
+        }
+        return v1->isConstant() == v2->isConstant() && v1->isNAC() == v2->isNAC();
+    };
+
+    for (const std::shared_ptr<air::IR>& ir : {dummy, typeCast, ifElse, binaryOp, loop, incDec, array, call}) {
+        std::shared_ptr<df::CPResult> expected = std::dynamic_pointer_cast<df::CPResult>(cp->analyze(ir));
+        std::shared_ptr<df::CPResult> actual = std::dynamic_pointer_cast<df::CPResult>(tacCP.analyze(ir));
+        std::shared_ptr<air::tac::TAC> tac = ir->getTAC();
+        CHECK_GT(tac->getInstructionNum(), 0U);
+        for (const std::shared_ptr<air::Stmt>& s : ir->getStmts()) {
+            for (const air::tac::Instruction& instruction : tac->getInstructionsOf(s)) {
+                al::World::getLogger().Debug(tac->str(instruction));
+            }
+            CHECK(actual->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+            for (const auto& [expr, temp, number] : tac->getExprTempsOf(s)) {
+                CHECK_LT(number, tac->getExprNum());
+                CHECK_EQ(tac->getExprNumber(expr), number);
+                std::shared_ptr<df::CPValue> expectedValue = expected->getExprValue(expr);
+                std::shared_ptr<df::CPValue> actualValue = actual->getExprValue(expr);
+                REQUIRE(expectedValue);
+                REQUIRE(actualValue);
+                CHECK(sameValue(actualValue, expectedValue));
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing constant propagation over three-address code ...");
+
+}
+
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationMapFactKinds"
+    * doctest::description("testing constant propagation over all map fact representations")) {
+
+    al::World::getLogger().Progress("Testing constant propagation over all map fact representations ...");
+
+    for (const auto& [option, kind] : std::vector<std::pair<std::string, df::CPFact::Kind>>{
+            {"hash-map", df::HashCPFact::KIND}, {"persistent", df::PersistentCPFact::KIND},
+            {"flat", df::FlatCPFact::KIND}, {"dense", df::CPFact::Kind::DENSE}}) {
+        std::unique_ptr<cf::AnalysisConfig> analysisConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+            "constant propagation analysis over " + option + " facts",
+            std::unordered_map<std::string, std::string>{{"map-fact", option}});
+        df::ConstantPropagation otherCP(analysisConfig);
+
+        for (const std::shared_ptr<air::IR>& ir : {dummy, typeCast, ifElse, binaryOp, loop, incDec, array, call}) {
+            std::shared_ptr<dfact::DataflowResult<df::CPFact>> expected = cp->analyze(ir);
+            std::shared_ptr<dfact::DataflowResult<df::CPFact>> actual = otherCP.analyze(ir);
+            for (const std::shared_ptr<air::Stmt>& s : ir->getCFG()->getNodes()) {
+                CHECK_EQ(actual->getOutFact(s)->getKind(), kind);
+                CHECK(actual->getInFact(s)->equalsTo(expected->getInFact(s)));
+                CHECK(actual->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+                CHECK(expected->getOutFact(s)->equalsTo(actual->getOutFact(s)));
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing constant propagation over all map fact representations ...");
+
+}
+
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testDenseCPFact"
+    * doctest::description("testing dense constant propagation facts")) {
+
+    al::World::getLogger().Progress("Testing dense constant propagation facts ...");
+
+    std::vector<std::shared_ptr<air::Var>> vars = binaryOp->getVars();
+    REQUIRE_GE(vars.size(), 3);
+    auto universe = std::make_shared<df::DenseCPFact::Universe>(vars.size());
+    for (const std::shared_ptr<air::Var>& v : vars) {
+        universe->at(v->getIndex()) = v;
+    }
+    std::shared_ptr<air::Var> a = vars[0];
+    std::shared_ptr<air::Var> b = vars[1];
+    std::shared_ptr<air::Var> c = vars[2];
+    std::shared_ptr<air::Var> unknown = loop->getVars().front();
+
+    auto wideConstants = std::make_shared<df::WideConstantTable>();
+    df::CPValue one = df::CPValue::constant(llvm::APSInt(llvm::APInt(32, 1), false));
+    df::CPValue two = df::CPValue::constant(llvm::APSInt(llvm::APInt(32, 2), false));
+    llvm::APSInt wide(llvm::APInt(128, 1).shl(100), true);
+    df::CPValue wideOne = df::CPValue::constant(wide, wideConstants.get());
+    df::CPValue wideTwo = df::CPValue::constant(wide + wide, wideConstants.get());
+
+    auto fact1 = std::make_shared<df::DenseCPFact>(universe, wideConstants);
+    CHECK(fact1->isEmpty());
+    CHECK(fact1->updateValue(a, one));
+    CHECK_FALSE(fact1->updateValue(a, one));
+    CHECK(fact1->updateValue(b, wideOne));
+    CHECK_FALSE(fact1->update(b, df::CPValue::makeConstant(wide)));
+    CHECK_EQ(fact1->getValue(b), wideOne);
+    CHECK_EQ(fact1->get(b)->getConstantValue(), wide);
+    CHECK_EQ(fact1->size(), 2);
+
+    // unknown variables are Undef, and cannot be bound
+    CHECK(fact1->getValue(unknown).isUndef());
+    CHECK(fact1->get(unknown)->isUndef());
+    CHECK_EQ(fact1->remove(unknown), nullptr);
+    CHECK_THROWS_AS(fact1->updateValue(unknown, one), std::runtime_error);
+
+    // a meet keeps equal constants, even wide ones, and turns different ones into NAC
+    auto fact2 = std::make_shared<df::DenseCPFact>(universe, wideConstants);
+    CHECK(fact2->updateValue(a, one));
+    CHECK(fact2->updateValue(b, wideOne));
+    CHECK(fact2->updateValue(c, two));
+    CHECK(fact1->meetWith(*fact2));
+    CHECK_EQ(fact1->getValue(a), one);
+    CHECK_EQ(fact1->getValue(b), wideOne);
+    CHECK_EQ(fact1->getValue(c), two);
+    CHECK(fact1->equalsTo(fact2));
+    CHECK_FALSE(fact1->meetWith(*fact2));
+    CHECK_FALSE(fact1->meetWith(*fact1));
+    CHECK(fact2->updateValue(b, wideTwo));
+    CHECK(fact1->meetWith(*fact2));
+    CHECK(fact1->getValue(b).isNAC());
+    CHECK_FALSE(fact1->equalsTo(fact2));
+
+    // a copy overwrites the variables bound in the source only
+    auto fact3 = std::make_shared<df::DenseCPFact>(universe, wideConstants);
+    CHECK(fact3->updateValue(c, df::CPValue::nac()));
+    CHECK(fact3->copyFrom(fact1));
+    CHECK(fact3->equalsTo(fact1));
+    CHECK_FALSE(fact3->copyFrom(fact1));
+    auto fact4 = std::make_shared<df::DenseCPFact>(universe, wideConstants);
+    CHECK(fact4->updateValue(a, wideTwo));
+    CHECK(fact3->copyFrom(fact4));
+    CHECK_EQ(fact3->getValue(a), wideTwo);
+    CHECK(fact3->getValue(b).isNAC());
+
+    // facts of other representations or wide constant tables are compared mapping by mapping
+    auto hashFact = std::make_shared<df::HashCPFact>();
+    CHECK(hashFact->copyFrom(fact2));
+    CHECK(hashFact->equalsTo(fact2));
+    CHECK(fact2->equalsTo(hashFact));
+    auto otherTable = std::make_shared<df::DenseCPFact>(universe);
+    CHECK(otherTable->copyFrom(fact2));
+    CHECK(otherTable->equalsTo(fact2));
+    CHECK(fact2->equalsTo(otherTable));
+    CHECK_FALSE(otherTable->copyFrom(hashFact));
+    CHECK(hashFact->updateValue(b, wideOne));
+    CHECK_FALSE(hashFact->equalsTo(fact2));
+    CHECK_FALSE(fact2->equalsTo(hashFact));
+    CHECK_FALSE(otherTable->equalsTo(hashFact));
+
+    // a hash map fact interns its wide constants in its own table, which outlives the one of the value
+    llvm::APSInt wideThree = wide + wide + wide;
+    {
+        auto valueTable = std::make_shared<df::WideConstantTable>();
+        CHECK(hashFact->updateValue(c, df::CPValue::constant(wideThree, valueTable.get())));
+    }
+    CHECK_EQ(hashFact->getValue(c).getConstantValue(), wideThree);
+    CHECK_EQ(hashFact->copy()->get(c)->getConstantValue(), wideThree);
+    CHECK(hashFact->updateValue(c, df::CPValue::undef()));
+    CHECK(hashFact->getValue(c).isUndef());
+
+    std::shared_ptr<df::CPValue> removed = fact2->remove(b);
+    REQUIRE(removed);
+    CHECK_EQ(*removed, wideTwo);
+    CHECK_EQ(fact2->remove(b), nullptr);
+    CHECK_EQ(fact2->size(), 2);
+    fact2->clear();
+    CHECK(fact2->isEmpty());
+
+    al::World::getLogger().Success("Finish testing dense constant propagation facts ...");
+
+}
+
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationExprValueRecording"
+    * doctest::description("testing constant propagation recording expression values at the fixed point or not at all")) {
+
+    al::World::getLogger().Progress("Testing constant propagation recording expression values at the fixed point or not at all ...");
+
+    for (const char* useTAC : {"false", "true"}) {
+        std::unique_ptr<cf::AnalysisConfig> finalConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+            "constant propagation analysis recording final expression values",
+            std::unordered_map<std::string, std::string>{{"expr-values", "final"}, {"use-tac", useTAC}});
+        df::ConstantPropagation finalCP(finalConfig);
+        std::unique_ptr<cf::AnalysisConfig> offConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+            "constant propagation analysis recording no expression values",
+            std::unordered_map<std::string, std::string>{{"expr-values", "off"}, {"use-tac", useTAC}});
+        df::ConstantPropagation offCP(offConfig);
+
+        for (const std::shared_ptr<air::IR>& ir : {dummy, typeCast, ifElse, binaryOp, loop, incDec, array, call}) {
+            std::shared_ptr<df::CPResult> expected = std::dynamic_pointer_cast<df::CPResult>(cp->analyze(ir));
+            std::shared_ptr<df::CPResult> recordedFinal = std::dynamic_pointer_cast<df::CPResult>(finalCP.analyze(ir));
+            std::shared_ptr<df::CPResult> recordedNone = std::dynamic_pointer_cast<df::CPResult>(offCP.analyze(ir));
+            CHECK_EQ(recordedFinal->getExprValueNum(), expected->getExprValueNum());
+            CHECK_EQ(recordedNone->getExprValueNum(), 0U);
+            for (const std::shared_ptr<air::Stmt>& s : ir->getStmts()) {
+                CHECK(recordedFinal->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+                CHECK(recordedNone->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+                for (const air::tac::ExprTemp& exprTemp : ir->getTAC()->getExprTempsOf(s)) {
+                    REQUIRE(expected->findExprValue(exprTemp.expr));
+                    REQUIRE(recordedFinal->findExprValue(exprTemp.expr));
+                    CHECK(*recordedFinal->findExprValue(exprTemp.expr) == *expected->findExprValue(exprTemp.expr));
+                    CHECK_EQ(recordedNone->findExprValue(exprTemp.expr), nullptr);
+                }
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing constant propagation recording expression values at the fixed point or not at all ...");
 
+}
+
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationBoundaryFacts"
+    * doctest::description("testing constant propagation keeping its facts only at block boundaries")) {
+
+    al::World::getLogger().Progress("Testing constant propagation keeping its facts only at block boundaries ...");
+
+    for (const char* useTAC : {"false", "true"}) {
+        for (const char* exprValues : {"full", "final"}) {
+            for (const char* cacheSize : {"0", "2"}) {
+                std::unique_ptr<cf::AnalysisConfig> analysisConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+                    "constant propagation analysis keeping the facts at block boundaries",
+                    std::unordered_map<std::string, std::string>{{"fact-storage", "boundary"},
+                        {"boundary-cache-size", cacheSize}, {"expr-values", exprValues}, {"use-tac", useTAC}});
+                df::ConstantPropagation boundaryCP(analysisConfig);
+
+                std::size_t replayNum = 0;
+                for (const std::shared_ptr<air::IR>& ir : {dummy, typeCast, ifElse, binaryOp, loop, incDec, array, call}) {
+                    std::shared_ptr<df::CPResult> expected = std::dynamic_pointer_cast<df::CPResult>(cp->analyze(ir));
+                    std::shared_ptr<df::CPResult> actual = std::dynamic_pointer_cast<df::CPResult>(boundaryCP.analyze(ir));
+                    REQUIRE(actual);
+                    auto boundaryResult = std::dynamic_pointer_cast<df::BoundaryCPResult>(actual)->getBoundaryResult();
+                    REQUIRE(boundaryResult);
+                    CHECK_LE(boundaryResult->getStoredFactNum(), boundaryResult->getFullFactNum());
+                    CHECK_EQ(actual->getExprValueNum(), expected->getExprValueNum());
+
+                    // querying backwards replays the chains, which re-records the expression values with "full"
+                    const std::vector<std::shared_ptr<air::Stmt>>& nodes = ir->getCFG()->getNodes();
+                    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+                        CHECK(actual->getOutFact(*it)->equalsTo(expected->getOutFact(*it)));
+                        CHECK(actual->getInFact(*it)->equalsTo(expected->getInFact(*it)));
+                    }
+                    CHECK_EQ(boundaryResult->getQueryNum(), 2 * nodes.size());
+                    CHECK_GE(boundaryResult->getQueryTime(), 0.0);
+                    replayNum += boundaryResult->getReplayedTransferNum();
+
+                    auto innerResult = std::dynamic_pointer_cast<df::CPResult>(boundaryResult->getInnerResult());
+                    REQUIRE(innerResult);
+                    CHECK_EQ(actual->getExprValueNum(), expected->getExprValueNum());
+                    CHECK_EQ(innerResult->getExprValueNum(), expected->getExprValueNum());
+                    for (const std::shared_ptr<air::Stmt>& s : ir->getStmts()) {
+                        for (const air::tac::ExprTemp& exprTemp : ir->getTAC()->getExprTempsOf(s)) {
+                            REQUIRE(expected->findExprValue(exprTemp.expr));
+                            REQUIRE(actual->findExprValue(exprTemp.expr));
+                            CHECK_EQ(actual->findExprValue(exprTemp.expr), innerResult->findExprValue(exprTemp.expr));
+                            CHECK(*actual->findExprValue(exprTemp.expr) == *expected->findExprValue(exprTemp.expr));
+                            CHECK(*actual->getExprValue(exprTemp.expr) == *expected->findExprValue(exprTemp.expr));
+                        }
+                    }
+                }
+                CHECK_GT(replayNum, 0U);
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing constant propagation keeping its facts only at block boundaries ...");
+
+}
+
+TEST_CASE_FIXTURE(ConstPropagationTestFixture, "testConstPropagationResultStore"
+    * doctest::description("testing storing constant propagation results on disk")) {
+
+    al::World::getLogger().Progress("Testing storing constant propagation results on disk ...");
+
+    dfact::ResultStore<df::CPFact> store((std::filesystem::temp_directory_path()
+        / ("cp-results-" + std::to_string(::getpid()) + ".bin")).string());
+    std::unique_ptr<cf::AnalysisConfig> analysisConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+        "constant propagation analysis over dense facts",
+        std::unordered_map<std::string, std::string>{{"map-fact", "dense"}});
+    df::ConstantPropagation denseCP(analysisConfig);
+
+    std::vector<std::shared_ptr<air::IR>> irs{dummy, typeCast, ifElse, binaryOp, loop, incDec, array, call};
+    for (const std::shared_ptr<air::IR>& ir : irs) {
+        CHECK_FALSE(store.contains(*ir));
+        CHECK_EQ(store.load(ir), nullptr);
+        store.store(ir, *denseCP.analyze(ir));
+        CHECK(store.contains(*ir));
+    }
+    CHECK_EQ(store.getStoredNum(), irs.size());
+    CHECK_GT(store.getFileSize(), 0);
+
+    for (const std::shared_ptr<air::IR>& ir : irs) {
+        std::shared_ptr<dfact::DataflowResult<df::CPFact>> expected = cp->analyze(ir);
+        std::shared_ptr<dfact::DataflowResult<df::CPFact>> actual = store.load(ir);
+        REQUIRE(actual);
+        for (const std::shared_ptr<air::Stmt>& s : ir->getCFG()->getNodes()) {
+            CHECK(actual->getInFact(s)->equalsTo(expected->getInFact(s)));
+            CHECK(actual->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing storing constant propagation results on disk ...");
+
+}
+
+TEST_CASE("testCPValue"
+    * doctest::description("testing unboxed and shared constant propagation values")) {
+
+    al::World::getLogger().Progress("Testing constant propagation values ...");
+
+    df::CPValue five = df::CPValue::constant(llvm::APSInt(llvm::APInt(32, 5), false));
+    CHECK(five.isConstant());
+    CHECK_EQ(five.getConstantValue(), 5);
+    CHECK_EQ(five, df::CPValue::constant(llvm::APSInt(llvm::APInt(32, 5), false)));
+    CHECK_NE(five, df::CPValue::constant(llvm::APSInt(llvm::APInt(32, 5), true)));
+    CHECK_NE(five, df::CPValue::constant(llvm::APSInt(llvm::APInt(64, 5), false)));
+    CHECK_EQ(df::CPValue::constant(llvm::APSInt(llvm::APInt(8, -3, true), false)).str(), "-3");
+    CHECK_EQ(df::CPValue::constant(llvm::APSInt(llvm::APInt(8, -3, true), true)).str(), "253");
+
+    CHECK_EQ(*df::CPValue::share(five), *df::CPValue::makeConstant(llvm::APSInt(llvm::APInt(32, 5), false)));
+    CHECK_EQ(df::CPValue::share(df::CPValue::undef()), df::CPValue::getUndef());
+    CHECK_EQ(df::CPValue::share(df::CPValue::nac()), df::CPValue::getNAC());
+
+    llvm::APSInt wide(llvm::APInt(128, 1).shl(100), true);
+    CHECK_THROWS_AS((void) df::CPValue::constant(wide), std::runtime_error);
+    df::WideConstantTable wideConstants;
+    df::CPValue wideConstant = df::CPValue::constant(wide, &wideConstants);
+    CHECK_EQ(wideConstant, df::CPValue::constant(wide, &wideConstants));
+    CHECK_EQ(wideConstants.size(), 1);
+    CHECK_NE(wideConstant, df::CPValue::constant(llvm::APSInt(llvm::APInt(128, 1).shl(99), true), &wideConstants));
+    CHECK_EQ(wideConstants.size(), 2);
+
+    std::shared_ptr<df::CPValue> wideValue = df::CPValue::makeConstant(wide);
+    CHECK_EQ(*wideValue, df::CPValue::constant(wide, &wideConstants));
+    CHECK_EQ(*wideValue, *df::CPValue::makeConstant(wide));
+    CHECK_EQ(wideValue->hash(), wideConstant.hash());
+    CHECK_EQ(wideValue->getConstantValue(), wide);
+    CHECK_EQ(wideValue->str(), "1267650600228229401496703205376");
+
+    std::shared_ptr<df::CPValue> shared;
+    {
+        df::WideConstantTable scratch;
+        shared = df::CPValue::share(df::CPValue::constant(wide, &scratch));
+    }
+    CHECK_EQ(shared->getConstantValue(), wide);
+
+    al::World::getLogger().Success("Finish testing constant propagation values ...");
+
+}
+
+TEST_SUITE_END();
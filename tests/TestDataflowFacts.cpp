@@ -2,11 +2,37 @@
 
 #include "World.h"
 #include "analysis/dataflow/fact/SetFact.h"
-#include "analysis/dataflow/fact/MapFact.h"
+#include "analysis/dataflow/fact/SetFactBuilder.h"
+#include "analysis/dataflow/fact/FlatMapFact.h"
+#include "analysis/dataflow/fact/HashConsTable.h"
+#include "analysis/dataflow/fact/PersistentMapFact.h"
+#include "analysis/dataflow/fact/FactCodec.h"
+#include "util/AppendOnlyFile.h"
+#include "util/PersistentHashMap.h"
+
+#include <filesystem>
+#include <thread>
+
+#include <unistd.h>
 
 namespace al = analyzer;
 namespace fact = al::analysis::dataflow::fact;
 
+/**
+ * @brief an indexed element for bit vector facts
+ */
+struct Element {
+    std::size_t index;
+    [[nodiscard]] std::size_t getIndex() const { return index; }
+};
+
+/**
+ * @brief a hash of only two values, so that the keys of a persistent trie collide in full
+ */
+struct CollidingHash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 2); }
+};
+
 TEST_SUITE_BEGIN("testDataflowFacts");
 
 TEST_CASE("testSetFact"
@@ -84,10 +110,96 @@ TEST_CASE("testSetFact"
     test2->removeAll(test1);
     CHECK(test2->isEmpty());
 
+    CHECK(test2->add(s2));
+    CHECK(test2->add(s4));
+    CHECK(test2->add(s6));
+    CHECK(test1->intersectWith(test2)->equalsTo(
+        std::make_shared<fact::SetFact<std::string>>(std::unordered_set{s2, s4})));
+    CHECK_EQ(test1->unionWith(test2)->size(), 5);
+
     al::World::getLogger().Success("Finish testing set like facts for dataflow analysis ...");
 
 }
 
+TEST_CASE_TEMPLATE("testBitVectorSetFact"
+    * doctest::description("testing bit vector set facts for dataflow analysis"),
+    BitVector, fact::BitVectorSetFact<Element>, fact::SparseBitVectorSetFact<Element>) {
+
+    al::World::getLogger().Progress("Testing bit vector set facts for dataflow analysis ...");
+
+    auto universe = std::make_shared<typename BitVector::Universe>();
+    for (std::size_t i = 0; i < 130; i++) {
+        universe->emplace_back(std::make_shared<Element>(Element{i}));
+    }
+    const std::vector<std::shared_ptr<Element>>& e = *universe;
+    std::shared_ptr<fact::SetFact<Element>> test1 = std::make_shared<BitVector>(universe);
+    CHECK(llvm::isa<BitVector>(test1.get()));
+    CHECK(test1->isEmpty());
+
+    CHECK(test1->add(e[0]));
+    CHECK(test1->add(e[64]));
+    CHECK(test1->add(e[129]));
+    CHECK_FALSE(test1->add(e[64]));
+    CHECK_EQ(test1->size(), 3);
+    CHECK(test1->contains(e[129]));
+    CHECK_FALSE(test1->contains(e[1]));
+    CHECK_FALSE(test1->contains(std::make_shared<Element>(Element{0})));
+    CHECK_THROWS_AS(test1->add(std::make_shared<Element>(Element{0})), std::runtime_error);
+
+    std::shared_ptr<fact::SetFact<Element>> test2 = test1->copy();
+    CHECK(test2->equalsTo(test1));
+    CHECK(test2->remove(e[0]));
+    CHECK_FALSE(test2->remove(e[0]));
+    CHECK(test2->add(e[1]));
+    CHECK_FALSE(test2->equalsTo(test1));
+
+    CHECK(test2->unionN(test1));
+    CHECK_FALSE(test2->unionN(test1));
+    CHECK_EQ(test2->size(), 4);
+    CHECK(test2->removeAll(test1));
+    CHECK_EQ(test2->size(), 1);
+    CHECK(test2->contains(e[1]));
+    CHECK(test2->unionWith(test1)->equalsTo(test1->unionWith(test2)));
+    CHECK(test2->intersectWith(test1)->isEmpty());
+
+    // mixed with other kinds of set facts, elements are compared one by one
+    std::shared_ptr<fact::SetFact<Element>> hash = std::make_shared<fact::SetFact<Element>>(
+        std::unordered_set<std::shared_ptr<Element>>{e[0], e[64], e[129]});
+    std::shared_ptr<fact::SetFact<Element>> other = fact::SetFactBuilder<Element>(
+        llvm::isa<fact::BitVectorSetFact<Element>>(test1.get()) ? "sparse-bit-vector" : "bit-vector",
+        universe).newSetFact();
+    CHECK_NE(other->getKind(), test1->getKind());
+    CHECK(other->unionN(hash));
+    CHECK(other->equalsTo(test1));
+    CHECK(test1->equalsTo(other));
+    CHECK(test1->equalsTo(hash));
+    CHECK(hash->equalsTo(test1));
+    CHECK(hash->add(e[2]));
+    CHECK_FALSE(test1->equalsTo(hash));
+    CHECK(test1->intersectWith(hash)->equalsTo(test1));
+    CHECK(hash->intersectWith(test1)->equalsTo(test1));
+    CHECK_EQ(hash->unionWith(test2)->size(), 5);
+    test2->setSetFact(hash);
+    CHECK(test2->equalsTo(hash));
+    CHECK(hash->intersect(test1));
+    CHECK(hash->equalsTo(test1));
+
+    CHECK(test2->removeIf([&](const std::shared_ptr<Element>& x) -> bool {
+        return x->getIndex() % 2 == 0;
+    }));
+    CHECK_EQ(test2->size(), 1);
+    CHECK(test2->contains(e[129]));
+    test1->clear();
+    CHECK(test1->isEmpty());
+
+    CHECK_EQ(fact::SetFactBuilder<Element>("", universe).getKind(), fact::SetFact<Element>::Kind::HASH_SET);
+    CHECK_EQ(fact::SetFactBuilder<Element>("auto", universe).getKind(), fact::SetFact<Element>::Kind::BIT_VECTOR);
+    CHECK_THROWS_AS(fact::SetFactBuilder<Element>("unknown", universe), std::runtime_error);
+
+    al::World::getLogger().Success("Finish testing bit vector set facts for dataflow analysis ...");
+
+}
+
 TEST_CASE("testMapFact"
     * doctest::description("testing map like facts for dataflow analysis")) {
 
@@ -170,5 +282,491 @@ TEST_CASE("testMapFact"
 
 }
 
-TEST_SUITE_END();
+TEST_CASE("testPersistentFacts"
+    * doctest::description("testing persistent facts for dataflow analysis")) {
+
+    al::World::getLogger().Progress("Testing persistent facts for dataflow analysis ...");
+
+    std::vector<std::shared_ptr<std::string>> e;
+    for (int i = 0; i < 100; i++) {
+        e.emplace_back(std::make_shared<std::string>("e" + std::to_string(i)));
+    }
+
+    std::shared_ptr<fact::SetFact<std::string>> set1 = std::make_shared<fact::PersistentSetFact<std::string>>();
+    CHECK(llvm::isa<fact::PersistentSetFact<std::string>>(set1.get()));
+    for (int i = 0; i < 100; i += 2) {
+        CHECK(set1->add(e[i]));
+    }
+    CHECK_FALSE(set1->add(e[0]));
+    CHECK_EQ(set1->size(), 50);
+    std::shared_ptr<fact::SetFact<std::string>> set2 = set1->copy();
+    CHECK(set2->equalsTo(set1));
+    CHECK(set2->add(e[1]));
+    CHECK(set2->remove(e[0]));
+    CHECK_FALSE(set2->remove(e[0]));
+    CHECK(set1->contains(e[0]));
+    CHECK_FALSE(set1->contains(e[1]));
+    CHECK_FALSE(set2->equalsTo(set1));
+    CHECK(set1->unionN(set2));
+    CHECK_FALSE(set1->unionN(set2));
+    CHECK_EQ(set1->size(), 51);
+    CHECK(set1->intersect(set2));
+    CHECK(set1->equalsTo(set2));
+    CHECK(set1->removeAll(set2));
+    CHECK(set1->isEmpty());
+
+    std::shared_ptr<fact::SetFact<std::string>> hashSet = std::make_shared<fact::SetFact<std::string>>(
+        std::unordered_set<std::shared_ptr<std::string>>{e[1], e[2]});
+    set1->setSetFact(hashSet);
+    CHECK(set1->equalsTo(hashSet));
+    CHECK(hashSet->equalsTo(set1));
+    CHECK(set2->intersect(hashSet));
+    CHECK(set2->equalsTo(hashSet));
+    CHECK(set2->removeIf([&](const std::shared_ptr<std::string>& x) -> bool {
+        return x == e[1];
+    }));
+    CHECK_EQ(set2->size(), 1);
+
+    std::shared_ptr<fact::MapFact<std::string, std::string>> map1
+        = std::make_shared<fact::PersistentMapFact<std::string, std::string>>();
+    CHECK(map1->isEmpty());
+    for (int i = 0; i < 50; i++) {
+        CHECK(map1->update(e[i], e[i + 50]));
+    }
+    CHECK_FALSE(map1->update(e[0], e[50]));
+    CHECK_EQ(map1->size(), 50);
+    CHECK_EQ(map1->get(e[10]), e[60]);
+    CHECK_FALSE(map1->get(e[60]));
+    std::shared_ptr<fact::MapFact<std::string, std::string>> map2 = map1->copy();
+    CHECK(map2->equalsTo(map1));
+    CHECK(map2->update(e[0], e[99]));
+    CHECK_EQ(map2->remove(e[1]), e[51]);
+    CHECK_FALSE(map2->remove(e[1]));
+    CHECK_EQ(map1->get(e[0]), e[50]);
+    CHECK_EQ(map1->get(e[1]), e[51]);
+    CHECK_FALSE(map1->equalsTo(map2));
+
+    // copyFrom overwrites the shared keys and keeps the others
+    CHECK(map1->copyFrom(map2));
+    CHECK_FALSE(map1->copyFrom(map2));
+    CHECK_EQ(map1->get(e[0]), e[99]);
+    CHECK_EQ(map1->get(e[1]), e[51]);
+    CHECK_EQ(map1->size(), 50);
+    CHECK(map2->update(e[1], e[51]));
+    CHECK(map1->equalsTo(map2));
+
+    std::shared_ptr<fact::MapFact<std::string, std::string>> hashMap
+        = std::make_shared<fact::MapFact<std::string, std::string>>();
+    CHECK(hashMap->copyFrom(map1));
+    CHECK(hashMap->equalsTo(map1));
+    CHECK(map1->equalsTo(hashMap));
+    CHECK_EQ(hashMap->keySet(), map1->keySet());
+    CHECK_EQ(hashMap->valueSet(), map1->valueSet());
+    map1->clear();
+    CHECK(map1->isEmpty());
+    CHECK(map1->copyFrom(hashMap));
+    CHECK(map1->equalsTo(map2));
+
+    al::World::getLogger().Success("Finish testing persistent facts for dataflow analysis ...");
+
+}
 
+TEST_CASE("testPersistentHashMapCollisions"
+    * doctest::description("testing colliding keys of persistent hash maps")) {
+
+    al::World::getLogger().Progress("Testing colliding keys of persistent hash maps ...");
+
+    using Map = al::util::PersistentHashMap<int, int, CollidingHash>;
+
+    Map map1;
+    for (int i = 0; i < 20; i++) {
+        map1 = map1.insert(i, i * 10);
+    }
+    CHECK_EQ(map1.size(), 20);
+    for (int i = 0; i < 20; i++) {
+        REQUIRE(map1.find(i));
+        CHECK_EQ(*map1.find(i), i * 10);
+    }
+    CHECK_FALSE(map1.find(20));
+    CHECK(map1.insert(3, 30).isSameAs(map1));
+    Map map2 = map1.insert(3, 33);
+    CHECK_EQ(*map2.find(3), 33);
+    CHECK_EQ(*map1.find(3), 30);
+    CHECK_EQ(map2.size(), 20);
+    CHECK(map1 != map2);
+
+    // erasing from the collision lists, down to the empty map
+    CHECK(map1.erase(21).isSameAs(map1));
+    Map map3 = map1;
+    for (int i = 0; i < 20; i += 3) {
+        map3 = map3.erase(i);
+    }
+    CHECK_EQ(map3.size(), 13);
+    CHECK_FALSE(map3.find(0));
+    CHECK_FALSE(map3.find(18));
+    CHECK_EQ(*map3.find(19), 190);
+    CHECK_EQ(*map1.find(0), 0);
+    for (int i = 0; i < 20; i++) {
+        map3 = map3.erase(i);
+    }
+    CHECK(map3.empty());
+
+    // the same entries inserted in another order give an equal map
+    Map map4;
+    for (int i = 19; i >= 0; i--) {
+        map4 = map4.insert(i, i * 10);
+    }
+    CHECK(map4 == map1);
+    int sum = 0;
+    map4.forEach([&](const Map::Entry& entry) {
+        sum += entry.second;
+    });
+    CHECK_EQ(sum, 1900);
+
+    // union keeps the values of the left map, update takes the values of the right one
+    Map left;
+    Map right;
+    for (int i = 0; i < 10; i++) {
+        left = left.insert(i, i);
+        right = right.insert(i + 5, i + 105);
+    }
+    Map united = left.unionWith(right);
+    CHECK_EQ(united.size(), 15);
+    CHECK_EQ(*united.find(5), 5);
+    CHECK_EQ(*united.find(14), 114);
+    Map updated = left.updateWith(right);
+    CHECK_EQ(updated.size(), 15);
+    CHECK_EQ(*updated.find(5), 105);
+    CHECK_EQ(*updated.find(0), 0);
+    CHECK(united.unionWith(left).isSameAs(united));
+    CHECK(updated.updateWith(right).isSameAs(updated));
+    CHECK(left.unionWith(Map()).isSameAs(left));
+
+    al::World::getLogger().Success("Finish testing colliding keys of persistent hash maps ...");
+
+}
+
+TEST_CASE("testCopyOnWriteFacts"
+    * doctest::description("testing copy-on-write of hash facts for dataflow analysis")) {
+
+    al::World::getLogger().Progress("Testing copy-on-write of hash facts for dataflow analysis ...");
+
+    std::vector<std::shared_ptr<std::string>> e;
+    for (int i = 0; i < 10; i++) {
+        e.emplace_back(std::make_shared<std::string>("e" + std::to_string(i)));
+    }
+
+    std::shared_ptr<fact::SetFact<std::string>> set1 = std::make_shared<fact::SetFact<std::string>>(
+        std::unordered_set<std::shared_ptr<std::string>>{e[0], e[1], e[2]});
+    std::shared_ptr<fact::SetFact<std::string>> set2 = set1->copy();
+    std::shared_ptr<fact::SetFact<std::string>> set3 = set2->copy();
+    CHECK(set2->equalsTo(set1));
+    CHECK_FALSE(set2->add(e[0]));
+    CHECK_FALSE(set2->remove(e[3]));
+    CHECK(set2->add(e[3]));
+    CHECK(set3->remove(e[0]));
+    CHECK_EQ(set1->size(), 3);
+    CHECK_FALSE(set1->contains(e[3]));
+    CHECK(set1->contains(e[0]));
+    CHECK_EQ(set2->size(), 4);
+    CHECK_EQ(set3->size(), 2);
+    CHECK_FALSE(set1->unionN(set1));
+    CHECK_FALSE(set1->intersect(set1));
+    set3->setSetFact(set1);
+    CHECK(set3->equalsTo(set1));
+    set3->clear();
+    CHECK(set3->isEmpty());
+    CHECK_EQ(set1->size(), 3);
+    CHECK(set3->unionN(set1));
+    CHECK(set3->add(e[4]));
+    CHECK_FALSE(set1->contains(e[4]));
+    CHECK(set3->removeAll(set3->copy()));
+    CHECK(set3->isEmpty());
+    set1->forEach([&](const std::shared_ptr<std::string>& x) {
+        set1->remove(x);
+        set1->add(e[9]);
+    });
+    CHECK_EQ(set1->size(), 1);
+    CHECK(set1->contains(e[9]));
+    CHECK_EQ(set2->size(), 4);
+
+    std::shared_ptr<fact::MapFact<std::string, std::string>> map1
+        = std::make_shared<fact::MapFact<std::string, std::string>>();
+    CHECK(map1->update(e[0], e[5]));
+    CHECK(map1->update(e[1], e[6]));
+    std::shared_ptr<fact::MapFact<std::string, std::string>> map2 = map1->copy();
+    CHECK(map2->equalsTo(map1));
+    CHECK_FALSE(map2->update(e[0], e[5]));
+    CHECK(map2->update(e[0], e[7]));
+    CHECK_EQ(map1->get(e[0]), e[5]);
+    CHECK_EQ(map2->remove(e[1]), e[6]);
+    CHECK_EQ(map1->get(e[1]), e[6]);
+    CHECK_FALSE(map1->copyFrom(map1));
+    std::shared_ptr<fact::MapFact<std::string, std::string>> map3 = map1->copy();
+    map3->clear();
+    CHECK(map3->isEmpty());
+    CHECK_EQ(map1->size(), 2);
+    CHECK(map3->copyFrom(map2));
+    CHECK(map3->equalsTo(map2));
+    CHECK(map3->update(e[2], e[8]));
+    CHECK_FALSE(map2->get(e[2]));
+
+    al::World::getLogger().Success("Finish testing copy-on-write of hash facts for dataflow analysis ...");
+
+}
+
+TEST_CASE("testFlatMapFact"
+    * doctest::description("testing flat map facts for dataflow analysis")) {
+
+    al::World::getLogger().Progress("Testing flat map facts for dataflow analysis ...");
+
+    std::vector<std::shared_ptr<Element>> k;
+    std::vector<std::shared_ptr<std::string>> v;
+    for (std::size_t i = 0; i < 20; i++) {
+        k.emplace_back(std::make_shared<Element>(Element{i}));
+        v.emplace_back(std::make_shared<std::string>("v" + std::to_string(i)));
+    }
+
+    auto map1 = std::make_shared<fact::FlatMapFact<Element, std::string>>();
+    for (std::size_t i : {7, 3, 15, 0, 11}) {
+        CHECK(map1->update(k[i], v[i]));
+    }
+    CHECK_FALSE(map1->update(k[3], v[3]));
+    CHECK(map1->update(k[3], v[4]));
+    CHECK_EQ(map1->get(k[3]), v[4]);
+    CHECK_FALSE(map1->get(k[4]));
+    CHECK_EQ(map1->size(), 5);
+    std::vector<std::size_t> order;
+    map1->forEach([&](const std::shared_ptr<Element>& key, const std::shared_ptr<std::string>&) {
+        order.emplace_back(key->getIndex());
+    });
+    CHECK_EQ(order, std::vector<std::size_t>{0, 3, 7, 11, 15});
+
+    std::shared_ptr<fact::MapFact<Element, std::string>> map2 = map1->copy();
+    CHECK(llvm::isa<fact::FlatMapFact<Element, std::string>>(map2.get()));
+    CHECK(map2->equalsTo(map1));
+    CHECK_EQ(map2->remove(k[0]), v[0]);
+    CHECK_FALSE(map2->remove(k[0]));
+    CHECK(map2->update(k[19], v[19]));
+    CHECK(map1->get(k[0]));
+
+    // same keys: the values are overwritten in place
+    std::shared_ptr<fact::MapFact<Element, std::string>> map3 = map1->copy();
+    CHECK(map3->update(k[7], v[8]));
+    CHECK(map1->copyFrom(map3));
+    CHECK_FALSE(map1->copyFrom(map3));
+    CHECK(map1->equalsTo(map3));
+
+    // different keys: merge-join
+    CHECK(map1->copyFrom(map2));
+    CHECK_EQ(map1->size(), 6);
+    CHECK_EQ(map1->get(k[0]), v[0]);
+    CHECK_EQ(map1->get(k[7]), v[7]);
+    CHECK_EQ(map1->get(k[19]), v[19]);
+
+    int combined = 0;
+    CHECK(map1->joinWith(*llvm::cast<fact::FlatMapFact<Element, std::string>>(map3.get()),
+        [&](const std::shared_ptr<std::string>& a, const std::shared_ptr<std::string>& b) {
+            combined++;
+            return a == b ? a : v[10];
+        }));
+    CHECK_EQ(combined, 5);
+    CHECK_EQ(map1->get(k[7]), v[10]);
+    CHECK_EQ(map1->get(k[0]), v[0]);
+
+    std::shared_ptr<fact::MapFact<Element, std::string>> hashMap
+        = std::make_shared<fact::MapFact<Element, std::string>>();
+    CHECK(hashMap->copyFrom(map1));
+    CHECK(hashMap->equalsTo(map1));
+    CHECK(map1->equalsTo(hashMap));
+    CHECK_EQ(hashMap->keySet(), map1->keySet());
+    CHECK_EQ(hashMap->valueSet(), map1->valueSet());
+    map1->clear();
+    CHECK(map1->isEmpty());
+    CHECK(map1->copyFrom(hashMap));
+    CHECK(map1->equalsTo(hashMap));
+
+    al::World::getLogger().Success("Finish testing flat map facts for dataflow analysis ...");
+
+}
+
+TEST_CASE("testHashConsTable"
+    * doctest::description("testing hash-consing of dataflow facts")) {
+
+    al::World::getLogger().Progress("Testing hash-consing of dataflow facts ...");
+
+    std::vector<std::shared_ptr<std::string>> e;
+    for (int i = 0; i < 10; i++) {
+        e.emplace_back(std::make_shared<std::string>("e" + std::to_string(i)));
+    }
+
+    fact::HashConsTable<fact::SetFact<std::string>> setTable;
+    auto set1 = std::make_shared<fact::SetFact<std::string>>(
+        std::unordered_set<std::shared_ptr<std::string>>{e[0], e[1]});
+    auto set2 = std::make_shared<fact::PersistentSetFact<std::string>>();
+    set2->add(e[1]);
+    set2->add(e[0]);
+    auto set3 = std::make_shared<fact::SetFact<std::string>>(
+        std::unordered_set<std::shared_ptr<std::string>>{e[0], e[2]});
+    std::shared_ptr<fact::SetFact<std::string>> canonical1 = setTable.intern(set1);
+    CHECK_EQ(canonical1, set1);
+    CHECK_EQ(setTable.intern(set2), set1);
+    CHECK_EQ(setTable.intern(set3), set3);
+    CHECK_EQ(setTable.intern(set1), set1);
+    CHECK_EQ(setTable.intern(std::make_shared<fact::SetFact<std::string>>()),
+             setTable.intern(std::make_shared<fact::SetFact<std::string>>()));
+    CHECK_EQ(setTable.getInternedNum(), 6);
+    CHECK_EQ(setTable.getUniqueNum(), 3);
+    CHECK_EQ(setTable.getDedupRatio(), doctest::Approx(2.0));
+
+    fact::HashConsTable<fact::MapFact<std::string, std::string>> mapTable;
+    CHECK_EQ(mapTable.getDedupRatio(), doctest::Approx(1.0));
+    auto map1 = std::make_shared<fact::MapFact<std::string, std::string>>();
+    map1->update(e[0], e[1]);
+    auto map2 = std::make_shared<fact::MapFact<std::string, std::string>>();
+    map2->update(e[1], e[0]);
+    auto map3 = std::make_shared<fact::PersistentMapFact<std::string, std::string>>();
+    map3->update(e[0], e[1]);
+    CHECK_EQ(mapTable.intern(map1), map1);
+    CHECK_EQ(mapTable.intern(map2), map2);
+    CHECK_EQ(mapTable.intern(map3), map1);
+    CHECK_EQ(mapTable.getUniqueNum(), 2);
+
+    al::World::getLogger().Success("Finish testing hash-consing of dataflow facts ...");
+
+}
+
+TEST_CASE("testTemplatedFactVisitors"
+    * doctest::description("testing templated forEach and removeIf of dataflow facts")) {
+
+    al::World::getLogger().Progress("Testing templated forEach and removeIf of dataflow facts ...");
+
+    auto universe = std::make_shared<fact::BitVectorSetFact<Element>::Universe>();
+    for (std::size_t i = 0; i < 100; i++) {
+        universe->emplace_back(std::make_shared<Element>(Element{i}));
+    }
+
+    for (const char* option : {"hash-set", "bit-vector", "sparse-bit-vector", "persistent"}) {
+        std::shared_ptr<fact::SetFact<Element>> set = fact::SetFactBuilder<Element>(option, universe).newSetFact();
+        for (std::size_t i = 0; i < 100; i += 3) {
+            set->add(universe->at(i));
+        }
+        // the callable is called in place, not copied
+        struct Counter {
+            std::size_t count = 0;
+            void operator()(const std::shared_ptr<Element>&) { count++; }
+        } counter;
+        set->forEach(counter);
+        CHECK_EQ(counter.count, set->size());
+        CHECK(set->removeIf([](const std::shared_ptr<Element>& e) {
+            return e->getIndex() % 2 == 0;
+        }));
+        CHECK_FALSE(set->removeIf([](const std::shared_ptr<Element>& e) {
+            return e->getIndex() % 2 == 0;
+        }));
+        std::size_t sum = 0;
+        set->forEach([&](const std::shared_ptr<Element>& e) {
+            sum += e->getIndex();
+        });
+        CHECK_EQ(sum, 3 + 9 + 15 + 21 + 27 + 33 + 39 + 45 + 51 + 57 + 63 + 69 + 75 + 81 + 87 + 93 + 99);
+    }
+
+    std::vector<std::shared_ptr<std::string>> v;
+    for (int i = 0; i < 100; i++) {
+        v.emplace_back(std::make_shared<std::string>("v" + std::to_string(i)));
+    }
+    for (const std::shared_ptr<fact::MapFact<Element, std::string>>& map :
+            std::vector<std::shared_ptr<fact::MapFact<Element, std::string>>>{
+                std::make_shared<fact::MapFact<Element, std::string>>(),
+                std::make_shared<fact::FlatMapFact<Element, std::string>>(),
+                std::make_shared<fact::PersistentMapFact<Element, std::string>>()}) {
+        for (std::size_t i = 0; i < 100; i += 5) {
+            map->update(universe->at(i), v[i]);
+        }
+        std::size_t matched = 0;
+        map->forEach([&](const std::shared_ptr<Element>& key, const std::shared_ptr<std::string>& value) {
+            matched += v[key->getIndex()] == value;
+        });
+        CHECK_EQ(matched, 20);
+    }
+
+    al::World::getLogger().Success("Finish testing templated forEach and removeIf of dataflow facts ...");
+
+}
+
+TEST_CASE("testByteReader"
+    * doctest::description("testing the integer encoding of stored dataflow facts")) {
+
+    al::World::getLogger().Progress("Testing the integer encoding of stored dataflow facts ...");
+
+    fact::ByteWriter writer;
+    for (uint64_t value : {uint64_t(0), uint64_t(127), uint64_t(128), uint64_t(1) << 63, ~uint64_t(0)}) {
+        writer.writeVarint(value);
+    }
+    writer.writeSignedVarint(-1);
+    writer.writeSignedVarint(INT64_MIN);
+    fact::ByteReader reader(writer.getBytes());
+    CHECK_EQ(reader.readVarint(), 0);
+    CHECK_EQ(reader.readVarint(), 127);
+    CHECK_EQ(reader.readVarint(), 128);
+    CHECK_EQ(reader.readVarint(), uint64_t(1) << 63);
+    CHECK_EQ(reader.readVarint(), ~uint64_t(0));
+    CHECK_EQ(reader.readSignedVarint(), -1);
+    CHECK_EQ(reader.readSignedVarint(), INT64_MIN);
+    CHECK_THROWS_AS(reader.readByte(), std::runtime_error);
+
+    // more than ten bytes, or a tenth byte with more than the last bit
+    fact::ByteReader tooLong(std::vector<uint8_t>(11, 0x80));
+    CHECK_THROWS_AS(tooLong.readVarint(), std::runtime_error);
+    std::vector<uint8_t> overflow(9, 0xff);
+    overflow.emplace_back(0x02);
+    fact::ByteReader tooWide(overflow);
+    CHECK_THROWS_AS(tooWide.readVarint(), std::runtime_error);
+
+    al::World::getLogger().Success("Finish testing the integer encoding of stored dataflow facts ...");
+
+}
+
+TEST_CASE("testAppendOnlyFileGrowth"
+    * doctest::description("testing appending to a file from several threads while it grows")) {
+
+    al::World::getLogger().Progress("Testing appending to a file from several threads while it grows ...");
+
+    std::string path = (std::filesystem::temp_directory_path()
+        / ("append-only-" + std::to_string(::getpid()) + ".bin")).string();
+    {
+        al::util::AppendOnlyFile file(path, 16);
+        constexpr std::size_t writerNum = 4;
+        constexpr std::size_t recordNum = 2000;
+        std::vector<std::vector<std::size_t>> offsets(writerNum, std::vector<std::size_t>(recordNum));
+        auto recordOf = [](std::size_t writer, std::size_t i) {
+            return std::vector<uint8_t>(1 + (writer * 37 + i) % 300, static_cast<uint8_t>(writer * 61 + i));
+        };
+        std::vector<std::thread> writers;
+        for (std::size_t w = 0; w < writerNum; w++) {
+            writers.emplace_back([&, w]() {
+                for (std::size_t i = 0; i < recordNum; i++) {
+                    offsets[w][i] = file.append(recordOf(w, i));
+                    // read back concurrently with the other writers growing the file
+                    CHECK_EQ(file.read(offsets[w][i], recordOf(w, i).size()), recordOf(w, i));
+                }
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        CHECK_GT(file.getSize(), std::size_t(1) << 20);
+        for (std::size_t w = 0; w < writerNum; w++) {
+            for (std::size_t i = 0; i < recordNum; i++) {
+                CHECK_EQ(file.read(offsets[w][i], recordOf(w, i).size()), recordOf(w, i));
+            }
+        }
+        CHECK(std::filesystem::exists(path));
+    }
+    CHECK_FALSE(std::filesystem::exists(path));
+
+    al::World::getLogger().Success("Finish testing appending to a file from several threads while it grows ...");
+
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,148 @@
+#include "doctest.h"
+
+#include <algorithm>
+
+#include "World.h"
+#include "ir/IR.h"
+#include "analysis/graph/Dominators.h"
+
+namespace al = analyzer;
+namespace air = al::ir;
+namespace graph = al::analysis::graph;
+
+class DominatorsTestFixture {
+protected:
+    std::shared_ptr<air::IR> ir1, ir3;
+public:
+    DominatorsTestFixture() {
+        al::World::initialize("resources/example02");
+        const al::World& world = al::World::get();
+        ir1 = world.getMethodBySignature("int main(int, char **)")->getIR();
+        ir3 = world.getMethodBySignature("int fib(int)")->getIR();
+    }
+};
+
+TEST_SUITE_BEGIN("testDominators");
+
+TEST_CASE_FIXTURE(DominatorsTestFixture, "testDominatorTree"
+    * doctest::description("testing dominator tree and dominance frontiers")) {
+
+    al::World::getLogger().Progress("Testing dominator tree and dominance frontiers ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s1 = stmtMap.at("a = 0");
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s7 = stmtMap.at("i--");
+    std::shared_ptr<air::Stmt> s8 = stmtMap.at("nop");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+    std::shared_ptr<air::Stmt> s10 = stmtMap.at("return a");
+
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    std::shared_ptr<graph::DominatorTree> dom = cfg->getDominatorTree();
+
+    CHECK(dom == cfg->getDominatorTree());
+    CHECK_FALSE(dom->isPostDominatorTree());
+    CHECK(dom->getRoot() == cfg->getEntry());
+    CHECK(dom->getIDom(cfg->getEntry()) == nullptr);
+    CHECK(dom->getIDom(s1) == cfg->getEntry());
+    CHECK(dom->getIDom(s3) == s2);
+    CHECK(dom->getIDom(s4) == s3);
+    CHECK(dom->getIDom(s9) == s3);
+    CHECK(dom->getIDom(s8) == s7);
+    CHECK(dom->getIDom(cfg->getExit()) == s10);
+    CHECK_EQ(dom->getChildrenOf(s3).size(), 2);
+
+    CHECK(dom->dominates(s1, s10));
+    CHECK(dom->dominates(s3, s8));
+    CHECK(dom->dominates(s3, s3));
+    CHECK_FALSE(dom->strictlyDominates(s3, s3));
+    CHECK_FALSE(dom->dominates(s4, s9));
+    CHECK_FALSE(dom->dominates(s8, s3));
+
+    CHECK(dom->getDominanceFrontierOf(s1).empty());
+    CHECK(dom->getDominanceFrontierOf(s9).empty());
+    for (const std::shared_ptr<air::Stmt>& s : {s3, s4, s7, s8}) {
+        std::unordered_set<std::shared_ptr<air::Stmt>> frontier = dom->getDominanceFrontierOf(s);
+        CHECK_EQ(frontier.size(), 1);
+        CHECK(frontier.find(s3) != frontier.end());
+    }
+
+    al::World::getLogger().Success("Finish testing dominator tree and dominance frontiers ...");
+}
+
+TEST_CASE_FIXTURE(DominatorsTestFixture, "testPostDominatorTree"
+    * doctest::description("testing post-dominator tree and post-dominance frontiers")) {
+
+    al::World::getLogger().Progress("Testing post-dominator tree and post-dominance frontiers ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s1 = stmtMap.at("a = 0");
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s5 = stmtMap.at("b = a + b");
+    std::shared_ptr<air::Stmt> s8 = stmtMap.at("nop");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    std::shared_ptr<graph::DominatorTree> postDom = cfg->getPostDominatorTree();
+
+    CHECK(postDom == cfg->getPostDominatorTree());
+    CHECK(postDom->isPostDominatorTree());
+    CHECK(postDom->getRoot() == cfg->getExit());
+    CHECK(postDom->getIDom(s3) == s9);
+    CHECK(postDom->getIDom(s8) == s3);
+    CHECK(postDom->getIDom(s4) == s5);
+    CHECK(postDom->getIDom(s2) == s3);
+
+    CHECK(postDom->dominates(s9, s1));
+    CHECK(postDom->dominates(s3, s4));
+    CHECK_FALSE(postDom->dominates(s4, s3));
+
+    // the loop body is control dependent on the loop condition
+    for (const std::shared_ptr<air::Stmt>& s : {s4, s8}) {
+        std::unordered_set<std::shared_ptr<air::Stmt>> frontier = postDom->getDominanceFrontierOf(s);
+        CHECK_EQ(frontier.size(), 1);
+        CHECK(frontier.find(s3) != frontier.end());
+    }
+    CHECK(postDom->getDominanceFrontierOf(s9).empty());
+
+    al::World::getLogger().Success("Finish testing post-dominator tree and post-dominance frontiers ...");
+}
+
+TEST_CASE_FIXTURE(DominatorsTestFixture, "testDominanceConsistency"
+    * doctest::description("testing consistency of dominance queries")) {
+
+    al::World::getLogger().Progress("Testing consistency of dominance queries ...");
+
+    for (const std::shared_ptr<air::IR>& myIR : {ir1, ir3}) {
+        std::shared_ptr<graph::CFG> cfg = myIR->getCFG();
+        for (const std::shared_ptr<graph::DominatorTree>& tree
+                : {cfg->getDominatorTree(), cfg->getPostDominatorTree()}) {
+            for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+                std::size_t idom = tree->getIDomIndex(i);
+                if (idom == tree->getNodeNum()) {
+                    continue;
+                }
+                CHECK(tree->dominates(idom, i));
+                CHECK_FALSE(tree->dominates(i, idom));
+                llvm::ArrayRef<std::size_t> children = tree->getChildIndicesOf(idom);
+                CHECK(std::find(children.begin(), children.end(), i) != children.end());
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing consistency of dominance queries ...");
+}
+
+TEST_SUITE_END();
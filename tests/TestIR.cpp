@@ -1,5 +1,7 @@
 #include "doctest.h"
 
+#include <algorithm>
+
 #include "World.h"
 #include "ir/IR.h"
 
@@ -106,6 +108,15 @@ TEST_CASE_FIXTURE(IRTestFixture, "testGetVars"
             {"i", "int"},  {"n", "int"}, {"result", "int"}
     });
 
+    for (const std::shared_ptr<air::IR>& ir : {ir1, ir2, ir3, ir4}) {
+        std::vector<std::shared_ptr<air::Var>> indexedVars = ir->getVarsByIndex();
+        CHECK_EQ(indexedVars.size(), ir->getVars().size());
+        for (std::size_t i = 0; i < indexedVars.size(); i++) {
+            REQUIRE(indexedVars[i]);
+            CHECK_EQ(indexedVars[i]->getIndex(), i);
+        }
+    }
+
     al::World::getLogger().Success("Finish testing get method variables ...");
 
 }
@@ -451,6 +462,148 @@ TEST_CASE_FIXTURE(IRTestFixture, "testGetCFG3"
     al::World::getLogger().Success("Finish testing get the last method cfg ...");
 }
 
+TEST_CASE_FIXTURE(IRTestFixture, "testCFGIndices"
+    * doctest::description("testing index based cfg queries")) {
+
+    al::World::getLogger().Progress("Testing index based cfg queries ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s8 = stmtMap.at("nop");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+
+    CHECK_EQ(cfg->getNodeNum(), ir3->getStmts().size() + 2);
+    CHECK_EQ(cfg->getNodes().size(), cfg->getNodeNum());
+    for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+        CHECK_EQ(cfg->getNodeIndex(cfg->getNode(i)), i);
+        llvm::ArrayRef<std::size_t> succs = cfg->getSuccIndicesOf(i);
+        CHECK(std::is_sorted(succs.begin(), succs.end()));
+        for (std::size_t succ : succs) {
+            CHECK(cfg->hasEdge(cfg->getNode(i), cfg->getNode(succ)));
+        }
+    }
+    CHECK_LT(cfg->getNodeIndex(cfg->getEntry()), cfg->getNodeNum());
+    CHECK_LT(cfg->getNodeIndex(cfg->getExit()), cfg->getNodeNum());
+    CHECK_EQ(cfg->getNodeIndex(ir4->getCFG()->getEntry()), cfg->getNodeNum());
+
+    std::size_t i3 = cfg->getNodeIndex(s3);
+    llvm::ArrayRef<std::size_t> preds3 = cfg->getPredIndicesOf(i3);
+    CHECK_EQ(preds3.size(), 2);
+    CHECK(std::find(preds3.begin(), preds3.end(), cfg->getNodeIndex(s2)) != preds3.end());
+    CHECK(std::find(preds3.begin(), preds3.end(), cfg->getNodeIndex(s8)) != preds3.end());
+    llvm::ArrayRef<std::size_t> succs3 = cfg->getSuccIndicesOf(i3);
+    CHECK_EQ(succs3.size(), 2);
+    CHECK(std::find(succs3.begin(), succs3.end(), cfg->getNodeIndex(s4)) != succs3.end());
+    CHECK(std::find(succs3.begin(), succs3.end(), cfg->getNodeIndex(s9)) != succs3.end());
+    CHECK_FALSE(cfg->hasEdge(s3, s2));
+    CHECK_FALSE(cfg->hasEdge(s4, ir4->getCFG()->getExit()));
+
+    std::size_t edgeNum = 0;
+    for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+        edgeNum += cfg->getSuccIndicesOf(i).size();
+        CHECK_EQ(cfg->getPredIndicesOf(i).size(), cfg->getPredsOf(cfg->getNode(i)).size());
+        CHECK_EQ(cfg->getSuccIndicesOf(i).size(), cfg->getSuccsOf(cfg->getNode(i)).size());
+    }
+    CHECK_EQ(edgeNum, cfg->getEdgeNum());
+
+    al::World::getLogger().Success("Finish testing index based cfg queries ...");
+}
+
+TEST_CASE_FIXTURE(IRTestFixture, "testRPOLayout"
+    * doctest::description("testing reverse postorder layout of statements")) {
+
+    al::World::getLogger().Progress("Testing reverse postorder layout of statements ...");
+
+    for (const std::shared_ptr<air::IR>& myIR : {ir1, ir2, ir3, ir4, ir5, ir6}) {
+        std::shared_ptr<graph::CFG> cfg = myIR->getCFG();
+        std::vector<std::shared_ptr<air::Stmt>> stmts = myIR->getStmts();
+        CHECK_EQ(cfg->getEntry()->getIndex(), 0);
+        CHECK_EQ(cfg->getExit()->getIndex(), cfg->getNodeNum() - 1);
+        for (std::size_t i = 0; i < stmts.size(); i++) {
+            CHECK_EQ(stmts.at(i)->getIndex(), i + 1);
+            CHECK_EQ(cfg->getNodeIndex(stmts.at(i)), i + 1);
+        }
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s1 = stmtMap.at("a = 0");
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s8 = stmtMap.at("nop");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+    std::shared_ptr<air::Stmt> s10 = stmtMap.at("return a");
+
+    CHECK_LT(s1->getIndex(), s2->getIndex());
+    CHECK_LT(s2->getIndex(), s3->getIndex());
+    CHECK_LT(s3->getIndex(), s4->getIndex());
+    CHECK_LT(s4->getIndex(), s8->getIndex());
+    CHECK_LT(s3->getIndex(), s9->getIndex());
+    CHECK_LT(s9->getIndex(), s10->getIndex());
+
+    // the only retreating edge of fib is the loop back edge
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    for (std::size_t i = 0; i < cfg->getNodeNum(); i++) {
+        for (std::size_t succ : cfg->getSuccIndicesOf(i)) {
+            if (succ <= i) {
+                CHECK_EQ(i, s8->getIndex());
+                CHECK_EQ(succ, s3->getIndex());
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing reverse postorder layout of statements ...");
+}
+
+TEST_CASE_FIXTURE(IRTestFixture, "testSimplifyCFG"
+    * doctest::description("testing cfg simplification of the default ir builder")) {
+
+    al::World::getLogger().Progress("Testing cfg simplification of the default ir builder ...");
+
+    air::DefaultIRBuilder simplifyingBuilder(true);
+    for (const auto& [signature, method] : al::World::get().getAllMethods()) {
+        std::shared_ptr<air::IR> ir = method->getIR();
+        std::shared_ptr<air::IR> simplified = simplifyingBuilder.buildIR(*method);
+        auto countNops = [](const std::shared_ptr<air::IR>& myIR) -> std::size_t {
+            std::vector<std::shared_ptr<air::Stmt>> stmts = myIR->getStmts();
+            return static_cast<std::size_t>(std::count_if(stmts.begin(), stmts.end(),
+                [](const std::shared_ptr<air::Stmt>& s) -> bool { return s->getClangStmt() == nullptr; }));
+        };
+        CHECK_EQ(simplified->getStmts().size() - countNops(simplified), ir->getStmts().size() - countNops(ir));
+        CHECK_LE(countNops(simplified), countNops(ir));
+        CHECK_LE(simplified->getCFG()->getEdgeNum(), ir->getCFG()->getEdgeNum());
+    }
+
+    // the nop closing the loop body of fib is bypassed
+    std::shared_ptr<air::IR> fib = simplifyingBuilder.buildIR(*al::World::get().getMethodBySignature("int fib(int)"));
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : fib->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+    CHECK(stmtMap.find("nop") == stmtMap.end());
+    std::shared_ptr<graph::CFG> cfg = fib->getCFG();
+    CHECK_EQ(cfg->getEdgeNum(), 11);
+    CHECK(cfg->hasEdge(stmtMap.at("i--"), stmtMap.at("i > 0")));
+    for (const std::shared_ptr<graph::CFGEdge>& e : cfg->getInEdgesOf(stmtMap.at("i > 0"))) {
+        CHECK_EQ(e->getKind(), graph::CFGEdge::Kind::JUMP_EDGE);
+    }
+
+    al::World::getLogger().Success("Finish testing cfg simplification of the default ir builder ...");
+
+}
+
 TEST_CASE_FIXTURE(IRTestFixture, "testStdLib"
     * doctest::description("testing using the standard lib")) {
 
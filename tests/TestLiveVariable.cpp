@@ -1,7 +1,14 @@
 #include "doctest.h"
 
+#include "DataflowOptionTest.h"
 #include "World.h"
 #include "analysis/dataflow/LiveVariable.h"
+#include "analysis/dataflow/fact/ResultStore.h"
+
+#include <filesystem>
+#include <thread>
+
+#include <unistd.h>
 
 namespace al = analyzer;
 namespace air = al::ir;
@@ -453,4 +460,56 @@ TEST_CASE_FIXTURE(LiveVarTestFixture, "testLiveVarMultipleParen"
 
 }
 
+TEST_CASE_FIXTURE(LiveVarTestFixture, "testLiveVarOptions"
+    * doctest::description("testing live variable analysis under all solvers, fact storages and set facts")) {
+
+    al::World::getLogger().Progress("Testing live variable analysis under all solvers, fact storages and set facts ...");
+
+    checkOptionCombinations<air::Var>("live variable analysis", *lv, {ir1, ir2, ir3, ir4, ir5, ir6}, false);
+
+    al::World::getLogger().Success("Finish testing live variable analysis under all solvers, fact storages and set facts ...");
+
+}
+
+TEST_CASE_FIXTURE(LiveVarTestFixture, "testLiveVarResultStore"
+    * doctest::description("testing storing live variable results on disk from several threads")) {
+
+    al::World::getLogger().Progress("Testing storing live variable results on disk from several threads ...");
+
+    // a tiny file grows many times while the writers append to it
+    dfact::ResultStore<dfact::SetFact<air::Var>> store((std::filesystem::temp_directory_path()
+        / ("live-var-results-" + std::to_string(::getpid()) + ".bin")).string(), 64);
+    std::vector<std::shared_ptr<air::IR>> irs{ir1, ir2, ir3, ir4, ir5, ir6};
+    std::vector<std::shared_ptr<dfact::DataflowResult<dfact::SetFact<air::Var>>>> results;
+    for (const std::shared_ptr<air::IR>& ir : irs) {
+        results.emplace_back(lv->analyze(ir));
+    }
+
+    std::vector<std::thread> writers;
+    for (std::size_t i = 0; i < irs.size(); i++) {
+        writers.emplace_back([&, i]() {
+            for (int round = 0; round < 100; round++) {
+                store.store(irs[i], *results[i]);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    CHECK_EQ(store.getStoredNum(), irs.size());
+    CHECK_GT(store.getFileSize(), 64);
+
+    for (std::size_t i = 0; i < irs.size(); i++) {
+        std::shared_ptr<dfact::DataflowResult<dfact::SetFact<air::Var>>> loaded = store.load(irs[i]);
+        REQUIRE(loaded);
+        for (const std::shared_ptr<air::Stmt>& s : irs[i]->getCFG()->getNodes()) {
+            CHECK(loaded->getInFact(s)->equalsTo(results[i]->getInFact(s)));
+            CHECK(loaded->getOutFact(s)->equalsTo(results[i]->getOutFact(s)));
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing storing live variable results on disk from several threads ...");
+
+}
+
 TEST_SUITE_END();
@@ -1,5 +1,6 @@
 #include "doctest.h"
 
+#include "DataflowOptionTest.h"
 #include "World.h"
 #include "analysis/dataflow/ReachingDefinition.h"
 
@@ -224,5 +225,43 @@ TEST_CASE_FIXTURE(ReachDefTestFixture, "testReachDefCaseLoop"
 
 }
 
-TEST_SUITE_END();
+TEST_CASE_FIXTURE(ReachDefTestFixture, "testReachDefOptions"
+    * doctest::description("testing reaching definition analysis under all solvers, fact storages and set facts")) {
+
+    al::World::getLogger().Progress("Testing reaching definition analysis under all solvers, fact storages and set facts ...");
+
+    checkOptionCombinations<air::Stmt>("reaching definition analysis", *rd, {ir1, ir2}, true);
+
+    al::World::getLogger().Success("Finish testing reaching definition analysis under all solvers, fact storages and set facts ...");
+
+}
 
+TEST_CASE_FIXTURE(ReachDefTestFixture, "testReachDefHashCons"
+    * doctest::description("testing reaching definition analysis with hash-consed facts")) {
+
+    al::World::getLogger().Progress("Testing reaching definition analysis with hash-consed facts ...");
+
+    std::unique_ptr<cf::AnalysisConfig> analysisConfig = std::make_unique<cf::DefaultAnalysisConfig>(
+        "reaching definition analysis with hash-consed facts",
+        std::unordered_map<std::string, std::string>{{"hash-cons", "true"}});
+    df::ReachingDefinition hashConsReachingDefinition(analysisConfig);
+
+    for (const std::shared_ptr<air::IR>& ir : {ir1, ir2}) {
+        std::shared_ptr<dfact::DataflowResult<dfact::SetFact<air::Stmt>>> expected = rd->analyze(ir);
+        std::shared_ptr<dfact::DataflowResult<dfact::SetFact<air::Stmt>>> actual = hashConsReachingDefinition.analyze(ir);
+        const std::vector<std::shared_ptr<air::Stmt>>& nodes = ir->getCFG()->getNodes();
+        for (const std::shared_ptr<air::Stmt>& s : nodes) {
+            CHECK(actual->getInFact(s)->equalsTo(expected->getInFact(s)));
+            CHECK(actual->getOutFact(s)->equalsTo(expected->getOutFact(s)));
+            for (const std::shared_ptr<air::Stmt>& t : nodes) {
+                CHECK_EQ(actual->getOutFact(s) == actual->getOutFact(t),
+                    expected->getOutFact(s)->equalsTo(expected->getOutFact(t)));
+            }
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing reaching definition analysis with hash-consed facts ...");
+
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,151 @@
+#include "doctest.h"
+
+#include "World.h"
+#include "ir/IR.h"
+#include "ir/SSA.h"
+#include "ir/DefUseIndex.h"
+
+namespace al = analyzer;
+namespace air = al::ir;
+namespace graph = al::analysis::graph;
+
+class SSATestFixture {
+protected:
+    std::shared_ptr<air::IR> ir3;
+public:
+    SSATestFixture() {
+        al::World::initialize("resources/example02");
+        const al::World& world = al::World::get();
+        ir3 = world.getMethodBySignature("int fib(int)")->getIR();
+    }
+};
+
+TEST_SUITE_BEGIN("testSSA");
+
+TEST_CASE_FIXTURE(SSATestFixture, "testReachingDefs"
+    * doctest::description("testing unique reaching definitions of uses")) {
+
+    al::World::getLogger().Progress("Testing unique reaching definitions of uses ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+    std::unordered_map<std::string, std::shared_ptr<air::Var>> varMap;
+    for (const std::shared_ptr<air::Var>& v : ir3->getVars()) {
+        varMap.emplace(v->getName(), v);
+    }
+
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s5 = stmtMap.at("b = a + b");
+    std::shared_ptr<air::Stmt> s6 = stmtMap.at("a = tmp");
+    std::shared_ptr<air::Stmt> s7 = stmtMap.at("i--");
+    std::shared_ptr<air::Stmt> s8 = stmtMap.at("nop");
+    std::shared_ptr<air::Stmt> s10 = stmtMap.at("return a");
+
+    std::shared_ptr<air::Var> a = varMap.at("a");
+    std::shared_ptr<air::Var> b = varMap.at("b");
+    std::shared_ptr<air::Var> i = varMap.at("i");
+    std::shared_ptr<air::Var> tmp = varMap.at("tmp");
+
+    CHECK_EQ(i->getIndex(), 0);
+
+    std::shared_ptr<air::SSA> ssa = ir3->getSSA();
+    CHECK(ssa == ir3->getSSA());
+
+    // the loop header merges the definitions before and inside the loop
+    std::size_t iPhi = ssa->getReachingDef(s3, i);
+    CHECK(ssa->getDefKind(iPhi) == air::SSA::DefKind::PHI);
+    CHECK(ssa->getDefStmt(iPhi) == s3);
+    CHECK(ssa->getDefVar(iPhi) == i);
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    llvm::ArrayRef<std::size_t> preds = cfg->getPredIndicesOf(cfg->getNodeIndex(s3));
+    llvm::ArrayRef<std::size_t> operands = ssa->getPhiOperands(iPhi);
+    REQUIRE_EQ(operands.size(), preds.size());
+    for (std::size_t k = 0; k < preds.size(); k++) {
+        if (cfg->getNode(preds[k]) == s2) {
+            CHECK(ssa->getDefKind(operands[k]) == air::SSA::DefKind::ENTRY);
+            CHECK_EQ(operands[k], i->getIndex());
+        } else {
+            CHECK(cfg->getNode(preds[k]) == s8);
+            CHECK_EQ(operands[k], ssa->getDefAt(s7, i));
+        }
+    }
+
+    CHECK_EQ(ssa->getReachingDef(s7, i), iPhi);
+    CHECK(ssa->getDefKind(ssa->getDefAt(s7, i)) == air::SSA::DefKind::STMT);
+    CHECK(ssa->getDefStmt(ssa->getDefAt(s7, i)) == s7);
+
+    std::size_t bPhi = ssa->getReachingDef(s4, b);
+    CHECK(ssa->getDefKind(bPhi) == air::SSA::DefKind::PHI);
+    CHECK(ssa->getDefStmt(bPhi) == s3);
+    CHECK_EQ(ssa->getReachingDef(s5, b), bPhi);
+
+    CHECK_EQ(ssa->getReachingDef(s6, tmp), ssa->getDefAt(s4, tmp));
+    CHECK_EQ(ssa->getReachingDef(s5, a), ssa->getReachingDef(s10, a));
+    CHECK(ssa->getDefKind(ssa->getReachingDef(s10, a)) == air::SSA::DefKind::PHI);
+
+    CHECK_EQ(ssa->getReachingDef(s6, b), ssa->getDefNum());
+    CHECK_EQ(ssa->getDefAt(s6, b), ssa->getDefNum());
+    CHECK_EQ(ssa->getUseDefsOf(s5).size(), 2);
+    CHECK_EQ(ssa->getDefsOf(s5).size(), 1);
+
+    for (std::size_t phi : ssa->getPhisAt(s3)) {
+        CHECK(ssa->getDefKind(phi) == air::SSA::DefKind::PHI);
+    }
+    CHECK(ssa->getPhisAt(s4).empty());
+
+    al::World::getLogger().Success("Finish testing unique reaching definitions of uses ...");
+}
+
+TEST_CASE_FIXTURE(SSATestFixture, "testDefUseIndex"
+    * doctest::description("testing def-use and use-def chains")) {
+
+    al::World::getLogger().Progress("Testing def-use and use-def chains ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+    std::unordered_map<std::string, std::shared_ptr<air::Var>> varMap;
+    for (const std::shared_ptr<air::Var>& v : ir3->getVars()) {
+        varMap.emplace(v->getName(), v);
+    }
+
+    std::shared_ptr<air::Stmt> s1 = stmtMap.at("a = 0");
+    std::shared_ptr<air::Stmt> s2 = stmtMap.at("b = 1");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s5 = stmtMap.at("b = a + b");
+    std::shared_ptr<air::Stmt> s6 = stmtMap.at("a = tmp");
+    std::shared_ptr<air::Stmt> s10 = stmtMap.at("return a");
+
+    std::shared_ptr<air::Var> a = varMap.at("a");
+    std::shared_ptr<air::Var> b = varMap.at("b");
+    std::shared_ptr<air::Var> i = varMap.at("i");
+
+    std::shared_ptr<air::DefUseIndex> index = ir3->getDefUseIndex();
+    CHECK(index == ir3->getDefUseIndex());
+
+    auto toSet = [](llvm::ArrayRef<std::shared_ptr<air::Stmt>> stmts) {
+        return std::unordered_set<std::shared_ptr<air::Stmt>>(stmts.begin(), stmts.end());
+    };
+
+    CHECK(toSet(index->getDefiningStmtsOf(b)) == std::unordered_set<std::shared_ptr<air::Stmt>>{s2, s5});
+    CHECK(toSet(index->getDefsOfUse(s4, b)) == std::unordered_set<std::shared_ptr<air::Stmt>>{s2, s5});
+    CHECK(toSet(index->getDefsOfUse(s10, a)) == std::unordered_set<std::shared_ptr<air::Stmt>>{s1, s6});
+    CHECK(toSet(index->getUsesOfDef(s5, b)) == std::unordered_set<std::shared_ptr<air::Stmt>>{s4, s5});
+    CHECK(toSet(index->getUsesOfDef(s2, b)) == std::unordered_set<std::shared_ptr<air::Stmt>>{s4, s5});
+    CHECK(index->getUsesOfDef(s3, i).empty());
+    CHECK(index->getDefsOfUse(s2, b).empty());
+
+    CHECK(index->isReachedByEntry(s3, i));
+    CHECK_FALSE(index->isReachedByEntry(s4, b));
+    CHECK_FALSE(index->isReachedByEntry(s2, b));
+
+    al::World::getLogger().Success("Finish testing def-use and use-def chains ...");
+}
+
+TEST_SUITE_END();
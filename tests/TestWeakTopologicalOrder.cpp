@@ -0,0 +1,276 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "World.h"
+#include "ir/IR.h"
+#include "analysis/dataflow/solver/Solver.h"
+#include "analysis/graph/WeakTopologicalOrder.h"
+
+namespace al = analyzer;
+namespace air = al::ir;
+namespace graph = al::analysis::graph;
+namespace df = al::analysis::dataflow;
+
+/**
+ * @brief an interval of integers, with the extreme values of std::int64_t standing for infinities
+ */
+struct Interval {
+    bool empty; ///< whether the interval holds no value, i.e. the code is unreachable
+    std::int64_t low; ///< the lower bound
+    std::int64_t high; ///< the upper bound
+    [[nodiscard]] bool operator==(const Interval& other) const
+    {
+        return empty ? other.empty : !other.empty && low == other.low && high == other.high;
+    }
+};
+
+/**
+ * @brief a toy interval analysis of the counter i of fib, called with i >= 10
+ *
+ * Entering the loop body refines i by the loop condition i > 0 and i-- decrements it, so the lower
+ * bound of i at the loop head descends without end unless the solver widens it.
+ */
+class CounterIntervalAnalysis: public df::AbstractDataflowAnalysis<Interval> {
+public:
+
+    CounterIntervalAnalysis(const std::shared_ptr<graph::CFG>& cfg, std::shared_ptr<air::Stmt> bodyEntry,
+                            std::shared_ptr<air::Stmt> decrement)
+        :df::AbstractDataflowAnalysis<Interval>(cfg), bodyEntry(std::move(bodyEntry)),
+        decrement(std::move(decrement)), result(std::make_shared<df::fact::DataflowResult<Interval>>())
+    {
+
+    }
+
+    [[nodiscard]] bool isForward() const override
+    {
+        return true;
+    }
+
+    [[nodiscard]] std::shared_ptr<Interval> newBoundaryFact() const override
+    {
+        return std::make_shared<Interval>(Interval{false, 10, UNBOUNDED});
+    }
+
+    [[nodiscard]] std::shared_ptr<Interval> newInitialFact() const override
+    {
+        return std::make_shared<Interval>(Interval{true, 0, 0});
+    }
+
+    void meetInto(std::shared_ptr<Interval> fact, std::shared_ptr<Interval> target) const override
+    {
+        if (target->empty) {
+            *target = *fact;
+        } else if (!fact->empty) {
+            target->low = std::min(target->low, fact->low);
+            target->high = std::max(target->high, fact->high);
+        }
+    }
+
+    bool transferNode(std::shared_ptr<air::Stmt> stmt, std::shared_ptr<Interval> in,
+                      std::shared_ptr<Interval> out) const override
+    {
+        Interval next = *in;
+        if (!next.empty && stmt == bodyEntry) {
+            next.low = std::max(next.low, std::int64_t{1});
+            next.empty = next.low > next.high;
+        }
+        if (!next.empty && stmt == decrement) {
+            next.low = next.low == -UNBOUNDED ? next.low : next.low - 1;
+            next.high = next.high == UNBOUNDED ? next.high : next.high - 1;
+        }
+        bool changed = !(next == *out);
+        *out = next;
+        return changed;
+    }
+
+    [[nodiscard]] bool supportsWidening() const override
+    {
+        return true;
+    }
+
+    void widenInto(std::shared_ptr<Interval> fact, std::shared_ptr<Interval> target) const override
+    {
+        widenNum++;
+        if (target->empty) {
+            *target = *fact;
+        } else if (!fact->empty) {
+            target->low = fact->low < target->low ? -UNBOUNDED : target->low;
+            target->high = fact->high > target->high ? UNBOUNDED : target->high;
+        }
+    }
+
+    void narrowInto(std::shared_ptr<Interval> fact, std::shared_ptr<Interval> target) const override
+    {
+        narrowNum++;
+        if (fact->empty || target->empty) {
+            *target = *fact;
+        } else {
+            target->low = target->low == -UNBOUNDED ? fact->low : target->low;
+            target->high = target->high == UNBOUNDED ? fact->high : target->high;
+        }
+    }
+
+    [[nodiscard]] std::shared_ptr<df::fact::DataflowResult<Interval>> getResult() const override
+    {
+        return result;
+    }
+
+    static constexpr std::int64_t UNBOUNDED = std::numeric_limits<std::int64_t>::max(); ///< the bound standing for infinity
+
+    mutable std::size_t widenNum = 0; ///< the number of widenings done
+
+    mutable std::size_t narrowNum = 0; ///< the number of narrowings done
+
+private:
+
+    std::shared_ptr<air::Stmt> bodyEntry; ///< the first statement of the loop body
+
+    std::shared_ptr<air::Stmt> decrement; ///< the statement i--
+
+    std::shared_ptr<df::fact::DataflowResult<Interval>> result; ///< the facts being solved
+
+};
+
+class WTOTestFixture {
+protected:
+    std::shared_ptr<air::IR> ir1, ir3;
+public:
+    WTOTestFixture() {
+        al::World::initialize("resources/example02");
+        const al::World& world = al::World::get();
+        ir1 = world.getMethodBySignature("int main(int, char **)")->getIR();
+        ir3 = world.getMethodBySignature("int fib(int)")->getIR();
+    }
+};
+
+TEST_SUITE_BEGIN("testWeakTopologicalOrder");
+
+TEST_CASE_FIXTURE(WTOTestFixture, "testWeakTopologicalOrder"
+    * doctest::description("testing weak topological orders of cfgs")) {
+
+    al::World::getLogger().Progress("Testing weak topological orders of cfgs ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s1 = stmtMap.at("a = 0");
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s7 = stmtMap.at("i--");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    std::shared_ptr<graph::WeakTopologicalOrder> wto = cfg->getWeakTopologicalOrder();
+
+    CHECK(wto == cfg->getWeakTopologicalOrder());
+    CHECK_FALSE(wto->isReversed());
+    CHECK_EQ(wto->getNodeNum(), cfg->getNodeNum());
+    CHECK_EQ(wto->getOrder().front(), cfg->getNodeIndex(cfg->getEntry()));
+    CHECK_EQ(wto->getHeadNum(), 1);
+    CHECK(wto->isHead(s3));
+    CHECK_FALSE(wto->isHead(s4));
+    CHECK_FALSE(wto->isHead(s9));
+    CHECK_EQ(wto->getDepthOf(cfg->getNodeIndex(s1)), 0);
+    CHECK_EQ(wto->getDepthOf(cfg->getNodeIndex(s3)), 1);
+    CHECK_EQ(wto->getDepthOf(cfg->getNodeIndex(s7)), 1);
+    CHECK_EQ(wto->getDepthOf(cfg->getNodeIndex(s9)), 0);
+    std::size_t headPosition = wto->getPositionOf(cfg->getNodeIndex(s3));
+    CHECK(wto->getPositionOf(cfg->getNodeIndex(s4)) > headPosition);
+    CHECK(wto->getPositionOf(cfg->getNodeIndex(s7)) < wto->getComponentEnd(headPosition));
+    CHECK(wto->getPositionOf(cfg->getNodeIndex(s9)) >= wto->getComponentEnd(headPosition));
+
+    std::shared_ptr<graph::WeakTopologicalOrder> reverseWTO = cfg->getReverseWeakTopologicalOrder();
+    CHECK(reverseWTO == cfg->getReverseWeakTopologicalOrder());
+    CHECK(reverseWTO->isReversed());
+    CHECK_EQ(reverseWTO->getOrder().front(), cfg->getNodeIndex(cfg->getExit()));
+    CHECK_EQ(reverseWTO->getHeadNum(), 1);
+    CHECK(reverseWTO->isHead(s3));
+
+    // every edge goes forward in the order, unless it targets the head of a component containing its source
+    for (const std::shared_ptr<air::IR>& myIR : {ir1, ir3}) {
+        std::shared_ptr<graph::CFG> myCFG = myIR->getCFG();
+        for (const std::shared_ptr<graph::WeakTopologicalOrder>& order
+                : {myCFG->getWeakTopologicalOrder(), myCFG->getReverseWeakTopologicalOrder()}) {
+            std::vector<bool> ordered(myCFG->getNodeNum(), false);
+            for (std::size_t index : order->getOrder()) {
+                ordered[index] = true;
+            }
+            CHECK(std::all_of(ordered.begin(), ordered.end(), [](bool b) { return b; }));
+            for (std::size_t i = 0; i < myCFG->getNodeNum(); i++) {
+                llvm::ArrayRef<std::size_t> succs = order->isReversed() ?
+                    myCFG->getPredIndicesOf(i) : myCFG->getSuccIndicesOf(i);
+                for (std::size_t succ : succs) {
+                    std::size_t source = order->getPositionOf(i);
+                    std::size_t target = order->getPositionOf(succ);
+                    if (target <= source) {
+                        CHECK(order->isHead(succ));
+                        CHECK(source < order->getComponentEnd(target));
+                    }
+                }
+            }
+        }
+    }
+
+    // freezing the cfg again drops the cached orders, which were built on the old node numbers
+    auto defaultCFG = std::dynamic_pointer_cast<graph::DefaultCFG>(cfg);
+    REQUIRE(defaultCFG);
+    defaultCFG->freeze(ir3->getStmts());
+    CHECK(defaultCFG->getWeakTopologicalOrder() != wto);
+    CHECK(defaultCFG->getReverseWeakTopologicalOrder() != reverseWTO);
+    CHECK_EQ(defaultCFG->getWeakTopologicalOrder()->getNodeNum(), defaultCFG->getNodeNum());
+
+    al::World::getLogger().Success("Finish testing weak topological orders of cfgs ...");
+}
+
+TEST_CASE_FIXTURE(WTOTestFixture, "testWTOSolverWidening"
+    * doctest::description("testing widening and narrowing of the weak topological order solver")) {
+
+    al::World::getLogger().Progress("Testing widening and narrowing of the weak topological order solver ...");
+
+    std::unordered_map<std::string, std::shared_ptr<air::Stmt>> stmtMap;
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        stmtMap.emplace(s->str(), s);
+    }
+
+    std::shared_ptr<air::Stmt> s3 = stmtMap.at("i > 0");
+    std::shared_ptr<air::Stmt> s4 = stmtMap.at("int tmp = b;");
+    std::shared_ptr<air::Stmt> s7 = stmtMap.at("i--");
+    std::shared_ptr<air::Stmt> s9 = stmtMap.at("a");
+
+    std::shared_ptr<graph::CFG> cfg = ir3->getCFG();
+    std::unique_ptr<df::DataflowAnalysis<Interval>> analysis = std::make_unique<CounterIntervalAnalysis>(cfg, s4, s7);
+    std::unique_ptr<df::solver::Solver<Interval>> solver = std::make_unique<df::solver::WTOSolver<Interval>>();
+    std::shared_ptr<df::fact::DataflowResult<Interval>> result = solver->solve(analysis);
+
+    const auto& counter = static_cast<const CounterIntervalAnalysis&>(*analysis);
+    constexpr std::int64_t unbounded = CounterIntervalAnalysis::UNBOUNDED;
+    CHECK_GT(counter.widenNum, 0U);
+    CHECK_GT(counter.narrowNum, 0U);
+    CHECK_LE(solver->getVisitNum(), 4 * cfg->getNodeNum());
+
+    // widening takes the lower bound at the head to minus infinity, and narrowing recovers i >= 0
+    CHECK(*result->getInFact(s3) == Interval{false, 0, unbounded});
+    CHECK(*result->getInFact(s4) == Interval{false, 0, unbounded});
+    CHECK(*result->getOutFact(s4) == Interval{false, 1, unbounded});
+    CHECK(*result->getOutFact(s7) == Interval{false, 0, unbounded});
+    CHECK(*result->getInFact(s9) == Interval{false, 0, unbounded});
+
+    // the facts are a post fixed point: each in fact covers the out facts of the predecessors
+    for (const std::shared_ptr<air::Stmt>& s : ir3->getStmts()) {
+        for (const std::shared_ptr<air::Stmt>& pred : cfg->getPredsOf(s)) {
+            std::shared_ptr<Interval> joined = analysis->newInitialFact();
+            analysis->meetInto(result->getInFact(s), joined);
+            analysis->meetInto(result->getOutFact(pred), joined);
+            CHECK(*joined == *result->getInFact(s));
+        }
+    }
+
+    al::World::getLogger().Success("Finish testing widening and narrowing of the weak topological order solver ...");
+}
+
+TEST_SUITE_END();
@@ -57,16 +57,16 @@ int main(int argc, const char **argv)
             al::World::getLogger().Info("* " + fileName
                                         + " " + std::to_string(stmt->getStartLine()) + ": " + stmt->str());
             al::World::getLogger().Info("    In: ");
-            result->getInFact(stmt)->forEach(
-                    [&](const std::shared_ptr<air::Var>& k, const std::shared_ptr<df::CPValue>& v)
+            result->getInFact(stmt)->forEachValue(
+                    [&](const std::shared_ptr<air::Var>& k, const df::CPValue& v)
                      {
-                         al::World::getLogger().Info("        " + k->getName() + ": " + v->str());
+                         al::World::getLogger().Info("        " + k->getName() + ": " + v.str());
                      });
             al::World::getLogger().Info("    Out: ");
-            result->getOutFact(stmt)->forEach(
-                    [&](const std::shared_ptr<air::Var>& k, const std::shared_ptr<df::CPValue>& v)
+            result->getOutFact(stmt)->forEachValue(
+                    [&](const std::shared_ptr<air::Var>& k, const df::CPValue& v)
                     {
-                        al::World::getLogger().Info("        " + k->getName() + ": " + v->str());
+                        al::World::getLogger().Info("        " + k->getName() + ": " + v.str());
                     });
         }
 